@@ -1,363 +1,10423 @@
-/**
- * Author(s):           Arda T. Kersu
- * File name:           open_csv.c
- * Date:                1st November 2023
- *
- * Description: Source code for the library "open_csv.h" that provides easier handling and manipulation of
- *              '.csv' files with the use of C programming language. See inline comments for further details
- *              regarding any specific function of interest.
- *
- * Disclaimer: This open-source project is provided "as is" without any warranty, expressed or implied.
- *             The contributors and maintainers disclaim any an all unintended consequences or issues
- *             that may arise from its use. Users are encouraged to review and understand the software's
- *             characteristics before implementation.
- *
- *
- * Copyright @ [Arda T. Kersu]
- *
- */
-
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <ctype.h>
-#include "open_csv.h"
-
-FILE *csvPtr = NULL;
-
-/**
- * @brief Close a file safely and report the status.
- *
- * This function attempts to close the specified file pointed to by 'filePtr'. It checks if the
- * file pointer is NULL and reports whether the file was closed successfully or if it could
- * not be found.
- *
- * @param filePtr A pointer to the file to be closed.
- *
- * @note This function reports the status of file closure using standard output and error streams.
- *
- * @code
- *   // Example usage:
- *   FILE *file = fopen("example.txt", "r");
- *   closeFile(file);
- *   // Attempt to close the file and report the status...
- * @endcode
- */
-void closeFile(FILE *filePtr)
-{
-    if(filePtr == NULL)
-    {
-        fprintf(stderr, "File could not be found, hence could not be closed.\n");
-    }
-    else
-    {
-        fprintf(stdout, "File has been closed safely.\n");
-        fclose(filePtr);
-    }
-}
-
-/**
- * @brief Get the size of a data frame from a '.csv' file.
- *
- * This function reads a '.csv' file pointed to by 'filePtr' and determines the number of rows and columns
- * in the data frame. It skips the first row (usually containing feature names) and counts the rows
- * and columns in the dataset.
- *
- * @param filePtr A pointer to the '.csv' file to analyze.
- * @return An integer array containing the number of rows and columns, or NULL if an error occurs.
- *
- * @note This function dynamically allocates memory for the integer array 'retVal,' which should be
- *       freed by the caller when no longer needed to avoid memory leaks.
- *
- * @code
- *   // Example usage:
- *   FILE *file = fopen("data.csv", "r");
- *   int *size = getDFsize(file);
- *   if (size != NULL) {
- *       printf("Number of rows: %d\n", size[0]);
- *       printf("Number of columns: %d\n", size[1]);
- *       free(size); // Free the allocated memory
- *   }
- *   else
- *   {
- *       puts("Error occurred while getting data frame size.");
- *   }
- *   // Analyze the '.csv' file and retrieve the data frame size...
- * @endcode
- */
-int *getDFsize(FILE *filePtr)
-{
-    char buffer[1024];      //buffer
-    int skipFirstRow = 0;   //skips the "feature names" row, first row of the file
-    int *retVal = (int *)malloc(sizeof(int) * 2), dfRows = 0, dfCols = 0; //return value
-    filePtr = fopen(CSV_PATH, CSV_MODE);    //open the file
-
-    if(filePtr == NULL) //check file validity
-    {
-        puts("Could not open the file.");
-        return NULL;
-    }
-    else
-    {
-        printf("File has been opened.\n");
-    }
-
-    bool_t lock = FALSE;
-    while(fgets(buffer, 1024, filePtr)) //pull file contents row by row
-    {
-        char *tokens = strtok(buffer, CSV_DELIM); //split them into tokens separated by deliminator
-
-        if(skipFirstRow == 0) //this condition locks itself out once it has executed for the value 0
-        {
-            skipFirstRow = 1;
-            continue;
-        }
-
-        if(lock == FALSE) //also runs once and locks itself out. counts the number of columns in dataset
-        {
-            while(tokens) //count tokens
-            {
-                tokens = strtok(NULL, CSV_DELIM);
-                dfCols++;
-            }
-            lock = TRUE;
-        }
-
-        dfRows++; //count rows
-    }
-
-    retVal[0] = dfRows;
-    retVal[1] = dfCols;
-
-    closeFile(filePtr);
-
-    return retVal;
-}
-
-/**
- * @brief Create a CSV data frame structure based on file information.
- *
- * This function analyzes a '.csv' file pointed to by 'filePtr' to determine its size and creates
- * a CSV data frame structure accordingly. The data frame structure includes the number of rows,
- * columns, delimiter, and feature parameters.
- *
- * @param filePtr A pointer to the '.csv' file to create the data frame from.
- * @return A pointer to a dynamically allocated 'csvData_t' structure representing the data frame.
- *
- * @note The caller is responsible for freeing the memory allocated for the 'csvData_t' structure
- *       and its members when it is no longer needed to avoid memory leaks.
- *
- * @code
- *   // Example usage:
- *   FILE *file = fopen("data.csv", "r");
- *   csvData_t *dataFrame = createDataFrame(FILE);
- *   if (dataFrame != NULL) {
- *       // Use the data frame...
- *       free(dataFrame->delim);
- *       free(dataFrame->params);
- *       free(dataFrame);
- *   }
- *   else
- *   {
- *       puts("Error occurred while creating the data frame.");
- *   }
- *   // Create a data frame based on the '.csv' file...
- * @endcode
- */
-csvData_t *createDataFrame(FILE *filePtr)
-{
-    int *dfSize = getDFsize(filePtr); //get dataframe size info
-    csvData_t *dataFrame = (csvData_t *)malloc(sizeof(csvData_t)); //allocate memory for row/column numbers
-    dataFrame->rows = dfSize[0];
-    dataFrame->cols = dfSize[1];
-    dataFrame->DFSize = dataFrame->rows * dataFrame->cols;
-
-#if HIGH_DATAFRAME_DETAIL == 1
-    dataFrame->maxFeatureValues = (float *)malloc(sizeof(float) * dataFrame->cols);
-    dataFrame->minFeatureValues = (float *)malloc(sizeof(float) * dataFrame->cols);
-#endif
-
-    dataFrame->delim = (char *)malloc(sizeof(char) * 2); //allocate memory for deliminator
-    strncpy(dataFrame->delim, CSV_DELIM, sizeof(char *));
-
-    dataFrame->params = (char *)malloc(sizeof(char) * (dataFrame->cols + 1));//allocate memory for features
-    dataFrame->params[dataFrame->cols] = '\0';
-
-    return dataFrame;
-}
-
-/**
- * @brief Trim a token by removing non-alphanumeric characters.
- *
- * This function takes a token as input and removes any non-alphanumeric characters from it.
- * It returns a dynamically allocated string containing the trimmed token.
- *
- * @param token A null-terminated string representing the token to be trimmed.
- * @return A dynamically allocated string containing the trimmed token, or NULL if an error occurs.
- *
- * @note The caller is responsible for freeing the memory allocated for the returned trimmed token
- *       when it is no longer needed to avoid memory leaks.
- *
- * @code
- *   // Example usage:
- *   char *originalToken = "abc!@123";
- *   char *trimmed = trimToken(originalToken);
- *   if (trimmed != NULL) {
- *       printf("Original Token: %s\n", originalToken);
- *       printf("Trimmed Token: %s\n", trimmed);
- *       free(trimmed); // Free the allocated memory
- *   }
- *   else
- *   {
- *       puts("Error occurred while trimming the token.");
- *   }
- *   // Trim a token by removing non-alphanumeric characters...
- * @endcode
- */
-char *trimToken(char *token)
-{
-    char *trimmedToken = (char *)malloc(strlen(token) + 1);
-    trimmedToken[0] = '\0';
-
-    int loop = 0, innerLoop = 0;
-    while(*(token + loop) != '\0')
-    {
-        if( ! isalnum(*(token + loop)))
-        {
-            loop++;
-            continue;
-        }
-        else
-        {
-            *(trimmedToken + innerLoop) = *(token + loop);
-            innerLoop++;
-            loop++;
-        }
-    }
-
-    return trimmedToken;
-}
-/**
- * ...
- */
-#if HIGH_DATAFRAME_DETAIL == 1
-void getMinAndMaxFeatureValues(csvData_t *df)
-{
-    for(int colIndex=0; colIndex < df->cols; colIndex++)
-    {
-        float maxFeatureValue = df->dataFrame[0][colIndex];
-        float minFeatureValue = df->dataFrame[0][colIndex];
-
-        for(int rowIndex=1; rowIndex < df->rows; rowIndex++)
-        {
-            maxFeatureValue = (df->dataFrame[rowIndex][colIndex] > maxFeatureValue) ? df->dataFrame[rowIndex][colIndex] : maxFeatureValue;
-            minFeatureValue = (df->dataFrame[rowIndex][colIndex] < minFeatureValue) ? df->dataFrame[rowIndex][colIndex] : minFeatureValue;
-        }
-
-        df->maxFeatureValues[colIndex] = maxFeatureValue;
-        df->minFeatureValues[colIndex] = minFeatureValue;
-    }
-}
-#endif
-
-/**
- * @brief Load data from a '.csv' file into a CSV data frame.
- *
- * This function opens a '.csv' file pointed to by 'filePtr', reads the data from the file,
- * and loads it into a CSV data frame. It extracts feature names from the first row and stores
- * them in the data frame's 'params' member. Data points are read and stored in the 'dataFrame'
- * member of the data frame.
- *
- * @param filePtr A pointer to the '.csv' file to load data from.
- * @return A pointer to a dynamically allocated 'csvData_t' structure representing the loaded data frame.
- *
- * @note The caller is responsible for freeing the memory allocated for the returned data frame
- *       when it is no longer needed to avoid memory leaks.
- *
- * @code
- *   // Example usage:
- *   FILE *file = NULL;
- *   csvData_t *dataFrame = loadCsv(file);
- *   if (dataFrame != NULL)
- *   {
- *       // Use the loaded data frame...
- *       // Don't forget to free the allocated memory when done.
- *       free(dataFrame->params);
- *       for (int row = 0; row < dataFrame->rows; row++)
- *       {
- *           free(dataFrame->dataFrame[row]);
- *       }
- *       free(dataFrame->dataFrame);
- *       free(dataFrame);
- *   }
- *   else
- *   {
- *       puts("Error occurred while loading the '.csv' file.");
- *   }
- *   // Load data from a '.csv' file into a CSV data frame...
- * @endcode
- */
-
-csvData_t *loadCsv(FILE *filePtr)
-{
-    char buffer[1024];
-
-    filePtr = fopen(CSV_PATH, CSV_MODE);
-
-    if(filePtr != NULL)
-    {
-        puts("the file has been opened\n");
-    }
-
-    csvData_t *df = createDataFrame(filePtr); //create and initialize dataframe
-
-    //EXTRACT FEATURE NAMES ---------------------------------------------------
-
-    {
-        fgets(buffer, 1024, filePtr);       //get the first line of csv file
-        char *tokens = strtok(buffer, df->delim);   //split into multiple tokens
-
-        while(tokens) //
-        {
-            char *label = trimToken(tokens); //trim token of unwanted characters
-            strncat(df->params, label, sizeof(char) * strlen(label)); //write into dataframe
-            printf("\"%s\", \n", trimToken(tokens)); //print dataset features, can be commented out
-            tokens = strtok(NULL, df->delim); //split the next token from source
-        }
-    }
-
-    //EXTRACT DATA POINTS------------------------------------------------------
-
-    df->dataFrame = (float **)malloc(sizeof(float *) * df->rows); //allocate ...
-    for(int row=0; row<df->rows; row++)                                //... memory
-    {
-        df->dataFrame[row] = (float *)malloc(sizeof(float) * df->cols);
-    }
-
-    {
-        int row = 0;
-        while(fgets(buffer, 1024, filePtr)) //get data from dataset row by row
-        {
-            int col = 0;
-            char *tokens = strtok(buffer, df->delim); //split into tokens
-
-            while(tokens)
-            {
-                df->dataFrame[row][col] = atof(tokens); //feed data into dataframe
-                tokens = strtok(NULL, df->delim); //further break into tokens
-                col++;
-            }
-            //(void)puts(" ");
-
-            row++;
-        }
-    }
-
-#if HIGH_DATAFRAME_DETAIL == 1
-    getMinAndMaxFeatureValues(df); // if dataframe is highly detailed, pull min/max feature values
-#endif
-
-    fclose(filePtr);
-
-    return df;
-}
+/**
+ * Author(s):           Arda T. Kersu
+ * File name:           open_csv.c
+ * Date:                1st November 2023
+ *
+ * Description: Source code for the library "open_csv.h" that provides easier handling and manipulation of
+ *              '.csv' files with the use of C programming language. See inline comments for further details
+ *              regarding any specific function of interest.
+ *
+ * Disclaimer: This open-source project is provided "as is" without any warranty, expressed or implied.
+ *             The contributors and maintainers disclaim any an all unintended consequences or issues
+ *             that may arise from its use. Users are encouraged to review and understand the software's
+ *             characteristics before implementation.
+ *
+ *
+ * Copyright @ [Arda T. Kersu]
+ *
+ */
+
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <float.h>
+#include <limits.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include "open_csv.h"
+
+#if CSV_GZIP == 1
+#include <zlib.h>
+#endif
+
+#if CSV_ZSTD == 1
+#include <zstd.h>
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <immintrin.h>
+#define CSV_X86_DISPATCH    (1)     // x86 kernels are compiled per instruction set and picked at runtime
+#else
+#define CSV_X86_DISPATCH    (0)
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CSV_NEON            (1)     // NEON is always available on AArch64
+#else
+#define CSV_NEON            (0)
+#endif
+
+FILE *csvPtr = NULL;
+
+typedef struct
+{
+    const char *data;   //first byte of the input
+    size_t size;        //number of bytes in the input
+    void *mapping;      //start of the mapped region, NULL if the input has been read into 'buffer'
+    size_t mappingSize; //number of bytes mapped, the input may start past the beginning of the mapping
+    char *buffer;       //heap copy of inputs that can not be mapped, such as pipes
+}csvInput_t;
+
+typedef struct csvArenaChunk
+{
+    struct csvArenaChunk *next;
+    size_t size;        //usable bytes following the chunk header
+    size_t used;        //bytes handed out from the start of the usable bytes
+    bool_t dedicated;   //holds a single large allocation that can be released on its own
+}csvArenaChunk_t;
+
+struct csvArena
+{
+    csvAllocator_t allocator;       //where the chunks come from
+    csvArenaChunk_t *chunks;        //every chunk of the arena, the arena itself lives in the last one
+    csvArenaChunk_t *current;       //shared chunk small allocations are carved out of
+    size_t nextChunkSize;           //size of the next shared chunk, doubles every time
+    void *mapping;                  //mapped file the data points live in, NULL if there is none
+    size_t mappingSize;
+#if CSV_STATS == 1
+    size_t allocations;             //chunks taken from the allocator
+    size_t allocatedBytes;          //bytes of those chunks
+    size_t liveBytes;               //bytes of the chunks not released yet
+    size_t peakBytes;               //largest 'liveBytes' so far
+#endif
+};
+
+typedef struct
+{
+    int count;          //distinct values seen so far, the code of the next new value
+    int capacity;       //number of values 'values' has room for
+    char **values;      //null-terminated value of every code
+    int *slots;         //open addressing table of codes, -1 marks an empty slot
+    size_t slotCount;   //a power of two, always more than twice 'count'
+}csvCategoryTable_t;
+
+typedef struct
+{
+    void **columns;     //block of every column, holding 'rowCapacity' data points of the type of the column
+    csvCategoryTable_t *categories;     //values seen by every column, only used for CSV_TYPE_CATEGORY
+    long rowOffset;     //row of the column blocks the first row of the storage is written to
+    bool_t overflowed;  //a value needed a wider column than the preallocated blocks have
+}csvTypedStorage_t;
+
+typedef struct
+{
+    int rowCapacity;    //number of rows the storage can hold before it has to grow
+    float *values;      //aligned block the rows are gathered in for the contiguous and columnar layouts
+    size_t stride;      //distance in floats between two data points of the same row
+    bool_t preallocated;    //rows are written into final storage sized up front, which never grows
+    csvTypedStorage_t *typed;   //typed columns the rows are written to, NULL if every data point is a float
+    long rowLimit;      //rows the read stops at, zero to read every row
+}csvRowStorage_t;
+
+typedef struct
+{
+    char magic[8];          //CSV_CACHE_MAGIC
+    uint32_t version;       //CSV_CACHE_VERSION
+    uint32_t byteOrder;     //CSV_CACHE_BYTE_ORDER as stored by the host that wrote the file
+    int64_t rows;
+    int64_t cols;
+    int64_t sourceSize;     //size of the '.csv' file the cache was built from
+    int64_t sourceMtimeSec; //modification time of that file
+    int64_t sourceMtimeNsec;
+    uint64_t sourceHash;    //hash of the first and last 'CSV_CACHE_HASH_BYTES' bytes of that file
+    uint64_t namesLength;   //bytes of null-terminated feature names following the header
+    uint64_t valuesOffset;  //offset of the row-major data points, a multiple of 'CSV_ALIGNMENT'
+    char delim[16];         //deliminator the file has been parsed with
+    uint32_t header;        //the first row held the feature names
+    uint32_t openBytes;     //bytes of the last row of that file, which has no newline yet, zero if it has one
+}csvCacheHeader_t;
+
+typedef struct
+{
+    float min;              //smallest value seen so far
+    float max;              //largest value seen so far
+    double shiftedSum;      //sum of (value - shift)
+    double shiftedSquares;  //sum of (value - shift)^2
+}csvStatsPartial_t;
+
+typedef struct
+{
+    uint64_t separators;    //bit i is set if byte i of the block is the field separator
+    uint64_t quotes;        //bit i is set if byte i of the block is a double quote
+    uint64_t newlines;      //bit i is set if byte i of the block is a newline
+}csvBlockMasks_t;
+
+typedef enum
+{
+    CSV_OP_AFFINE,          //value * first + second
+    CSV_OP_CLIP,            //value clamped into [first, second], NaN values are kept
+    CSV_OP_FILL             //NaN values replaced by first
+}csvOp_t;
+
+typedef struct
+{
+    csvOp_t op;
+    float *first;           //first parameter of the operation for every column
+    float *second;          //second parameter of the operation for every column
+}csvTransformOp_t;
+
+typedef struct
+{
+    const char *name;
+    void (*columnStats)(const float *values, size_t count, double shift, csvStatsPartial_t *partial);
+    void (*rowStats)(const float *row, int cols, const double *shifts, float *mins, float *maxs,
+                     double *sums, double *squares);
+    void (*scanBlock)(const char *block, char separator, csvBlockMasks_t *masks);
+    uint64_t (*quoteMask)(uint64_t quotes);
+    void (*transformColumn)(float *values, size_t count, csvOp_t op, float first, float second);
+    void (*transformRow)(float *row, int cols, csvOp_t op, const float *first, const float *second);
+}csvKernels_t;
+
+typedef struct
+{
+    const char *block;      //first byte of the 64-byte block the masks describe
+    const char *end;        //one past the last byte of the scanned range
+    uint64_t structurals;   //separators and newlines of the block that have not been handed out yet
+    uint64_t quoted;        //every bit set if the block ended inside a quoted field, zero otherwise
+    char separator;
+    const csvKernels_t *kernels;
+}csvScanner_t;
+
+typedef struct
+{
+    void (*run)(void *arg);
+    void *arg;
+}csvTask_t;
+
+typedef struct
+{
+    pthread_t *workers;
+    int workerCount;            //zero if tasks run on the submitting thread
+    csvTask_t *tasks;           //tasks are queued in submission order and never reordered
+    int taskCapacity;
+    int taskHead;               //next task to hand out
+    int taskTail;               //one past the last submitted task
+    int pending;                //submitted tasks that have not finished yet
+    bool_t stopping;
+    pthread_mutex_t lock;
+    pthread_cond_t taskReady;
+    pthread_cond_t tasksDone;
+}csvThreadPool_t;
+
+typedef struct
+{
+    csvRowFilter_t test;        //callback deciding whether a row is loaded
+    void *context;              //passed to the callback as it is
+    int *fieldTokens;           //token every field of a row is handed over as, -1 if it is not
+    int fields;                 //number of entries in 'fieldTokens'
+    int tokenCount;             //number of tokens handed to the callback
+}csvFilter_t;
+
+typedef struct
+{
+    csvData_t *df;              //data frame the chunk belongs to
+    const char *begin;          //first byte of the chunk, always the start of a line
+    const char *end;            //one past the last byte of the chunk, always after a newline or at the end
+    long rowOffset;             //index of the first row of the chunk in the data frame
+    long rows;                  //number of data point rows in the chunk
+    bool_t status;              //result of parsing the chunk
+    csvTypedStorage_t typed;    //typed columns and category tables of the chunk, unused without types
+    const csvFilter_t *filter;  //decides which rows of the chunk are loaded, NULL to load every row
+    bool_t quoted;              //TRUE if the chunk ends inside a quoted field, its end is then not a row boundary
+    const char *rangeEnd;       //end of the input the chunk belongs to, which the chunk never reaches past
+}csvChunk_t;
+
+typedef struct
+{
+    csvData_t *df;              //data frame the task transforms
+    const csvTransformOp_t *ops;    //operations applied to every value, in order
+    int opCount;
+    int col;                    //column of a columnar task, -1 for a row task
+    long firstRow;              //first row of a row task
+    long lastRow;               //one past the last row of a row task
+    bool_t withStats;           //TRUE to fold the transformed values into the partial results
+    double shift;               //shift of the column of a columnar task
+    csvStatsPartial_t partial;  //partial results of a columnar task
+    const double *shifts;       //shift of every column of a row task
+    float *mins;                //partial results of every column of a row task
+    float *maxs;
+    double *sums;
+    double *squares;
+}csvTransformTask_t;
+
+typedef struct
+{
+    long rows;                  //rows folded in so far
+    double *shifts;             //first value of every column, which its sums are shifted by
+    csvStatsPartial_t *partials;    //partial statistics of every column
+    long *histograms;           //bin counts of every column, NULL without histograms
+}csvAggregator_t;
+
+typedef struct
+{
+    csvChunk_t *chunks;         //every chunk of the input, shared by the tasks
+    size_t chunkCount;
+    size_t *nextChunk;          //next chunk to fold, shared by the tasks and taken atomically
+    const csvAggregate_t *aggregate;    //columns and histogram bounds the task folds into
+    float *batch;               //columns of the rows being folded, CSV_AGGREGATE_BATCH_ROWS apart
+    csvAggregator_t aggregator; //partial results of the task
+    bool_t status;
+}csvAggregateTask_t;
+
+typedef struct
+{
+    const char *begin;          //first character of the data point rows of an input
+    const char *end;            //one past the last character of the input
+}csvRange_t;
+
+typedef struct
+{
+    long index;             //position of the row among the rows offered
+    const char *begin;      //first character of the row
+    const char *end;        //one past the last character of the row
+}csvSampledRow_t;
+
+typedef struct
+{
+    csvSampledRow_t *rows;  //rows drawn so far, in no particular order
+    long size;              //rows the sample holds once it is full
+    long count;             //rows drawn so far, at most 'size'
+    long seen;              //rows offered so far, those a row filter keeps if there is one
+    uint64_t state;         //state of the random number generator
+    bool_t copies;          //the rows are heap copies owned by the reservoir
+}csvReservoir_t;
+
+typedef enum
+{
+    CSV_CODEC_NONE,
+    CSV_CODEC_GZIP,         //gzip members, one after the other for bgzip and concatenated files
+    CSV_CODEC_ZSTD          //zstd frames, skippable frames such as the seek table of seekable files included
+}csvCodec_t;
+
+typedef struct
+{
+    csvCodec_t codec;
+#if CSV_GZIP == 1
+    z_stream zlib;          //inflate state of the current gzip member
+#endif
+#if CSV_ZSTD == 1
+    ZSTD_DStream *zstd;     //decompression state of the current zstd frame
+#endif
+    unsigned char *input;   //compressed bytes, read from the descriptor or the whole input held in memory
+    size_t inputCapacity;   //size of 'input' when it is a read buffer, zero when it belongs to the caller
+    size_t inputStart;      //first compressed byte that has not been decompressed yet
+    size_t inputFilled;     //one past the last compressed byte available
+    bool_t endOfInput;      //every compressed byte is in 'input'
+    bool_t frameEnded;      //the last member or frame decompressed is complete
+    csvLoadStats_t *stats;  //counters the read() calls are added to, NULL if they are not kept
+}csvDecoder_t;
+
+typedef struct
+{
+    const unsigned char *source;    //first compressed byte of the members or frames of the job
+    size_t sourceSize;
+    char *target;           //where they decompress to
+    size_t targetSize;      //number of bytes they decompress to
+    csvCodec_t codec;
+    bool_t status;
+}csvFrameJob_t;
+
+typedef struct
+{
+    int fd;                 //descriptor the input is read from
+    char *buffer;           //read buffer, one byte longer than 'capacity' to terminate the returned lines
+    size_t capacity;        //size of the read buffer, grows only when a single line does not fit
+    size_t start;           //first byte that has not been handed out yet
+    size_t filled;          //one past the last byte read into the buffer
+    size_t searched;        //bytes between 'start' and 'searched' hold no newline outside quotes
+    bool_t quoted;          //TRUE if the byte at 'searched' is inside a quoted field
+    bool_t endOfInput;
+    bool_t terminated;      //the byte at 'start' has been overwritten to terminate the returned lines
+    char saved;             //byte the terminator replaced
+    csvLoadStats_t *stats;  //counters the read() calls are added to, NULL if they are not kept
+    bool_t sniffed;         //the first bytes of the input have been checked for a compressed format
+    csvDecoder_t *decoder;  //decompresses the input as it is read, NULL for inputs that are not compressed
+    size_t openBytes;       //bytes of a last data line that is not blank and has no newline, zero if there is none
+}csvLineReader_t;
+
+typedef struct
+{
+    unsigned char *bytes;   //flatbuffer or file bytes built so far
+    size_t size;
+    size_t capacity;
+    bool_t failed;          //memory could not be allocated, 'bytes' is no longer written to
+}csvFlatBuilder_t;
+
+typedef struct
+{
+    csvData_t *df;          //data frame the exported arrays point into, NULL for an exported schema
+    void *block;            //the exported structures, bitmaps, dictionaries and names
+    int references;         //arrays or schemas of the export not released yet
+}csvArrowExport_t;
+
+static const csvKernels_t *selectKernels(void);
+static csvThreadPool_t *createThreadPool(int threads, int maxTasks);
+static void submitTask(csvThreadPool_t *pool, void (*run)(void *arg), void *arg);
+static void waitThreadPool(csvThreadPool_t *pool);
+static void destroyThreadPool(csvThreadPool_t *pool);
+static int resolveThreadCount(int threads);
+static bool_t openInput(const char *path, csvInput_t *input);
+static bool_t readStream(FILE *file, csvInput_t *input);
+static bool_t mapInput(int fd, csvInput_t *input, csvLoadStats_t *stats);
+static void closeInput(csvInput_t *input);
+static int isBlank(const char *first, const char *last);
+static long countRows(const char *begin, const char *end, char separator, bool_t *quoted);
+static int countFields(const char *begin, const char *end, char separator);
+static const char *findRowEnd(const char *begin, const char *end, bool_t *quoted);
+static int isPaddingChar(char character, const char *delim);
+static uint64_t hashBytes(uint64_t hash, const unsigned char *bytes, size_t count);
+static bool_t parseTypedRows(csvData_t *df, csvRowStorage_t *storage, const char *begin, const char *end);
+static bool_t finishTypedColumns(csvData_t *df, csvRowStorage_t *storage);
+static bool_t offerRow(csvReservoir_t *reservoir, const char *begin, const char *end);
+
+/**
+ * @brief Close a file safely and report the status.
+ *
+ * This function attempts to close the specified file pointed to by 'filePtr'. It checks if the
+ * file pointer is NULL and reports whether the file was closed successfully or if it could
+ * not be found.
+ *
+ * @param filePtr A pointer to the file to be closed.
+ *
+ * @note This function reports a missing file on the standard error stream.
+ *
+ * @code
+ *   // Example usage:
+ *   FILE *file = fopen("example.txt", "r");
+ *   closeFile(file);
+ *   // Close the file, a NULL pointer is reported on the standard error stream.
+ * @endcode
+ */
+void closeFile(FILE *filePtr)
+{
+    if(filePtr == NULL)
+    {
+        fprintf(stderr, "File could not be found, hence could not be closed.\n");
+    }
+    else
+    {
+        fclose(filePtr);
+    }
+}
+
+/**
+ * @brief Get the size of a data frame from a '.csv' file.
+ *
+ * This function reads a '.csv' file pointed to by 'filePtr' and determines the number of rows and columns
+ * in the data frame. It skips the first row (usually containing feature names) and counts the rows
+ * and columns in the dataset. Rows are counted off the newline masks of the structural scanner,
+ * without splitting them into tokens.
+ *
+ * @param filePtr A pointer to the '.csv' file to analyze.
+ * @return An integer array containing the number of rows and columns, or NULL if an error occurs.
+ *
+ * @note This function dynamically allocates memory for the integer array 'retVal,' which should be
+ *       freed by the caller when no longer needed to avoid memory leaks.
+ *
+ * @code
+ *   // Example usage:
+ *   FILE *file = fopen("data.csv", "r");
+ *   int *size = getDFsize(file);
+ *   if (size != NULL) {
+ *       printf("Number of rows: %d\n", size[0]);
+ *       printf("Number of columns: %d\n", size[1]);
+ *       free(size); // Free the allocated memory
+ *   }
+ *   else
+ *   {
+ *       puts("Error occurred while getting data frame size.");
+ *   }
+ *   // Analyze the '.csv' file and retrieve the data frame size...
+ * @endcode
+ */
+int *getDFsize(FILE *filePtr)
+{
+    csvInput_t input;
+    int *retVal = (int *)malloc(sizeof(int) * 2), dfRows = 0, dfCols = 0; //return value
+
+    (void)filePtr; //the file is opened from CSV_PATH, like loadCsv() does
+
+    if(retVal == NULL || openInput(CSV_PATH, &input) == ERROR) //check file validity
+    {
+        fprintf(stderr, "Could not open the file.\n");
+        free(retVal);
+        return NULL;
+    }
+
+    const char *inputEnd = input.data + input.size;
+    bool_t quoted = FALSE;
+    const char *row = findRowEnd(input.data, inputEnd, &quoted); //skips the "feature names" row, first row of the file
+    row = (row < inputEnd) ? row + 1 : inputEnd;
+
+    dfRows = (int)countRows(row, inputEnd, CSV_DELIM[0], NULL); //count rows straight off the newline masks
+
+    dfCols = countFields(row, inputEnd, CSV_DELIM[0]); //count the fields of the first row holding data points
+
+    retVal[0] = dfRows;
+    retVal[1] = dfCols;
+
+    closeInput(&input);
+
+    return retVal;
+}
+
+/**
+ * @brief Create a CSV data frame structure based on file information.
+ *
+ * This function analyzes a '.csv' file pointed to by 'filePtr' to determine its size and creates
+ * a CSV data frame structure accordingly. The data frame structure includes the number of rows,
+ * columns, delimiter, and feature parameters.
+ *
+ * @param filePtr A pointer to the '.csv' file to create the data frame from.
+ * @return A pointer to a dynamically allocated 'csvData_t' structure representing the data frame.
+ *
+ * @note The caller is responsible for freeing the memory allocated for the 'csvData_t' structure
+ *       and its members when it is no longer needed to avoid memory leaks.
+ *
+ * @code
+ *   // Example usage:
+ *   FILE *file = fopen("data.csv", "r");
+ *   csvData_t *dataFrame = createDataFrame(FILE);
+ *   if (dataFrame != NULL) {
+ *       // Use the data frame...
+ *       csvFree(dataFrame);
+ *   }
+ *   else
+ *   {
+ *       puts("Error occurred while creating the data frame.");
+ *   }
+ *   // Create a data frame based on the '.csv' file...
+ * @endcode
+ */
+csvData_t *createDataFrame(FILE *filePtr)
+{
+    int *dfSize = getDFsize(filePtr); //get dataframe size info
+    csvData_t *dataFrame = (csvData_t *)malloc(sizeof(csvData_t)); //allocate memory for row/column numbers
+    dataFrame->rows = dfSize[0];
+    dataFrame->cols = dfSize[1];
+    dataFrame->DFSize = dataFrame->rows * dataFrame->cols;
+    dataFrame->arena = NULL; //members are allocated one at a time, csvFree() releases them one by one
+    dataFrame->names = NULL;
+    dataFrame->nameSlots = NULL;
+    dataFrame->nameSlotCount = 0;
+    dataFrame->fields = dataFrame->cols;
+    dataFrame->fieldColumns = NULL;
+    dataFrame->types = NULL;
+    dataFrame->dictionaries = NULL;
+
+#if HIGH_DATAFRAME_DETAIL == 1
+    dataFrame->maxFeatureValues = (float *)malloc(sizeof(float) * dataFrame->cols);
+    dataFrame->minFeatureValues = (float *)malloc(sizeof(float) * dataFrame->cols);
+#endif
+
+    dataFrame->delim = (char *)malloc(sizeof(char) * 2); //allocate memory for deliminator
+    strncpy(dataFrame->delim, CSV_DELIM, sizeof(char *));
+
+    dataFrame->params = (char *)malloc(sizeof(char) * (dataFrame->cols + 1));//allocate memory for features
+    dataFrame->params[dataFrame->cols] = '\0';
+
+    return dataFrame;
+}
+
+/**
+ * @brief Trim a token by removing non-alphanumeric characters.
+ *
+ * This function takes a token as input and removes any non-alphanumeric characters from it.
+ * It returns a dynamically allocated string containing the trimmed token.
+ *
+ * @param token A null-terminated string representing the token to be trimmed.
+ * @return A dynamically allocated string containing the trimmed token, or NULL if an error occurs.
+ *
+ * @note The caller is responsible for freeing the memory allocated for the returned trimmed token
+ *       when it is no longer needed to avoid memory leaks.
+ *
+ * @code
+ *   // Example usage:
+ *   char *originalToken = "abc!@123";
+ *   char *trimmed = trimToken(originalToken);
+ *   if (trimmed != NULL) {
+ *       printf("Original Token: %s\n", originalToken);
+ *       printf("Trimmed Token: %s\n", trimmed);
+ *       free(trimmed); // Free the allocated memory
+ *   }
+ *   else
+ *   {
+ *       puts("Error occurred while trimming the token.");
+ *   }
+ *   // Trim a token by removing non-alphanumeric characters...
+ * @endcode
+ */
+char *trimToken(char *token)
+{
+    char *trimmedToken = (char *)malloc(strlen(token) + 1);
+    trimmedToken[0] = '\0';
+
+    int loop = 0, innerLoop = 0;
+    while(*(token + loop) != '\0')
+    {
+        if( ! isalnum(*(token + loop)))
+        {
+            loop++;
+            continue;
+        }
+        else
+        {
+            *(trimmedToken + innerLoop) = *(token + loop);
+            innerLoop++;
+            loop++;
+        }
+    }
+    *(trimmedToken + innerLoop) = '\0';
+
+    return trimmedToken;
+}
+/**
+ * ...
+ */
+#if HIGH_DATAFRAME_DETAIL == 1
+void getMinAndMaxFeatureValues(csvData_t *df)
+{
+    csvFeatureStats_t *stats = (csvFeatureStats_t *)malloc(sizeof(csvFeatureStats_t) * ((df->cols > 0) ? df->cols : 1));
+
+    if(stats != NULL && getFeatureStats(df, stats) == TRUE) //min/max come out of the vectorized stats kernels
+    {
+        for(int colIndex=0; colIndex < df->cols; colIndex++)
+        {
+            df->maxFeatureValues[colIndex] = stats[colIndex].max;
+            df->minFeatureValues[colIndex] = stats[colIndex].min;
+        }
+    }
+
+    free(stats);
+}
+#endif
+//LOAD STATISTICS -------------------------------------------------------------
+
+#if CSV_STATS == 1
+/**
+ * @brief Get the time of a monotonic clock in nanoseconds.
+ */
+static uint64_t statsClock(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (uint64_t)time.tv_sec * 1000000000ull + (uint64_t)time.tv_nsec;
+}
+
+#define CSV_STATS_ADD(stats, member, amount)    do { if((stats) != NULL) { (stats)->member += (uint64_t)(amount); } } while(0)
+#define CSV_STATS_MARK(stats)                   (((stats) != NULL) ? statsClock() : 0)
+#define CSV_STATS_PHASE(stats, phase, mark)     do { if((stats) != NULL) { uint64_t now = statsClock(); \
+                                                     (stats)->phaseNs[(phase)] += now - (mark); (mark) = now; } } while(0)
+#else
+#define CSV_STATS_ADD(stats, member, amount)    ((void)(stats), (void)(amount))
+#define CSV_STATS_MARK(stats)                   (0)
+#define CSV_STATS_PHASE(stats, phase, mark)     ((void)(mark))
+#endif
+
+/**
+ * @brief Account for a chunk an arena took from, or gave back to, its allocator.
+ */
+static void countArenaChunk(csvArena_t *arena, size_t bytes, bool_t released)
+{
+#if CSV_STATS == 1
+    if(released == TRUE)
+    {
+        arena->liveBytes -= bytes;
+        return;
+    }
+
+    arena->allocations++;
+    arena->allocatedBytes += bytes;
+    arena->liveBytes += bytes;
+    arena->peakBytes = (arena->liveBytes > arena->peakBytes) ? arena->liveBytes : arena->peakBytes;
+#else
+    (void)arena;
+    (void)bytes;
+    (void)released;
+#endif
+}
+
+//ARENA ALLOCATOR -------------------------------------------------------------
+
+#define CSV_ARENA_HEADER_SIZE   ((sizeof(csvArenaChunk_t) + CSV_ALIGNMENT - 1) / CSV_ALIGNMENT * CSV_ALIGNMENT)
+#define CSV_ARENA_MIN_ALIGNMENT (16)    // alignment of small allocations, enough for any scalar type
+
+/**
+ * @brief Allocator used when none is given: aligned blocks from the C library.
+ */
+static void *defaultAlloc(size_t size, size_t alignment, void *context)
+{
+    void *block = NULL;
+
+    (void)context;
+
+    return (posix_memalign(&block, alignment, (size > 0) ? size : alignment) == 0) ? block : NULL;
+}
+
+static void defaultRelease(void *block, void *context)
+{
+    (void)context;
+    free(block);
+}
+
+static const csvAllocator_t defaultAllocator = {defaultAlloc, defaultRelease, NULL};
+
+/**
+ * @brief Get a new chunk of 'size' usable bytes from the allocator of an arena.
+ */
+static csvArenaChunk_t *newArenaChunk(const csvAllocator_t *allocator, size_t size, bool_t dedicated)
+{
+    csvArenaChunk_t *chunk = (csvArenaChunk_t *)allocator->alloc(CSV_ARENA_HEADER_SIZE + size, CSV_ALIGNMENT, allocator->context);
+
+    if(chunk != NULL)
+    {
+        chunk->next = NULL;
+        chunk->size = size;
+        chunk->used = 0;
+        chunk->dedicated = dedicated;
+    }
+
+    return chunk;
+}
+
+/**
+ * @brief Create an arena that owns all the memory of a data frame.
+ *
+ * Small allocations are carved out of shared chunks that double in size, starting at
+ * 'CSV_ARENA_CHUNK_SIZE', and large ones get a chunk of their own. The arena itself lives in its
+ * first chunk, so a whole data frame comes from a handful of large allocations and is released in
+ * one go by destroyArena().
+ *
+ * @param allocator The allocator the chunks come from, or NULL to use the C library.
+ * @return A pointer to the arena, or NULL on failure.
+ */
+static csvArena_t *createArena(const csvAllocator_t *allocator)
+{
+    allocator = (allocator != NULL && allocator->alloc != NULL && allocator->release != NULL) ? allocator : &defaultAllocator;
+
+    csvArenaChunk_t *chunk = newArenaChunk(allocator, CSV_ARENA_CHUNK_SIZE, FALSE);
+
+    if(chunk == NULL)
+    {
+        return NULL;
+    }
+
+    csvArena_t *arena = (csvArena_t *)((char *)chunk + CSV_ARENA_HEADER_SIZE);
+
+    chunk->used = (sizeof(csvArena_t) + CSV_ARENA_MIN_ALIGNMENT - 1) / CSV_ARENA_MIN_ALIGNMENT * CSV_ARENA_MIN_ALIGNMENT;
+    arena->allocator = *allocator;
+    arena->chunks = chunk;
+    arena->current = chunk;
+    arena->nextChunkSize = (size_t)CSV_ARENA_CHUNK_SIZE * 2;
+    arena->mapping = NULL; //the chunk may hold the header of a freed arena
+    arena->mappingSize = 0;
+#if CSV_STATS == 1
+    arena->allocations = arena->allocatedBytes = arena->liveBytes = arena->peakBytes = 0;
+#endif
+    countArenaChunk(arena, CSV_ARENA_HEADER_SIZE + CSV_ARENA_CHUNK_SIZE, FALSE);
+
+    return arena;
+}
+
+/**
+ * @brief Allocate memory owned by an arena.
+ *
+ * @param arena A pointer to the arena.
+ * @param size The number of bytes to allocate.
+ * @param alignment The alignment of the returned memory, a power of two up to 'CSV_ALIGNMENT'.
+ * @return A pointer to uninitialized memory, or NULL on failure.
+ */
+static void *arenaAlloc(csvArena_t *arena, size_t size, size_t alignment)
+{
+    csvArenaChunk_t *chunk = arena->current;
+    size_t offset = (chunk->used + alignment - 1) & ~(alignment - 1);
+
+    if(offset + size > chunk->size)
+    {
+        bool_t dedicated = (size > arena->nextChunkSize / 4) ? TRUE : FALSE; //large blocks are not mixed with small ones
+
+        chunk = newArenaChunk(&arena->allocator, (dedicated == TRUE) ? size : arena->nextChunkSize, dedicated);
+
+        if(chunk == NULL)
+        {
+            return NULL;
+        }
+
+        chunk->next = arena->chunks;
+        arena->chunks = chunk;
+        offset = 0;
+        countArenaChunk(arena, CSV_ARENA_HEADER_SIZE + chunk->size, FALSE);
+
+        if(dedicated == FALSE)
+        {
+            arena->current = chunk;
+            arena->nextChunkSize *= 2;
+        }
+    }
+
+    chunk->used = offset + size;
+
+    return (char *)chunk + CSV_ARENA_HEADER_SIZE + offset;
+}
+
+/**
+ * @brief Allocate memory owned by an arena in a chunk of its own, whatever its size.
+ *
+ * For blocks that are outgrown and given back while a data frame is read, which arenaRelease() could
+ * not release from a shared chunk. The memory is aligned on 'CSV_ALIGNMENT'.
+ *
+ * @return A pointer to uninitialized memory, or NULL on failure.
+ */
+static void *arenaAllocDedicated(csvArena_t *arena, size_t size)
+{
+    csvArenaChunk_t *chunk = newArenaChunk(&arena->allocator, size, TRUE);
+
+    if(chunk == NULL)
+    {
+        return NULL;
+    }
+
+    chunk->next = arena->chunks;
+    chunk->used = size;
+    arena->chunks = chunk;
+    countArenaChunk(arena, CSV_ARENA_HEADER_SIZE + chunk->size, FALSE);
+
+    return (char *)chunk + CSV_ARENA_HEADER_SIZE;
+}
+
+/**
+ * @brief Give a block back to the allocator of an arena before the arena is destroyed.
+ *
+ * Only large blocks, which have a chunk of their own, are released. Small blocks stay in their shared
+ * chunk until the arena is destroyed.
+ */
+static void arenaRelease(csvArena_t *arena, void *block)
+{
+    for(csvArenaChunk_t **link = &arena->chunks; block != NULL && *link != NULL; link = &(*link)->next)
+    {
+        csvArenaChunk_t *chunk = *link;
+
+        if(chunk->dedicated == TRUE && (char *)chunk + CSV_ARENA_HEADER_SIZE == (char *)block)
+        {
+            *link = chunk->next;
+            countArenaChunk(arena, CSV_ARENA_HEADER_SIZE + chunk->size, TRUE);
+            arena->allocator.release(chunk, arena->allocator.context);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Release every chunk of an arena, including the one the arena itself lives in.
+ */
+static void destroyArena(csvArena_t *arena)
+{
+    csvAllocator_t allocator = arena->allocator;
+    csvArenaChunk_t *chunk = arena->chunks;
+
+    if(arena->mapping != NULL)
+    {
+        munmap(arena->mapping, arena->mappingSize);
+    }
+
+    while(chunk != NULL)
+    {
+        csvArenaChunk_t *next = chunk->next;
+        allocator.release(chunk, allocator.context);
+        chunk = next;
+    }
+}
+
+/**
+ * @brief Free a data frame and everything it holds.
+ *
+ * Data frames returned by the loaders keep all of their memory in an arena, which this function
+ * releases in one go, however many rows the data frame holds and whatever its layout.
+ *
+ * @param df A pointer to the data frame to free, or NULL.
+ *
+ * @code
+ *   // Example usage:
+ *   csvData_t *dataFrame = loadCsv(NULL);
+ *   // Use the loaded data frame...
+ *   csvFree(dataFrame);
+ * @endcode
+ */
+void csvFree(csvData_t *df)
+{
+    if(df == NULL)
+    {
+        return;
+    }
+
+    if(df->arena != NULL) //the data frame itself lives in its arena
+    {
+        destroyArena(df->arena);
+        return;
+    }
+
+    free(df->delim); //data frames of createDataFrame() are allocated one member at a time
+    free(df->params);
+#if HIGH_DATAFRAME_DETAIL == 1
+    free(df->maxFeatureValues);
+    free(df->minFeatureValues);
+#endif
+    free(df);
+}
+
+/**
+ * @brief Grow the row storage of a data frame.
+ *
+ * This function doubles the number of rows the data frame can hold so that the loader can keep
+ * appending rows without knowing the final row count in advance. Growing geometrically keeps the
+ * total cost of all reallocations linear in the number of rows.
+ *
+ * @param df A pointer to the data frame whose row storage will be grown.
+ * @param storage A pointer to the row storage state, its capacity is updated on success.
+ * @return TRUE if the storage has been grown, ERROR if the reallocation failed.
+ *
+ * @note On failure the existing row storage is left untouched. Storage is carved out of the arena of
+ *       the data frame, and every outgrown block is given back to it.
+ */
+static bool_t growRowStorage(csvData_t *df, csvRowStorage_t *storage)
+{
+    if(storage->preallocated == TRUE) //sized from a row count, running out means the input changed
+    {
+        return ERROR;
+    }
+
+    int newCapacity = (storage->rowCapacity > 0) ? (storage->rowCapacity * 2) : CSV_INITIAL_ROW_CAPACITY;
+
+    if(df->layout == CSV_LAYOUT_CONTIGUOUS || df->layout == CSV_LAYOUT_COLUMNAR) //gathered in one aligned block
+    {
+        void *newValues = arenaAlloc(df->arena, sizeof(float) * (size_t)newCapacity * df->cols, CSV_ALIGNMENT);
+
+        if(newValues == NULL)
+        {
+            return ERROR;
+        }
+
+        if(storage->values != NULL && df->layout == CSV_LAYOUT_CONTIGUOUS)
+        {
+            memcpy(newValues, storage->values, sizeof(float) * (size_t)df->rows * df->cols);
+        }
+        else if(storage->values != NULL) //every column moves to its new, longer slot
+        {
+            for(int col=0; col<df->cols; col++)
+            {
+                memcpy((float *)newValues + (size_t)col * newCapacity, storage->values + (size_t)col * storage->rowCapacity,
+                       sizeof(float) * df->rows);
+            }
+        }
+
+        arenaRelease(df->arena, storage->values);
+        storage->values = (float *)newValues;
+        storage->stride = (df->layout == CSV_LAYOUT_COLUMNAR) ? (size_t)newCapacity : 1;
+    }
+    else
+    {
+        float **newRows = (float **)arenaAlloc(df->arena, sizeof(float *) * newCapacity, CSV_ARENA_MIN_ALIGNMENT);
+
+        if(newRows == NULL)
+        {
+            return ERROR;
+        }
+
+        if(df->dataFrame != NULL)
+        {
+            memcpy(newRows, df->dataFrame, sizeof(float *) * df->rows);
+        }
+
+        arenaRelease(df->arena, df->dataFrame);
+        df->dataFrame = newRows;
+        storage->stride = 1;
+    }
+
+    storage->rowCapacity = newCapacity;
+
+    return TRUE;
+}
+
+/**
+ * @brief Append a row to a data frame that is being read, without initializing its data points.
+ *
+ * The data points of the returned row are 'storage->stride' floats apart: consecutive for the row
+ * layouts, one column slot apart for 'CSV_LAYOUT_COLUMNAR', which lets the loader fill the columns
+ * directly.
+ *
+ * @param df A pointer to the data frame to append the row to.
+ * @param storage A pointer to the row storage state of the read.
+ * @return A pointer to the first of 'cols' data points of the new row, or NULL on failure.
+ */
+static float *takeRow(csvData_t *df, csvRowStorage_t *storage)
+{
+    float *rowData = NULL;
+
+    if(df->rows == storage->rowCapacity && growRowStorage(df, storage) == ERROR)
+    {
+        fprintf(stderr, "Could not allocate memory for row %d.\n", df->rows);
+        return NULL;
+    }
+
+    if(df->layout == CSV_LAYOUT_CONTIGUOUS)
+    {
+        rowData = storage->values + (size_t)df->rows * df->cols;
+    }
+    else if(df->layout == CSV_LAYOUT_COLUMNAR)
+    {
+        rowData = storage->values + df->rows;
+    }
+    else if(storage->preallocated == TRUE) //rows have been laid out in one block up front
+    {
+        rowData = df->dataFrame[df->rows];
+    }
+    else
+    {
+        rowData = (float *)arenaAlloc(df->arena, sizeof(float) * df->cols, CSV_ARENA_MIN_ALIGNMENT);
+
+        if(rowData == NULL)
+        {
+            fprintf(stderr, "Could not allocate memory for row %d.\n", df->rows);
+            return NULL;
+        }
+
+        df->dataFrame[df->rows] = rowData;
+    }
+
+    df->rows++;
+
+    return rowData;
+}
+
+/**
+ * @brief Append an empty row to a data frame that is being read.
+ *
+ * @return A pointer to the first of 'cols' zero-initialized data points of the new row, see takeRow().
+ */
+static float *appendRow(csvData_t *df, csvRowStorage_t *storage)
+{
+    float *rowData = takeRow(df, storage);
+
+    if(rowData != NULL && storage->stride == 1)
+    {
+        memset(rowData, 0, sizeof(float) * df->cols); //missing fields are left as zero
+    }
+    else if(rowData != NULL)
+    {
+        for(int col=0; col<df->cols; col++)
+        {
+            rowData[(size_t)col * storage->stride] = 0.0f; //missing fields are left as zero
+        }
+    }
+
+    return rowData;
+}
+
+/**
+ * @brief Allocate an empty data frame that is sized while the file is being read.
+ *
+ * @param delim The deliminator of the file, its first character separates the fields.
+ * @param layout The storage layout of the data points.
+ * @param allocator The allocator the arena of the data frame takes its memory from, or NULL.
+ * @return A pointer to a zero-initialized 'csvData_t' with its deliminator set, or NULL on failure.
+ */
+static csvData_t *newDataFrame(const char *delim, csvLayout_t layout, const csvAllocator_t *allocator)
+{
+    csvArena_t *arena = createArena(allocator);
+    csvData_t *df = (arena != NULL) ? (csvData_t *)arenaAlloc(arena, sizeof(csvData_t), CSV_ARENA_MIN_ALIGNMENT) : NULL;
+
+    if(df == NULL)
+    {
+        return NULL; //the first chunk always holds the data frame and its deliminator
+    }
+
+    memset(df, 0, sizeof(csvData_t));
+    df->arena = arena;
+    df->delim = (char *)arenaAlloc(arena, sizeof(char) * (strlen(delim) + 1), 1); //allocate memory for deliminator
+    strcpy(df->delim, delim);
+    df->layout = layout;
+    df->sourceOffset = -1;
+
+    return df;
+}
+
+/**
+ * @brief Find the column of a feature name in the name index of a data frame.
+ *
+ * @return The first column named 'name', or -1 if there is none.
+ */
+static int lookupFeatureName(const csvData_t *df, const char *name, size_t length)
+{
+    if(df->nameSlots == NULL)
+    {
+        return -1;
+    }
+
+    size_t mask = (size_t)df->nameSlotCount - 1;
+    size_t slot = hashBytes(0xcbf29ce484222325ull, (const unsigned char *)name, length) & mask;
+
+    for(; df->nameSlots[slot] >= 0; slot = (slot + 1) & mask)
+    {
+        const char *known = df->names[df->nameSlots[slot]];
+
+        if(strncmp(known, name, length) == 0 && known[length] == '\0')
+        {
+            return df->nameSlots[slot];
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Point 'df->names' at a block of null-terminated feature names, index them and rebuild 'df->params'.
+ *
+ * Names are interned: a feature name repeated in the header points at its first copy, and the hash
+ * index maps every distinct name to the first column it names.
+ *
+ * @param df A pointer to the data frame, 'df->cols' must be the number of names in the block.
+ * @param block The names one after the other, each followed by its terminator, owned by the arena.
+ * @return TRUE on success, ERROR if memory could not be allocated.
+ */
+static bool_t indexFeatureNames(csvData_t *df, char *block)
+{
+    size_t length = 0;
+    char *name = block;
+    int slotCount = 1;
+
+    while(slotCount < df->cols * 2) //at most half full, so probes stay short
+    {
+        slotCount *= 2;
+    }
+
+    df->names = (char **)arenaAlloc(df->arena, sizeof(char *) * ((df->cols > 0) ? df->cols : 1), CSV_ARENA_MIN_ALIGNMENT);
+    df->nameSlots = (int *)arenaAlloc(df->arena, sizeof(int) * slotCount, CSV_ARENA_MIN_ALIGNMENT);
+    df->nameSlotCount = slotCount;
+
+    if(df->names == NULL || df->nameSlots == NULL)
+    {
+        df->names = NULL;
+        df->nameSlots = NULL;
+        return ERROR;
+    }
+
+    for(int slot=0; slot<slotCount; slot++)
+    {
+        df->nameSlots[slot] = -1;
+    }
+
+    for(int col=0; col<df->cols; col++)
+    {
+        size_t nameLength = strlen(name);
+        size_t mask = (size_t)slotCount - 1;
+        size_t slot = hashBytes(0xcbf29ce484222325ull, (const unsigned char *)name, nameLength) & mask;
+
+        while(df->nameSlots[slot] >= 0 && strcmp(df->names[df->nameSlots[slot]], name) != 0)
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        if(df->nameSlots[slot] < 0)
+        {
+            df->nameSlots[slot] = col;
+            df->names[col] = name;
+        }
+        else
+        {
+            df->names[col] = df->names[df->nameSlots[slot]]; //repeated names share the first copy
+        }
+        length += nameLength;
+        name += nameLength + 1;
+    }
+
+    df->params = (char *)arenaAlloc(df->arena, sizeof(char) * (length + 1), 1);
+
+    if(df->params == NULL)
+    {
+        return ERROR;
+    }
+
+    df->params[0] = '\0';
+
+    for(int col=0, offset=0; col<df->cols; col++) //'params' keeps the names concatenated as they always were
+    {
+        strcpy(df->params + offset, df->names[col]);
+        offset += (int)strlen(df->names[col]);
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Get the column of a feature by its name.
+ *
+ * The name is looked up in the hash index built while the header was read, so finding a column takes
+ * the same time however many columns the data frame has.
+ *
+ * @param df A pointer to the data frame.
+ * @param name The null-terminated name of the feature, as trimmed into 'df->names'.
+ * @return The first column holding the feature, or -1 if there is none or the input has no feature names.
+ *
+ * @code
+ *   // Example usage:
+ *   int col = getFeatureIndex(dataFrame, "price");
+ *   if (col >= 0)
+ *   {
+ *       double price = getDataPoint(dataFrame, 0, col);
+ *   }
+ * @endcode
+ */
+int getFeatureIndex(const csvData_t *df, const char *name)
+{
+    return (df != NULL && name != NULL) ? lookupFeatureName(df, name, strlen(name)) : -1;
+}
+
+/**
+ * @brief Extract the feature names from the first row of a '.csv' file.
+ *
+ * The feature names are kept in 'df->names', and concatenated into 'df->params'. Names are split on
+ * the field separator outside double quotes and trimmed of the padding around them; a quoted name
+ * loses its quotes and keeps what they hold as it is, with every doubled quote read as one (RFC 4180).
+ * Every non-empty name adds a column to the data frame.
+ *
+ * @param df A pointer to the data frame to fill.
+ * @param line A writable, null-terminated copy of the first row, or NULL if there are no feature names.
+ */
+static void extractFeatureNames(csvData_t *df, char *line)
+{
+    size_t length = (line != NULL) ? strlen(line) : 0;
+    char *block = (char *)arenaAlloc(df->arena, sizeof(char) * (length + 1), 1); //names can not outgrow the line
+    char *label = block;
+
+    df->params = block;
+    block[0] = '\0';
+
+    for(char *token = line; token != NULL; ) //split on the field separator, the same way the data points are split
+    {
+        char *labelEnd = label, *kept = label;
+        bool_t quoted = FALSE;
+
+        for(; *token != '\0' && (quoted == TRUE || *token != df->delim[0]); token++) //copy the name straight into the data frame
+        {
+            if(*token == '"' && quoted == TRUE && token[1] == '"')
+            {
+                *labelEnd++ = *token++; //an escaped quote
+                kept = labelEnd;
+            }
+            else if(*token == '"')
+            {
+                quoted = (quoted == TRUE) ? FALSE : TRUE;
+            }
+            else if(quoted == TRUE || ! isPaddingChar(*token, df->delim))
+            {
+                *labelEnd++ = *token;
+                kept = labelEnd;
+            }
+            else if(labelEnd > label)
+            {
+                *labelEnd++ = *token; //padding inside the name is kept, padding after it is dropped
+            }
+        }
+
+        char *nextToken = (*token != '\0') ? token + 1 : NULL;
+        labelEnd = kept;
+        *labelEnd = '\0';
+
+        if(label[0] != '\0') //every named feature is a column of the dataset
+        {
+            df->cols++;
+            label = labelEnd + 1;
+        }
+
+        token = nextToken;
+    }
+
+    if(line != NULL)
+    {
+        (void)indexFeatureNames(df, block);
+    }
+}
+
+/**
+ * @brief Restrict a data frame whose header has been read to the features requested by the options.
+ *
+ * Features are picked by name out of 'columnNames' or, if it is NULL, by position out of 'columnIndices',
+ * and become the columns of the data frame in the order they are listed in; a feature listed twice is
+ * loaded once. Every other field is skipped by the parser without being converted, and takes no memory.
+ * Without a projection, every field is loaded as its own column. A row parser of the options is taken
+ * by the data frame once it has been checked against the header.
+ *
+ * @param df A pointer to the data frame, with its feature names and number of columns known.
+ * @param options A pointer to the loader options.
+ * @return TRUE on success, ERROR if a feature does not exist, the row parser does not fit the input or
+ *         memory could not be allocated.
+ */
+static bool_t projectColumns(csvData_t *df, const csvOptions_t *options)
+{
+    df->fields = df->cols;
+    df->rowParser = options->rowParser;
+
+    if(options->rowParser != NULL &&
+       (options->rowParser->cols != df->cols || options->rowParser->separator != df->delim[0] || options->columnNames != NULL ||
+        options->columnIndices != NULL || options->columnTypes != NULL || options->inferTypes == TRUE))
+    {
+        fprintf(stderr, "The row parser %s does not fit the input.\n", options->rowParser->name);
+        return ERROR;
+    }
+
+    if(options->columnNames == NULL && options->columnIndices == NULL)
+    {
+        return TRUE;
+    }
+
+    size_t blockLength = 1;
+    int *fieldColumns = (int *)arenaAlloc(df->arena, sizeof(int) * ((df->fields > 0) ? df->fields : 1), CSV_ARENA_MIN_ALIGNMENT);
+    int *columnFields = (int *)malloc(sizeof(int) * ((options->columnCount > 0) ? options->columnCount : 1));
+
+    if(fieldColumns == NULL || columnFields == NULL)
+    {
+        free(columnFields);
+        return ERROR;
+    }
+
+    for(int field=0; field<df->fields; field++)
+    {
+        fieldColumns[field] = -1;
+    }
+
+    int cols = 0;
+
+    for(int entry=0; entry<options->columnCount; entry++) //find every requested feature
+    {
+        int field = (options->columnNames != NULL) ?
+                    lookupFeatureName(df, options->columnNames[entry], strlen(options->columnNames[entry])) :
+                    options->columnIndices[entry];
+
+        if(field < 0 || field >= df->fields)
+        {
+            if(options->columnNames != NULL)
+            {
+                fprintf(stderr, "Unknown column \"%s\".\n", options->columnNames[entry]);
+            }
+            else
+            {
+                fprintf(stderr, "Unknown column %d.\n", options->columnIndices[entry]);
+            }
+
+            free(columnFields);
+            return ERROR;
+        }
+
+        if(fieldColumns[field] < 0) //the first request of a feature gives its column
+        {
+            fieldColumns[field] = cols;
+            columnFields[cols++] = field;
+            blockLength += (df->names != NULL) ? strlen(df->names[field]) + 1 : 0;
+        }
+    }
+
+    char *block = (df->names != NULL) ? (char *)arenaAlloc(df->arena, sizeof(char) * blockLength, 1) : NULL;
+    bool_t status = (df->names == NULL || block != NULL) ? TRUE : ERROR;
+
+    for(int col=0, offset=0; status == TRUE && df->names != NULL && col<cols; col++) //names of the kept features, in column order
+    {
+        strcpy(block + offset, df->names[columnFields[col]]);
+        offset += (int)strlen(df->names[columnFields[col]]) + 1;
+    }
+
+    df->cols = cols;
+    df->fieldColumns = fieldColumns;
+    status = (status == TRUE && df->names != NULL) ? indexFeatureNames(df, block) : status;
+
+    free(columnFields);
+
+    return status;
+}
+
+/**
+ * @brief Allocate a block holding a pointer array followed by aligned data points.
+ *
+ * The pointer array comes first and the data points start on the next 'CSV_ALIGNMENT' boundary,
+ * so releasing the returned pointer array releases the data points as well.
+ *
+ * @param arena The arena the block is allocated from.
+ * @param pointerCount The number of pointers at the front of the block.
+ * @param valueCount The number of data points following the pointers.
+ * @param values Set to the first data point of the block.
+ * @return A pointer to the pointer array at the front of the block, or NULL on failure.
+ */
+static float **allocPointerBlock(csvArena_t *arena, size_t pointerCount, size_t valueCount, float **values)
+{
+    size_t pointerBytes = sizeof(float *) * pointerCount;
+
+    pointerBytes = (pointerBytes + CSV_ALIGNMENT - 1) / CSV_ALIGNMENT * CSV_ALIGNMENT; //keep the data aligned
+
+    void *block = arenaAlloc(arena, pointerBytes + sizeof(float) * valueCount + CSV_ALIGNMENT, CSV_ALIGNMENT);
+
+    if(block == NULL)
+    {
+        return NULL;
+    }
+
+    *values = (float *)((char *)block + pointerBytes);
+
+    return (float **)block;
+}
+
+/**
+ * @brief Number of floats between the starts of two columns of a 'CSV_LAYOUT_COLUMNAR' data frame.
+ *
+ * Columns are padded so that every one of them starts on a 'CSV_ALIGNMENT' boundary.
+ */
+static size_t columnStride(int rows)
+{
+    size_t floatsPerLine = CSV_ALIGNMENT / sizeof(float);
+
+    return ((size_t)rows + floatsPerLine - 1) / floatsPerLine * floatsPerLine;
+}
+
+/**
+ * @brief Finish a data frame once all of its rows have been read.
+ *
+ * Gives back the unused part of the geometrically grown row storage, fills in 'DFSize' and, if the
+ * data frame is highly detailed, pulls the min/max feature values.
+ *
+ * For the contiguous layout the row pointers and all data points are placed in a single block: the
+ * row pointer array comes first, followed by the data points starting on a 'CSV_ALIGNMENT' boundary.
+ * The columnar layout is built the same way with column pointers. Preallocated storage is already
+ * final and is left as it is. Typed columns are finished by finishTypedColumns(). Whatever the layout,
+ * every block lives in the arena of the data frame and is released by csvFree().
+ *
+ * @param df A pointer to the data frame to finish.
+ * @param storage A pointer to the row storage state at the end of the read.
+ * @return TRUE on success, ERROR if the final blocks could not be allocated. The data frame then has
+ *         no rows.
+ */
+static bool_t finishDataFrame(csvData_t *df, csvRowStorage_t *storage)
+{
+    bool_t status = TRUE;
+
+    if(storage->typed != NULL)
+    {
+        status = finishTypedColumns(df, storage);
+    }
+    else if(storage->preallocated == TRUE)
+    {
+        storage->values = NULL; //the rows have been written into their final storage already
+    }
+    else if(df->layout == CSV_LAYOUT_CONTIGUOUS)
+    {
+        df->dataFrame = allocPointerBlock(df->arena, (size_t)df->rows, (size_t)df->rows * df->cols, &df->values);
+
+        if(df->dataFrame != NULL)
+        {
+            if(df->rows > 0)
+            {
+                memcpy(df->values, storage->values, sizeof(float) * (size_t)df->rows * df->cols);
+            }
+
+            for(int row=0; row<df->rows; row++)
+            {
+                df->dataFrame[row] = df->values + (size_t)row * df->cols;
+            }
+        }
+        else
+        {
+            fprintf(stderr, "Could not allocate memory for %d rows.\n", df->rows);
+            df->rows = 0;
+            status = ERROR;
+        }
+    }
+    else if(df->layout == CSV_LAYOUT_COLUMNAR)
+    {
+        size_t stride = columnStride(df->rows);
+        df->columns = allocPointerBlock(df->arena, (size_t)df->cols, stride * df->cols, &df->values);
+
+        if(df->columns != NULL)
+        {
+            for(int col=0; col<df->cols; col++)
+            {
+                df->columns[col] = df->values + (size_t)col * stride;
+
+                if(df->rows > 0)
+                {
+                    memcpy(df->columns[col], storage->values + (size_t)col * storage->stride, sizeof(float) * df->rows);
+                }
+            }
+        }
+        else
+        {
+            fprintf(stderr, "Could not allocate memory for %d columns.\n", df->cols);
+            df->rows = 0;
+            status = ERROR;
+        }
+    }
+    else if(df->rows > 0 && df->rows < storage->rowCapacity) //give back the unused part of the geometric growth
+    {
+        float **exactRows = (float **)arenaAlloc(df->arena, sizeof(float *) * df->rows, CSV_ARENA_MIN_ALIGNMENT);
+
+        if(exactRows != NULL)
+        {
+            memcpy(exactRows, df->dataFrame, sizeof(float *) * df->rows);
+            arenaRelease(df->arena, df->dataFrame);
+            df->dataFrame = exactRows;
+        }
+    }
+
+    arenaRelease(df->arena, storage->values);
+    storage->values = NULL;
+
+    df->DFSize = (long)df->rows * df->cols;
+    df->rowCapacity = (df->layout == CSV_LAYOUT_COLUMNAR) ? (int)columnStride(df->rows) : df->rows;
+
+#if HIGH_DATAFRAME_DETAIL == 1
+    df->maxFeatureValues = (float *)arenaAlloc(df->arena, sizeof(float) * df->cols, CSV_ARENA_MIN_ALIGNMENT);
+    df->minFeatureValues = (float *)arenaAlloc(df->arena, sizeof(float) * df->cols, CSV_ARENA_MIN_ALIGNMENT);
+
+    if(df->rows > 0 && df->maxFeatureValues != NULL && df->minFeatureValues != NULL)
+    {
+        getMinAndMaxFeatureValues(df); // if dataframe is highly detailed, pull min/max feature values
+    }
+#endif
+
+    return status;
+}
+
+//FLOAT PARSING ---------------------------------------------------------------
+
+#define CSV_SMALLEST_POWER_OF_TEN   (-65)   // any decimal below 1e-65 rounds to zero as a float
+#define CSV_LARGEST_POWER_OF_TEN    (38)    // any decimal above 1e38 with a non-zero mantissa overflows
+#define CSV_MANTISSA_BITS           (23)
+#define CSV_INFINITE_POWER          (0xFF)
+
+static const float exactPowersOfTen[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+
+/* 128-bit approximations of 5^q for CSV_SMALLEST_POWER_OF_TEN <= q <= CSV_LARGEST_POWER_OF_TEN, normalized so
+ * that the most significant bit is set: truncated for q >= 0, rounded up for q < 0 (Eisel-Lemire). */
+static const uint64_t powersOfFive[][2] = {
+    {0x86ccbb52ea94baeaULL, 0x98e947129fc2b4e9ULL}, // 5^-65
+    {0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL}, // 5^-64
+    {0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL}, // 5^-63
+    {0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL}, // 5^-62
+    {0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL}, // 5^-61
+    {0xcdb02555653131b6ULL, 0x3792f412cb06794dULL}, // 5^-60
+    {0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd0ULL}, // 5^-59
+    {0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL}, // 5^-58
+    {0xc8de047564d20a8bULL, 0xf245825a5a445275ULL}, // 5^-57
+    {0xfb158592be068d2eULL, 0xeed6e2f0f0d56712ULL}, // 5^-56
+    {0x9ced737bb6c4183dULL, 0x55464dd69685606bULL}, // 5^-55
+    {0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL}, // 5^-54
+    {0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL}, // 5^-53
+    {0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL}, // 5^-52
+    {0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL}, // 5^-51
+    {0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL}, // 5^-50
+    {0x95a8637627989aadULL, 0xdde7001379a44aa8ULL}, // 5^-49
+    {0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL}, // 5^-48
+    {0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a6ULL}, // 5^-47
+    {0x9226712162ab070dULL, 0xcab3961304ca70e8ULL}, // 5^-46
+    {0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL}, // 5^-45
+    {0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506aULL}, // 5^-44
+    {0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL}, // 5^-43
+    {0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL}, // 5^-42
+    {0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL}, // 5^-41
+    {0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL}, // 5^-40
+    {0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL}, // 5^-39
+    {0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL}, // 5^-38
+    {0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL}, // 5^-37
+    {0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL}, // 5^-36
+    {0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL}, // 5^-35
+    {0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL}, // 5^-34
+    {0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL}, // 5^-33
+    {0xcfb11ead453994baULL, 0x67de18eda5814af2ULL}, // 5^-32
+    {0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL}, // 5^-31
+    {0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL}, // 5^-30
+    {0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL}, // 5^-29
+    {0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL}, // 5^-28
+    {0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL}, // 5^-27
+    {0xc612062576589ddaULL, 0x95364afe032a819eULL}, // 5^-26
+    {0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL}, // 5^-25
+    {0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL}, // 5^-24
+    {0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL}, // 5^-23
+    {0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL}, // 5^-22
+    {0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL}, // 5^-21
+    {0xbce5086492111aeaULL, 0x88f4bb1ca6bcf585ULL}, // 5^-20
+    {0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL}, // 5^-19
+    {0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL}, // 5^-18
+    {0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL}, // 5^-17
+    {0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL}, // 5^-16
+    {0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL}, // 5^-15
+    {0xb424dc35095cd80fULL, 0x538484c19ef38c95ULL}, // 5^-14
+    {0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL}, // 5^-13
+    {0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL}, // 5^-12
+    {0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL}, // 5^-11
+    {0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL}, // 5^-10
+    {0x89705f4136b4a597ULL, 0x31680a88f8953031ULL}, // 5^-9
+    {0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3eULL}, // 5^-8
+    {0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL}, // 5^-7
+    {0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL}, // 5^-6
+    {0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL}, // 5^-5
+    {0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL}, // 5^-4
+    {0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL}, // 5^-3
+    {0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL}, // 5^-2
+    {0xccccccccccccccccULL, 0xcccccccccccccccdULL}, // 5^-1
+    {0x8000000000000000ULL, 0x0000000000000000ULL}, // 5^0
+    {0xa000000000000000ULL, 0x0000000000000000ULL}, // 5^1
+    {0xc800000000000000ULL, 0x0000000000000000ULL}, // 5^2
+    {0xfa00000000000000ULL, 0x0000000000000000ULL}, // 5^3
+    {0x9c40000000000000ULL, 0x0000000000000000ULL}, // 5^4
+    {0xc350000000000000ULL, 0x0000000000000000ULL}, // 5^5
+    {0xf424000000000000ULL, 0x0000000000000000ULL}, // 5^6
+    {0x9896800000000000ULL, 0x0000000000000000ULL}, // 5^7
+    {0xbebc200000000000ULL, 0x0000000000000000ULL}, // 5^8
+    {0xee6b280000000000ULL, 0x0000000000000000ULL}, // 5^9
+    {0x9502f90000000000ULL, 0x0000000000000000ULL}, // 5^10
+    {0xba43b74000000000ULL, 0x0000000000000000ULL}, // 5^11
+    {0xe8d4a51000000000ULL, 0x0000000000000000ULL}, // 5^12
+    {0x9184e72a00000000ULL, 0x0000000000000000ULL}, // 5^13
+    {0xb5e620f480000000ULL, 0x0000000000000000ULL}, // 5^14
+    {0xe35fa931a0000000ULL, 0x0000000000000000ULL}, // 5^15
+    {0x8e1bc9bf04000000ULL, 0x0000000000000000ULL}, // 5^16
+    {0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL}, // 5^17
+    {0xde0b6b3a76400000ULL, 0x0000000000000000ULL}, // 5^18
+    {0x8ac7230489e80000ULL, 0x0000000000000000ULL}, // 5^19
+    {0xad78ebc5ac620000ULL, 0x0000000000000000ULL}, // 5^20
+    {0xd8d726b7177a8000ULL, 0x0000000000000000ULL}, // 5^21
+    {0x878678326eac9000ULL, 0x0000000000000000ULL}, // 5^22
+    {0xa968163f0a57b400ULL, 0x0000000000000000ULL}, // 5^23
+    {0xd3c21bcecceda100ULL, 0x0000000000000000ULL}, // 5^24
+    {0x84595161401484a0ULL, 0x0000000000000000ULL}, // 5^25
+    {0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL}, // 5^26
+    {0xcecb8f27f4200f3aULL, 0x0000000000000000ULL}, // 5^27
+    {0x813f3978f8940984ULL, 0x4000000000000000ULL}, // 5^28
+    {0xa18f07d736b90be5ULL, 0x5000000000000000ULL}, // 5^29
+    {0xc9f2c9cd04674edeULL, 0xa400000000000000ULL}, // 5^30
+    {0xfc6f7c4045812296ULL, 0x4d00000000000000ULL}, // 5^31
+    {0x9dc5ada82b70b59dULL, 0xf020000000000000ULL}, // 5^32
+    {0xc5371912364ce305ULL, 0x6c28000000000000ULL}, // 5^33
+    {0xf684df56c3e01bc6ULL, 0xc732000000000000ULL}, // 5^34
+    {0x9a130b963a6c115cULL, 0x3c7f400000000000ULL}, // 5^35
+    {0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL}, // 5^36
+    {0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL}, // 5^37
+    {0x96769950b50d88f4ULL, 0x1314448000000000ULL}, // 5^38
+};
+
+/**
+ * @brief Multiply two 64-bit integers into a 128-bit product.
+ */
+static void multiply64(uint64_t a, uint64_t b, uint64_t *high, uint64_t *low)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = (unsigned __int128)a * b;
+    *high = (uint64_t)(product >> 64);
+    *low = (uint64_t)product;
+#else
+    uint64_t aLow = (uint32_t)a, aHigh = a >> 32, bLow = (uint32_t)b, bHigh = b >> 32;
+    uint64_t lowLow = aLow * bLow, highLow = aHigh * bLow, lowHigh = aLow * bHigh, highHigh = aHigh * bHigh;
+    uint64_t middle = (lowLow >> 32) + (uint32_t)highLow + lowHigh;
+    *high = highHigh + (highLow >> 32) + (middle >> 32);
+    *low = (middle << 32) | (uint32_t)lowLow;
+#endif
+}
+
+/**
+ * @brief Count the leading zero bits of a non-zero 64-bit integer.
+ */
+static int leadingZeroes(uint64_t value)
+{
+#if defined(__GNUC__)
+    return __builtin_clzll(value);
+#else
+    int count = 0;
+    while((value & ((uint64_t)1 << 63)) == 0)
+    {
+        value <<= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief Round w * 10^q to the nearest float, ties to even, with the Eisel-Lemire algorithm.
+ *
+ * @param q The decimal exponent.
+ * @param w The decimal significand, at most 19 digits.
+ * @return The IEEE-754 bit pattern of the positive result.
+ */
+static uint32_t eiselLemire(int64_t q, uint64_t w)
+{
+    uint64_t high = 0, low = 0;
+
+    if(w == 0 || q < CSV_SMALLEST_POWER_OF_TEN)
+    {
+        return 0;
+    }
+
+    if(q > CSV_LARGEST_POWER_OF_TEN)
+    {
+        return (uint32_t)CSV_INFINITE_POWER << CSV_MANTISSA_BITS;
+    }
+
+    int lz = leadingZeroes(w);
+    w <<= lz;
+
+    const uint64_t *power = powersOfFive[q - CSV_SMALLEST_POWER_OF_TEN];
+    const uint64_t precisionMask = UINT64_MAX >> (CSV_MANTISSA_BITS + 3);
+
+    multiply64(w, power[0], &high, &low);
+
+    if((high & precisionMask) == precisionMask) //the truncated bits matter, refine with the lower half of 5^q
+    {
+        uint64_t secondHigh = 0, secondLow = 0;
+        multiply64(w, power[1], &secondHigh, &secondLow);
+        low += secondHigh;
+        high += (secondHigh > low) ? 1 : 0;
+    }
+
+    int upperBit = (int)(high >> 63);
+    int shift = upperBit + 64 - CSV_MANTISSA_BITS - 3;
+    uint64_t mantissa = high >> shift;
+    int32_t power2 = (int32_t)((((152170 + 65536) * q) >> 16) + 63) + upperBit - lz + 127;
+
+    if(power2 <= 0) //subnormal or zero
+    {
+        if(-power2 + 1 >= 64)
+        {
+            return 0;
+        }
+
+        mantissa >>= -power2 + 1;
+        mantissa += (mantissa & 1);
+        mantissa >>= 1;
+        power2 = (mantissa < ((uint64_t)1 << CSV_MANTISSA_BITS)) ? 0 : 1;
+
+        return (uint32_t)(((uint64_t)power2 << CSV_MANTISSA_BITS) | (mantissa & (((uint64_t)1 << CSV_MANTISSA_BITS) - 1)));
+    }
+
+    if(low <= 1 && q >= -17 && q <= 10 && (mantissa & 3) == 1 && (mantissa << shift) == high)
+    {
+        mantissa &= ~(uint64_t)1; //exactly halfway between two floats, round to even
+    }
+
+    mantissa += (mantissa & 1);
+    mantissa >>= 1;
+
+    if(mantissa >= ((uint64_t)2 << CSV_MANTISSA_BITS))
+    {
+        mantissa = (uint64_t)1 << CSV_MANTISSA_BITS;
+        power2++;
+    }
+
+    if(power2 >= CSV_INFINITE_POWER)
+    {
+        return (uint32_t)CSV_INFINITE_POWER << CSV_MANTISSA_BITS;
+    }
+
+    mantissa &= ~((uint64_t)1 << CSV_MANTISSA_BITS);
+
+    return (uint32_t)(((uint64_t)power2 << CSV_MANTISSA_BITS) | mantissa);
+}
+
+/**
+ * @brief Copy the number at the start of [first, last) into a null-terminated string for the C library.
+ *
+ * Leading whitespace is copied along with every following character a number can be written with,
+ * digits, letters, signs, points and the parentheses of a NaN payload, so the copy never holds more
+ * than the number but never cuts it short either. Numbers too long for 'buffer' are copied to the heap.
+ *
+ * @param buffer The buffer to copy short numbers into.
+ * @param bufferSize The size of 'buffer' in bytes.
+ * @return A pointer to the copy, 'buffer' itself or a block to free(), or NULL if memory could not be
+ *         allocated.
+ */
+static char *copyNumber(const char *first, const char *last, char *buffer, size_t bufferSize)
+{
+    const char *end = first;
+
+    while(end < last && isspace((unsigned char)*end))
+    {
+        end++;
+    }
+
+    while(end < last && (isalnum((unsigned char)*end) || (*end != '\0' && strchr("+-._()", *end) != NULL)))
+    {
+        end++;
+    }
+
+    size_t length = (size_t)(end - first);
+    char *copy = (length < bufferSize) ? buffer : (char *)malloc(length + 1);
+
+    if(copy != NULL)
+    {
+        memcpy(copy, first, length);
+        copy[length] = '\0';
+    }
+
+    return copy;
+}
+
+/**
+ * @brief Convert a decimal string that the fast path does not handle with strtof().
+ *
+ * Used for infinities, NaNs, hexadecimal floats and the rare decimals whose digits beyond the 19th
+ * decide the rounding. The number is copied so that strtof() can not read past 'last'.
+ */
+static const char *parseFloatFallback(const char *first, const char *last, float *value)
+{
+    char buffer[128];
+    char *copy = copyNumber(first, last, buffer, sizeof(buffer));
+
+    if(copy == NULL)
+    {
+        *value = 0.0f;
+        return first;
+    }
+
+    char *copyEnd = NULL;
+    *value = strtof(copy, &copyEnd);
+    const char *end = first + (copyEnd - copy);
+
+    if(copy != buffer)
+    {
+        free(copy);
+    }
+
+    return end;
+}
+
+/**
+ * @brief Parse a decimal number into a float.
+ *
+ * This function converts the number starting at 'first' to the nearest float, with round-to-nearest,
+ * ties-to-even, exactly like a correctly rounded strtof(). Unlike atof() it is not locale aware, it
+ * never reads at or beyond 'last' and it reports where the number ended, so the input does not have
+ * to be null-terminated or writable. Short decimals are converted with a single exact float
+ * operation, everything else with the Eisel-Lemire algorithm; infinities, NaNs and hexadecimal
+ * floats are still accepted through a slower fallback.
+ *
+ * @param first A pointer to the first character of the number, leading whitespace is not skipped.
+ * @param last A pointer one past the last character that may be read.
+ * @param value A pointer to the float to fill, set to zero if no number could be parsed.
+ * @return A pointer one past the last character of the number, or 'first' if no number could be parsed.
+ *
+ * @code
+ *   // Example usage:
+ *   const char *text = "3.25, 4";
+ *   float value;
+ *   const char *end = parseFloat(text, text + strlen(text), &value); // value is 3.25, end points at ','
+ * @endcode
+ */
+const char *parseFloat(const char *first, const char *last, float *value)
+{
+    const char *cursor = first;
+    bool_t negative = FALSE;
+
+    *value = 0.0f;
+
+    if(cursor < last && (*cursor == '-' || *cursor == '+'))
+    {
+        negative = (*cursor == '-') ? TRUE : FALSE;
+        cursor++;
+    }
+
+    const char *integerStart = cursor;
+    uint64_t significand = 0;
+
+    while(cursor < last && (unsigned)(*cursor - '0') < 10)
+    {
+        significand = significand * 10 + (uint64_t)(*cursor - '0'); //wraps around for more than 19 digits, fixed below
+        cursor++;
+    }
+
+    const char *integerEnd = cursor;
+    const char *fractionStart = cursor, *fractionEnd = cursor;
+    int64_t digitCount = integerEnd - integerStart;
+    int64_t exponent = 0, explicitExponent = 0;
+
+    if(cursor < last && *cursor == '.')
+    {
+        cursor++;
+        fractionStart = cursor;
+
+        while(cursor < last && (unsigned)(*cursor - '0') < 10)
+        {
+            significand = significand * 10 + (uint64_t)(*cursor - '0');
+            cursor++;
+        }
+
+        fractionEnd = cursor;
+        exponent = -(int64_t)(fractionEnd - fractionStart);
+        digitCount -= exponent;
+    }
+
+    if(digitCount == 0) //no digits: "inf", "nan", a lone sign or no number at all
+    {
+        return parseFloatFallback(first, last, value);
+    }
+
+    if(cursor < last && (*cursor == 'e' || *cursor == 'E'))
+    {
+        const char *exponentCursor = cursor + 1;
+        bool_t negativeExponent = FALSE;
+
+        if(exponentCursor < last && (*exponentCursor == '-' || *exponentCursor == '+'))
+        {
+            negativeExponent = (*exponentCursor == '-') ? TRUE : FALSE;
+            exponentCursor++;
+        }
+
+        if(exponentCursor < last && (unsigned)(*exponentCursor - '0') < 10) //otherwise the 'e' is not part of the number
+        {
+            while(exponentCursor < last && (unsigned)(*exponentCursor - '0') < 10)
+            {
+                explicitExponent = (explicitExponent < 0x10000000) ? explicitExponent * 10 + (*exponentCursor - '0')
+                                                                   : explicitExponent;
+                exponentCursor++;
+            }
+
+            explicitExponent = (negativeExponent == TRUE) ? -explicitExponent : explicitExponent;
+            exponent += explicitExponent;
+            cursor = exponentCursor;
+        }
+    }
+
+    if(integerEnd - integerStart == 1 && *integerStart == '0' && cursor < last && (*cursor == 'x' || *cursor == 'X'))
+    {
+        return parseFloatFallback(first, last, value); //hexadecimal float
+    }
+
+    bool_t tooManyDigits = FALSE;
+
+    if(digitCount > 19) //leading zeros do not count, anything beyond 19 significant digits gets truncated
+    {
+        const char *digit = integerStart;
+
+        while(digit < fractionEnd && (*digit == '0' || *digit == '.'))
+        {
+            digitCount -= (*digit == '0') ? 1 : 0;
+            digit++;
+        }
+
+        if(digitCount > 19)
+        {
+            const uint64_t minNineteenDigits = 1000000000000000000ULL;
+            tooManyDigits = TRUE;
+            significand = 0;
+
+            while(significand < minNineteenDigits && digit < integerEnd)
+            {
+                significand = significand * 10 + (uint64_t)(*digit - '0');
+                digit++;
+            }
+
+            if(significand >= minNineteenDigits)
+            {
+                exponent = (integerEnd - digit) + explicitExponent;
+            }
+            else
+            {
+                digit = (digit < fractionStart) ? fractionStart : digit;
+
+                while(significand < minNineteenDigits && digit < fractionEnd)
+                {
+                    significand = significand * 10 + (uint64_t)(*digit - '0');
+                    digit++;
+                }
+
+                exponent = -(int64_t)(digit - fractionStart) + explicitExponent;
+            }
+        }
+    }
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    if(tooManyDigits == FALSE && exponent >= -10 && exponent <= 10 && significand <= ((uint64_t)1 << 24))
+    {
+        float result = (float)significand; //exact, so one correctly rounded operation gives the answer
+
+        result = (exponent < 0) ? result / exactPowersOfTen[-exponent] : result * exactPowersOfTen[exponent];
+        *value = (negative == TRUE) ? -result : result;
+
+        return cursor;
+    }
+#endif
+
+    uint32_t bits = eiselLemire(exponent, significand);
+
+    if(tooManyDigits == TRUE && bits != eiselLemire(exponent, significand + 1))
+    {
+        return parseFloatFallback(first, last, value); //the truncated digits decide the rounding
+    }
+
+    bits |= (negative == TRUE) ? ((uint32_t)1 << 31) : 0;
+    memcpy(value, &bits, sizeof(float));
+
+    return cursor;
+}
+
+//STRUCTURAL SCANNER ----------------------------------------------------------
+
+/**
+ * @brief Index of the lowest set bit of a non-zero 64-bit mask.
+ */
+static int trailingZeroes(uint64_t mask)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(mask);
+#else
+    int count = 0;
+    while((mask & 1) == 0)
+    {
+        mask >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief Load the structural masks of the block the scanner currently points at.
+ *
+ * Full blocks are scanned in place. The last, partial block of the range is copied into a padded
+ * buffer first so the kernels never read beyond 'end', and the bits past the end are cleared.
+ */
+static void loadScannerBlock(csvScanner_t *scanner)
+{
+    csvBlockMasks_t masks;
+    size_t remaining = (size_t)(scanner->end - scanner->block);
+
+    if(remaining >= 64)
+    {
+        scanner->kernels->scanBlock(scanner->block, scanner->separator, &masks);
+    }
+    else
+    {
+        char padded[64];
+
+        memset(padded, 0, sizeof(padded));
+        memcpy(padded, scanner->block, remaining);
+        scanner->kernels->scanBlock(padded, scanner->separator, &masks);
+
+        uint64_t valid = ((uint64_t)1 << remaining) - 1;
+        masks.separators &= valid;
+        masks.newlines &= valid;
+    }
+
+    scanner->structurals = masks.separators | masks.newlines;
+
+    if((masks.quotes | scanner->quoted) != 0) //blocks without quotes, outside a quoted field, end here
+    {
+        uint64_t inside = scanner->kernels->quoteMask(masks.quotes) ^ scanner->quoted;
+
+        scanner->structurals &= ~inside; //separators and newlines inside quotes are part of the field
+        scanner->quoted = (uint64_t)((int64_t)inside >> 63); //the state after the last byte goes on to the next block
+    }
+}
+
+/**
+ * @brief Start scanning the range [begin, end) for field separators and newlines outside quoted fields.
+ *
+ * @param quoted TRUE if 'begin' is inside a quoted field.
+ */
+static void startScanner(csvScanner_t *scanner, const char *begin, const char *end, char separator, bool_t quoted)
+{
+    scanner->block = begin;
+    scanner->end = end;
+    scanner->separator = separator;
+    scanner->kernels = selectKernels();
+    scanner->structurals = 0;
+    scanner->quoted = (quoted == TRUE) ? ~(uint64_t)0 : 0;
+
+    if(begin < end)
+    {
+        loadScannerBlock(scanner);
+    }
+}
+
+/**
+ * @brief Start scanning the range [begin, end), which starts at the beginning of a row.
+ */
+static void initScanner(csvScanner_t *scanner, const char *begin, const char *end, char separator)
+{
+    startScanner(scanner, begin, end, separator, FALSE);
+}
+
+/**
+ * @brief Get the position of the next field separator or newline.
+ *
+ * Positions are taken from the 64-bit structural masks of the current block, so the bytes in between
+ * are never looked at one by one.
+ *
+ * @return A pointer to the next separator or newline, or 'end' once the range is exhausted.
+ */
+static const char *nextStructural(csvScanner_t *scanner)
+{
+    while(scanner->structurals == 0)
+    {
+        if(scanner->end - scanner->block <= 64)
+        {
+            scanner->block = scanner->end;
+            return scanner->end;
+        }
+
+        scanner->block += 64;
+        loadScannerBlock(scanner);
+    }
+
+    int index = trailingZeroes(scanner->structurals);
+    scanner->structurals &= scanner->structurals - 1; //hand out the lowest bit only
+
+    return scanner->block + index;
+}
+
+/**
+ * @brief Find the newline ending a row, passing over the newlines inside quoted fields.
+ *
+ * Rows without a double quote are delimited by memchr() alone; the others go through the structural
+ * scanner, which masks off the quoted bytes 64 at a time.
+ *
+ * @param begin A character of the row, usually its first one.
+ * @param end One past the last character of the range.
+ * @param quoted TRUE if 'begin' is inside a quoted field. Set to FALSE if a newline is found, and else
+ *               to whether 'end' is inside a quoted field.
+ * @return A pointer to the newline ending the row, or 'end' if the row does not end within the range.
+ */
+static const char *findRowEnd(const char *begin, const char *end, bool_t *quoted)
+{
+    const char *newline = (begin < end) ? memchr(begin, '\n', (size_t)(end - begin)) : NULL;
+    const char *rowEnd = (newline != NULL) ? newline : end;
+
+    if(*quoted == FALSE && (begin >= rowEnd || memchr(begin, '"', (size_t)(rowEnd - begin)) == NULL))
+    {
+        return rowEnd;
+    }
+
+    csvScanner_t scanner;
+
+    startScanner(&scanner, begin, end, '\n', *quoted); //separators are newlines too, only newlines are handed out
+    rowEnd = nextStructural(&scanner);
+    *quoted = (rowEnd == end && scanner.quoted != 0) ? TRUE : FALSE;
+
+    return rowEnd;
+}
+
+/**
+ * @brief Check whether a character only pads a field.
+ *
+ * Whitespace, double quotes and every deliminator character but the first one (the field separator)
+ * may surround a value, like the space of the default ", " deliminator.
+ */
+static int isPaddingChar(char character, const char *delim)
+{
+    return isspace((unsigned char)character) || character == '"' || (character != '\0' && strchr(delim + 1, character) != NULL);
+}
+
+/**
+ * @brief Convert the field [first, last) into a data point.
+ *
+ * Padding is skipped and the value is converted with parseFloat(); characters trailing the number
+ * are ignored like atof() would ignore them. Empty fields are zero.
+ */
+static float parseField(const char *first, const char *last, const char *delim)
+{
+    float value = 0.0f;
+
+    while(first < last && isPaddingChar(*first, delim))
+    {
+        first++;
+    }
+
+    if(first < last)
+    {
+        (void)parseFloat(first, last, &value);
+    }
+
+    return value;
+}
+
+/**
+ * @brief Check whether the range [first, last) only holds whitespace.
+ */
+static int isBlank(const char *first, const char *last)
+{
+    while(first < last && isspace((unsigned char)*first))
+    {
+        first++;
+    }
+
+    return first == last;
+}
+
+/**
+ * @brief Get the column the field at position 'field' of a row is loaded into, or -1 if it is skipped.
+ */
+static int columnOfField(const csvData_t *df, int field)
+{
+    if(df->fieldColumns == NULL)
+    {
+        return (field < df->cols) ? field : -1;
+    }
+
+    return (field < df->fields) ? df->fieldColumns[field] : -1;
+}
+
+/**
+ * @brief Parse every row in the range [begin, end) into new rows of the data frame.
+ *
+ * Fields are delimited by the first character of the deliminator string, rows by newlines. Their
+ * positions come from the structural scanner, 64 bytes at a time, and each field is converted straight
+ * out of the input, which is never written to. Rows that only hold whitespace are skipped, missing
+ * fields are left as zero, and fields beyond 'cols' or outside the projection of 'fieldColumns' are
+ * passed over without being converted. The last row does not have to end with a newline.
+ *
+ * @param df A pointer to the data frame to append the rows to.
+ * @param storage A pointer to the row storage state of the read.
+ * @param begin The first character of the rows.
+ * @param end One past the last character of the rows.
+ * @return TRUE once every row has been parsed, ERROR if memory could not be allocated.
+ */
+static bool_t parseScannedRows(csvData_t *df, csvRowStorage_t *storage, const char *begin, const char *end)
+{
+    csvScanner_t scanner;
+    const char *fieldStart = begin;
+    float *rowData = NULL;
+    int col = 0;
+
+    initScanner(&scanner, begin, end, df->delim[0]);
+
+    while(fieldStart < end)
+    {
+        const char *fieldEnd = nextStructural(&scanner);
+        bool_t rowEnds = (fieldEnd == end || *fieldEnd == '\n') ? TRUE : FALSE;
+
+        if(rowData == NULL) //first field of a row
+        {
+            if(rowEnds == TRUE && isBlank(fieldStart, fieldEnd))
+            {
+                fieldStart = fieldEnd + 1; //whitespace-only rows do not hold any data points
+                continue;
+            }
+            else if(storage->rowLimit > 0 && df->rows >= storage->rowLimit)
+            {
+                return TRUE; //the rows past the limit are never looked at
+            }
+
+            rowData = appendRow(df, storage);
+            col = 0;
+
+            if(rowData == NULL)
+            {
+                return ERROR;
+            }
+        }
+
+        int column = columnOfField(df, col);
+
+        if(column >= 0) //skipped fields are never converted
+        {
+            rowData[(size_t)column * storage->stride] = parseField(fieldStart, fieldEnd, df->delim);
+        }
+        col++;
+
+        rowData = (rowEnds == TRUE) ? NULL : rowData;
+        fieldStart = fieldEnd + 1;
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Parse every row in the range [begin, end) with the row parser generated for the schema of the input.
+ *
+ * Rows go straight to 'df->rowParser', with no structural scan and no test of the options on any field.
+ * A row it does not fit, such as a blank or a quoted one, is taken back and parsed again by
+ * parseScannedRows(), so the data frame holds the same values either way.
+ *
+ * @return TRUE once every row has been parsed, ERROR if memory could not be allocated.
+ */
+static bool_t parseFixedRows(csvData_t *df, csvRowStorage_t *storage, const char *begin, const char *end)
+{
+    const char *(*parseRow)(const char *begin, const char *end, float *row, size_t stride) = df->rowParser->parseRow;
+    const char *row = begin;
+
+    while(row < end && (storage->rowLimit == 0 || df->rows < storage->rowLimit))
+    {
+        float *rowData = takeRow(df, storage); //the parser writes every data point of the rows it fits
+
+        if(rowData == NULL)
+        {
+            return ERROR;
+        }
+
+        const char *next = parseRow(row, end, rowData, storage->stride);
+
+        if(next == NULL)
+        {
+            bool_t quoted = FALSE;
+            const char *rowEnd = findRowEnd(row, end, &quoted);
+            next = (rowEnd < end) ? rowEnd + 1 : end;
+
+            df->rows--; //the arena keeps a row of CSV_LAYOUT_ROWS, every other layout reuses its slot
+
+            if(parseScannedRows(df, storage, row, next) == ERROR)
+            {
+                return ERROR;
+            }
+        }
+
+        row = next;
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Parse every row in the range [begin, end) into new rows of the data frame, through the parser
+ *        that fits its storage and schema.
+ *
+ * @return TRUE once every row has been parsed, ERROR if memory could not be allocated.
+ */
+static bool_t parseRows(csvData_t *df, csvRowStorage_t *storage, const char *begin, const char *end)
+{
+    if(storage->typed != NULL) //every column is converted to its own type
+    {
+        return parseTypedRows(df, storage, begin, end);
+    }
+    else if(df->rowParser != NULL && df->fieldColumns == NULL && df->cols == df->rowParser->cols)
+    {
+        return parseFixedRows(df, storage, begin, end);
+    }
+
+    return parseScannedRows(df, storage, begin, end);
+}
+
+/**
+ * @brief Count the rows in the range [begin, end) without parsing them.
+ *
+ * Only the newline masks of the structural scanner are looked at, so this runs at the speed of the
+ * SIMD scan. Rows that only hold whitespace are not counted.
+ *
+ * @param quoted Set to TRUE if the range ends inside a quoted field, may be NULL.
+ * @return The number of rows holding data points.
+ */
+static long countRows(const char *begin, const char *end, char separator, bool_t *quoted)
+{
+    csvScanner_t scanner;
+    const char *rowStart = begin;
+    long rows = 0;
+
+    initScanner(&scanner, begin, end, separator);
+
+    while(rowStart < end)
+    {
+        const char *rowEnd = nextStructural(&scanner);
+
+        if(rowEnd < end && *rowEnd != '\n')
+        {
+            continue; //separators do not end a row
+        }
+
+        rows += isBlank(rowStart, rowEnd) ? 0 : 1;
+        rowStart = rowEnd + 1;
+    }
+
+    if(quoted != NULL)
+    {
+        *quoted = (scanner.quoted != 0) ? TRUE : FALSE;
+    }
+
+    return rows;
+}
+
+/**
+ * @brief Find where the complete rows of the range [begin, end) end, one past the last newline outside quotes.
+ *
+ * Without a quote in the range the last newline ends the last complete row, otherwise the rows are
+ * scanned from 'begin', as a quoted field may hold newlines.
+ *
+ * @return One past the newline ending the last complete row, 'begin' if no row ends in the range.
+ */
+static const char *findLastRowEnd(const char *begin, const char *end)
+{
+    const char *rowsEnd = end;
+    bool_t quoted = FALSE;
+
+    if(begin >= end || memchr(begin, '"', (size_t)(end - begin)) == NULL)
+    {
+        while(rowsEnd > begin && rowsEnd[-1] != '\n')
+        {
+            rowsEnd--;
+        }
+
+        return rowsEnd;
+    }
+
+    rowsEnd = begin;
+
+    for(const char *rowEnd = findRowEnd(begin, end, &quoted); rowEnd < end; rowEnd = findRowEnd(rowsEnd, end, &quoted))
+    {
+        rowsEnd = rowEnd + 1;
+    }
+
+    return rowsEnd;
+}
+
+/**
+ * @brief Count the fields of the first row in the range [begin, end) that is not blank.
+ *
+ * @return The number of fields of that row, or zero if every row is blank.
+ */
+static int countFields(const char *begin, const char *end, char separator)
+{
+    const char *row = begin;
+
+    while(row < end)
+    {
+        bool_t quoted = FALSE;
+        const char *rowEnd = findRowEnd(row, end, &quoted);
+
+        if( ! isBlank(row, rowEnd))
+        {
+            csvScanner_t scanner;
+            int fields = 1;
+
+            initScanner(&scanner, row, rowEnd, separator); //separators inside quoted fields do not count
+            while(nextStructural(&scanner) < rowEnd)
+            {
+                fields++;
+            }
+            return fields;
+        }
+
+        row = rowEnd + 1;
+    }
+
+    return 0;
+}
+
+//TYPED COLUMNS ---------------------------------------------------------------
+
+#define CSV_CATEGORY_INITIAL_SLOTS  (64)
+
+/**
+ * @brief Get the size in bytes of a data point of a column type.
+ */
+static size_t typeSize(csvType_t type)
+{
+    if(type == CSV_TYPE_INT8)
+    {
+        return sizeof(int8_t);
+    }
+    else if(type == CSV_TYPE_INT16)
+    {
+        return sizeof(int16_t);
+    }
+    else if(type == CSV_TYPE_FLOAT64 || type == CSV_TYPE_INT64)
+    {
+        return sizeof(int64_t);
+    }
+
+    return sizeof(int32_t); //CSV_TYPE_FLOAT32, CSV_TYPE_INT32 and the codes of CSV_TYPE_CATEGORY
+}
+
+/**
+ * @brief Get the narrowest integer type that holds 'value'.
+ */
+static csvType_t integerType(int64_t value)
+{
+    if(value >= INT8_MIN && value <= INT8_MAX)
+    {
+        return CSV_TYPE_INT8;
+    }
+    else if(value >= INT16_MIN && value <= INT16_MAX)
+    {
+        return CSV_TYPE_INT16;
+    }
+    else if(value >= INT32_MIN && value <= INT32_MAX)
+    {
+        return CSV_TYPE_INT32;
+    }
+
+    return CSV_TYPE_INT64;
+}
+
+/**
+ * @brief Read the data point at 'row' of a typed column block as a double.
+ */
+static double readValue(const void *block, csvType_t type, size_t row)
+{
+    switch(type)
+    {
+        case CSV_TYPE_FLOAT32:  return ((const float *)block)[row];
+        case CSV_TYPE_FLOAT64:  return ((const double *)block)[row];
+        case CSV_TYPE_INT8:     return ((const int8_t *)block)[row];
+        case CSV_TYPE_INT16:    return ((const int16_t *)block)[row];
+        case CSV_TYPE_INT64:    return (double)((const int64_t *)block)[row];
+        default:                return ((const int32_t *)block)[row];
+    }
+}
+
+/**
+ * @brief Read the data point at 'row' of an integer column block.
+ */
+static int64_t readInteger(const void *block, csvType_t type, size_t row)
+{
+    switch(type)
+    {
+        case CSV_TYPE_INT8:     return ((const int8_t *)block)[row];
+        case CSV_TYPE_INT16:    return ((const int16_t *)block)[row];
+        case CSV_TYPE_INT64:    return ((const int64_t *)block)[row];
+        default:                return ((const int32_t *)block)[row];
+    }
+}
+
+/**
+ * @brief Write 'value' to 'row' of an integer or CSV_TYPE_CATEGORY column block, it must fit the type.
+ */
+static void storeInteger(void *block, csvType_t type, size_t row, int64_t value)
+{
+    switch(type)
+    {
+        case CSV_TYPE_INT8:     ((int8_t *)block)[row] = (int8_t)value; break;
+        case CSV_TYPE_INT16:    ((int16_t *)block)[row] = (int16_t)value; break;
+        case CSV_TYPE_INT64:    ((int64_t *)block)[row] = value; break;
+        default:                ((int32_t *)block)[row] = (int32_t)value; break;
+    }
+}
+
+/**
+ * @brief Parse a decimal integer that fits an 'int64_t'.
+ *
+ * @param first A pointer to the first character of the integer, an optional sign followed by digits.
+ * @param last A pointer one past the last character that may be read.
+ * @param value A pointer to the integer to fill, left untouched if no integer could be parsed.
+ * @return A pointer one past the last digit, or 'first' if there is no integer or it does not fit.
+ */
+static const char *parseInteger(const char *first, const char *last, int64_t *value)
+{
+    bool_t negative = (first < last && *first == '-') ? TRUE : FALSE;
+    const char *digits = (first < last && (*first == '-' || *first == '+')) ? first + 1 : first;
+    const char *cursor = digits;
+    uint64_t magnitude = 0;
+
+    for(; cursor < last && isdigit((unsigned char)*cursor); cursor++)
+    {
+        unsigned digit = (unsigned)(*cursor - '0');
+
+        if(magnitude > (UINT64_MAX - digit) / 10)
+        {
+            return first;
+        }
+
+        magnitude = magnitude * 10 + digit;
+    }
+
+    if(cursor == digits || magnitude > (uint64_t)INT64_MAX + (negative == TRUE ? 1u : 0u))
+    {
+        return first;
+    }
+
+    *value = (negative == TRUE) ? -(int64_t)(magnitude - 1) - 1 : (int64_t)magnitude; //INT64_MIN has no positive twin
+
+    return cursor;
+}
+
+/**
+ * @brief Parse a decimal number into a double, like parseFloat() but through the C library.
+ *
+ * @return A pointer one past the last character of the number, or 'first' if no number could be parsed.
+ */
+static const char *parseDouble(const char *first, const char *last, double *value)
+{
+    char buffer[128];
+    char *copy = copyNumber(first, last, buffer, sizeof(buffer));
+
+    if(copy == NULL)
+    {
+        *value = 0.0;
+        return first;
+    }
+
+    char *copyEnd = NULL;
+    *value = strtod(copy, &copyEnd);
+    const char *end = first + (copyEnd - copy);
+
+    if(copy != buffer)
+    {
+        free(copy);
+    }
+
+    return end;
+}
+
+/**
+ * @brief Strip the padding off both ends of the field [*first, *last), and the quotes around it.
+ *
+ * A quoted field keeps what its quotes hold as it is, padding included; its doubled quotes are left
+ * for unquoteField() to collapse.
+ */
+static void trimField(const char **first, const char **last, const char *delim)
+{
+    while(*first < *last && **first != '"' && isPaddingChar(**first, delim))
+    {
+        (*first)++;
+    }
+
+    while(*last > *first && *(*last - 1) != '"' && isPaddingChar(*(*last - 1), delim))
+    {
+        (*last)--;
+    }
+
+    if(*last - *first >= 2 && **first == '"' && *(*last - 1) == '"')
+    {
+        (*first)++;
+        (*last)--;
+    }
+}
+
+/**
+ * @brief Copy the inside of a quoted field, trimmed by trimField(), reading every doubled quote as one.
+ *
+ * @param copy Where the field is copied to, at least as long as the field.
+ * @return The number of characters copied.
+ */
+static size_t unquoteField(const char *first, const char *last, char *copy)
+{
+    size_t length = 0;
+
+    for(const char *character = first; character < last; character++)
+    {
+        copy[length++] = *character;
+        character += (*character == '"' && character + 1 < last && character[1] == '"') ? 1 : 0;
+    }
+
+    return length;
+}
+
+/**
+ * @brief Tell an integer, a real number and text apart, for a trimmed field that is not empty.
+ *
+ * @return CSV_TYPE_INT64 with 'integer' set, CSV_TYPE_FLOAT64 with 'real' set, or CSV_TYPE_CATEGORY.
+ */
+static csvType_t classifyField(const char *first, const char *last, int64_t *integer, double *real)
+{
+    if(parseInteger(first, last, integer) == last)
+    {
+        return CSV_TYPE_INT64;
+    }
+    else if(parseDouble(first, last, real) == last)
+    {
+        return CSV_TYPE_FLOAT64;
+    }
+
+    return CSV_TYPE_CATEGORY;
+}
+
+/**
+ * @brief Count the significant digits of a decimal number, from its first to its last non-zero digit.
+ */
+static int significantDigits(const char *first, const char *last)
+{
+    int digits = 0, pending = 0;
+
+    for(; first < last && *first != 'e' && *first != 'E'; first++)
+    {
+        if(*first == '0')
+        {
+            pending += (digits > 0) ? 1 : 0; //zeroes only count once a non-zero digit follows
+        }
+        else if(isdigit((unsigned char)*first))
+        {
+            digits += pending + 1;
+            pending = 0;
+        }
+    }
+
+    return digits;
+}
+
+/**
+ * @brief Grow the open addressing table of a category table to twice its size.
+ *
+ * @return TRUE on success, ERROR if memory could not be allocated.
+ */
+static bool_t growCategorySlots(csvCategoryTable_t *table)
+{
+    size_t slotCount = (table->slotCount > 0) ? table->slotCount * 2 : CSV_CATEGORY_INITIAL_SLOTS;
+    int *slots = (int *)malloc(sizeof(int) * slotCount);
+
+    if(slots == NULL)
+    {
+        return ERROR;
+    }
+
+    for(size_t slot=0; slot<slotCount; slot++)
+    {
+        slots[slot] = -1;
+    }
+
+    for(int code=0; code<table->count; code++) //every value moves to its slot in the larger table
+    {
+        const char *value = table->values[code];
+        size_t slot = hashBytes(0xcbf29ce484222325ull, (const unsigned char *)value, strlen(value)) & (slotCount - 1);
+
+        while(slots[slot] >= 0)
+        {
+            slot = (slot + 1) & (slotCount - 1);
+        }
+
+        slots[slot] = code;
+    }
+
+    free(table->slots);
+    table->slots = slots;
+    table->slotCount = slotCount;
+
+    return TRUE;
+}
+
+/**
+ * @brief Get the code of a category value, adding the value to the table if it is new.
+ *
+ * @param table A pointer to the category table of the column.
+ * @param value The first character of the value, which does not have to be null-terminated.
+ * @param length The number of characters of the value.
+ * @return The code of the value, or -1 if memory could not be allocated.
+ */
+static int lookupCategory(csvCategoryTable_t *table, const char *value, size_t length)
+{
+    if((size_t)(table->count + 1) * 2 > table->slotCount && growCategorySlots(table) == ERROR)
+    {
+        return -1;
+    }
+
+    size_t mask = table->slotCount - 1;
+    size_t slot = hashBytes(0xcbf29ce484222325ull, (const unsigned char *)value, length) & mask;
+
+    for(; table->slots[slot] >= 0; slot = (slot + 1) & mask)
+    {
+        const char *known = table->values[table->slots[slot]];
+
+        if(strncmp(known, value, length) == 0 && known[length] == '\0')
+        {
+            return table->slots[slot];
+        }
+    }
+
+    if(table->count == table->capacity)
+    {
+        int capacity = (table->capacity > 0) ? table->capacity * 2 : CSV_CATEGORY_INITIAL_SLOTS;
+        char **values = (char **)realloc(table->values, sizeof(char *) * capacity);
+
+        if(values == NULL)
+        {
+            return -1;
+        }
+
+        table->values = values;
+        table->capacity = capacity;
+    }
+
+    char *copy = (char *)malloc(length + 1);
+
+    if(copy == NULL)
+    {
+        return -1;
+    }
+
+    memcpy(copy, value, length);
+    copy[length] = '\0';
+
+    table->values[table->count] = copy;
+    table->slots[slot] = table->count;
+
+    return table->count++;
+}
+
+/**
+ * @brief Release every value and slot of a category table.
+ */
+static void freeCategoryTable(csvCategoryTable_t *table)
+{
+    for(int code=0; code<table->count; code++)
+    {
+        free(table->values[code]);
+    }
+
+    free(table->values);
+    free(table->slots);
+    memset(table, 0, sizeof(csvCategoryTable_t));
+}
+
+typedef struct
+{
+    bool_t integers;        //an integer has been seen
+    bool_t reals;           //a number that is not an integer has been seen
+    bool_t text;            //a field that is not a number has been seen
+    bool_t wide;            //a number needs more precision or range than a float has
+    int64_t min;            //smallest integer seen
+    int64_t max;            //largest integer seen
+}csvColumnSample_t;
+
+/**
+ * @brief Infer the type of every CSV_TYPE_AUTO column from the first rows of the range [begin, end).
+ *
+ * Columns holding any text are categorical, columns of integers get the narrowest integer type that
+ * holds every integer of the sample, and other numbers are floats, or doubles if a sampled number has
+ * more significant digits or range than a float can hold. Columns without a value in the sample are
+ * floats.
+ *
+ * @param df A pointer to the data frame, with its columns known.
+ * @param begin The first character of the data point rows.
+ * @param end One past the last character of the sampled part of the data point rows.
+ * @param sampleRows The number of rows to infer the types from.
+ * @return TRUE on success, ERROR if memory could not be allocated.
+ */
+static bool_t inferColumnTypes(csvData_t *df, const char *begin, const char *end, int sampleRows)
+{
+    csvColumnSample_t *samples = (csvColumnSample_t *)calloc((df->cols > 0) ? df->cols : 1, sizeof(csvColumnSample_t));
+    csvScanner_t scanner;
+    const char *fieldStart = begin;
+    int field = 0, rows = 0;
+
+    if(samples == NULL)
+    {
+        return ERROR;
+    }
+
+    initScanner(&scanner, begin, end, df->delim[0]);
+
+    while(fieldStart < end && rows < sampleRows)
+    {
+        const char *fieldEnd = nextStructural(&scanner);
+        bool_t rowEnds = (fieldEnd == end || *fieldEnd == '\n') ? TRUE : FALSE;
+        int column = columnOfField(df, field);
+
+        if(field == 0 && rowEnds == TRUE && isBlank(fieldStart, fieldEnd))
+        {
+            fieldStart = fieldEnd + 1; //whitespace-only rows are not sampled
+            continue;
+        }
+
+        const char *first = fieldStart, *last = fieldEnd;
+        trimField(&first, &last, df->delim);
+
+        if(column >= 0 && df->types[column] == CSV_TYPE_AUTO && first < last)
+        {
+            csvColumnSample_t *sample = &samples[column];
+            int64_t integer = 0;
+            double real = 0.0;
+            csvType_t kind = classifyField(first, last, &integer, &real);
+
+            if(kind == CSV_TYPE_INT64)
+            {
+                sample->min = (sample->integers == FALSE || integer < sample->min) ? integer : sample->min;
+                sample->max = (sample->integers == FALSE || integer > sample->max) ? integer : sample->max;
+                sample->integers = TRUE;
+            }
+
+            sample->reals = (kind == CSV_TYPE_FLOAT64) ? TRUE : sample->reals;
+            sample->text = (kind == CSV_TYPE_CATEGORY) ? TRUE : sample->text;
+
+            if(kind != CSV_TYPE_CATEGORY && (significantDigits(first, last) > FLT_DIG ||
+               (kind == CSV_TYPE_FLOAT64 && isfinite(real) && (fabs(real) > FLT_MAX || (real != 0.0 && fabs(real) < FLT_MIN)))))
+            {
+                sample->wide = TRUE;
+            }
+        }
+
+        field = (rowEnds == TRUE) ? 0 : field + 1;
+        rows += (rowEnds == TRUE) ? 1 : 0;
+        fieldStart = fieldEnd + 1;
+    }
+
+    for(int col=0; col<df->cols; col++)
+    {
+        const csvColumnSample_t *sample = &samples[col];
+
+        if(df->types[col] != CSV_TYPE_AUTO)
+        {
+            continue;
+        }
+        else if(sample->text == TRUE)
+        {
+            df->types[col] = CSV_TYPE_CATEGORY;
+        }
+        else if(sample->reals == TRUE)
+        {
+            df->types[col] = (sample->wide == TRUE) ? CSV_TYPE_FLOAT64 : CSV_TYPE_FLOAT32;
+        }
+        else if(sample->integers == TRUE)
+        {
+            csvType_t low = integerType(sample->min), high = integerType(sample->max);
+            df->types[col] = (low > high) ? low : high;
+        }
+        else
+        {
+            df->types[col] = CSV_TYPE_FLOAT32;
+        }
+    }
+
+    free(samples);
+
+    return TRUE;
+}
+
+/**
+ * @brief Give every column of a data frame the type asked for by the loader options.
+ *
+ * Without 'columnTypes' and 'inferTypes' the data frame is left untyped and every data point is a
+ * float. Otherwise the columns take the types of 'columnTypes', one for every column left by the
+ * projection, and CSV_TYPE_AUTO columns, or every column if 'columnTypes' is NULL, are inferred from
+ * the first rows of the sample. Typed data frames always have the columnar layout.
+ *
+ * @param df A pointer to the data frame, with its columns known.
+ * @param options A pointer to the loader options.
+ * @param begin The first character of the data point rows available for sampling.
+ * @param end One past the last character of those rows.
+ * @return TRUE on success, ERROR if memory could not be allocated.
+ */
+static bool_t resolveColumnTypes(csvData_t *df, const csvOptions_t *options, const char *begin, const char *end)
+{
+    if(options->columnTypes == NULL && options->inferTypes != TRUE)
+    {
+        return TRUE;
+    }
+
+    size_t cols = (df->cols > 0) ? (size_t)df->cols : 1;
+    df->types = (csvType_t *)arenaAlloc(df->arena, sizeof(csvType_t) * cols, CSV_ARENA_MIN_ALIGNMENT);
+    df->dictionaries = (csvDictionary_t *)arenaAlloc(df->arena, sizeof(csvDictionary_t) * cols, CSV_ARENA_MIN_ALIGNMENT);
+
+    if(df->types == NULL || df->dictionaries == NULL)
+    {
+        return ERROR;
+    }
+
+    memset(df->dictionaries, 0, sizeof(csvDictionary_t) * cols);
+    df->layout = CSV_LAYOUT_COLUMNAR;
+
+    for(int col=0; col<df->cols; col++)
+    {
+        csvType_t type = (options->columnTypes != NULL) ? options->columnTypes[col] : CSV_TYPE_AUTO;
+        df->types[col] = (type >= CSV_TYPE_FLOAT32 && type <= CSV_TYPE_AUTO) ? type : CSV_TYPE_FLOAT32;
+    }
+
+    return inferColumnTypes(df, begin, end, (options->typeSampleRows > 0) ? options->typeSampleRows : CSV_TYPE_SAMPLE_ROWS);
+}
+
+/**
+ * @brief Prepare the typed storage of a read, without any column block.
+ *
+ * @return TRUE on success, ERROR if memory could not be allocated.
+ *
+ * @note Every typed storage must be released with closeTypedStorage().
+ */
+static bool_t initTypedStorage(const csvData_t *df, csvTypedStorage_t *typed)
+{
+    size_t cols = (df->cols > 0) ? (size_t)df->cols : 1;
+
+    memset(typed, 0, sizeof(csvTypedStorage_t));
+    typed->columns = (void **)calloc(cols, sizeof(void *));
+    typed->categories = (csvCategoryTable_t *)calloc(cols, sizeof(csvCategoryTable_t));
+
+    return (typed->columns != NULL && typed->categories != NULL) ? TRUE : ERROR;
+}
+
+/**
+ * @brief Release the category tables of a typed storage, the column blocks belong to the arena.
+ */
+static void closeTypedStorage(const csvData_t *df, csvTypedStorage_t *typed)
+{
+    for(int col=0; typed->categories != NULL && col<df->cols; col++)
+    {
+        freeCategoryTable(&typed->categories[col]);
+    }
+
+    free(typed->categories);
+    free(typed->columns);
+    memset(typed, 0, sizeof(csvTypedStorage_t));
+}
+
+/**
+ * @brief Allocate column blocks of 'rows' data points for every column of a typed read.
+ *
+ * @return TRUE on success, ERROR if memory could not be allocated.
+ */
+static bool_t allocTypedColumns(csvData_t *df, csvRowStorage_t *storage, int rows)
+{
+    for(int col=0; col<df->cols; col++)
+    {
+        void *block = arenaAllocDedicated(df->arena, typeSize(df->types[col]) * (size_t)((rows > 0) ? rows : 1));
+
+        if(block == NULL)
+        {
+            return ERROR;
+        }
+
+        storage->typed->columns[col] = block;
+    }
+
+    storage->rowCapacity = rows;
+
+    return TRUE;
+}
+
+/**
+ * @brief Double the number of rows every column block of a typed read can hold.
+ *
+ * @return TRUE if the storage has been grown, ERROR if it is preallocated or memory ran out.
+ */
+static bool_t growTypedStorage(csvData_t *df, csvRowStorage_t *storage)
+{
+    if(storage->preallocated == TRUE)
+    {
+        return ERROR;
+    }
+
+    int newCapacity = (storage->rowCapacity > 0) ? (storage->rowCapacity * 2) : CSV_INITIAL_ROW_CAPACITY;
+
+    for(int col=0; col<df->cols; col++)
+    {
+        size_t size = typeSize(df->types[col]);
+        void *block = arenaAllocDedicated(df->arena, size * (size_t)newCapacity); //outgrown blocks are given back
+
+        if(block == NULL)
+        {
+            return ERROR;
+        }
+
+        if(storage->typed->columns[col] != NULL)
+        {
+            memcpy(block, storage->typed->columns[col], size * df->rows);
+        }
+
+        arenaRelease(df->arena, storage->typed->columns[col]);
+        storage->typed->columns[col] = block;
+    }
+
+    storage->rowCapacity = newCapacity;
+
+    return TRUE;
+}
+
+/**
+ * @brief Move a column of a typed read to a wider type, converting the rows read so far.
+ *
+ * Preallocated blocks can not be replaced while other threads write into them: the storage is marked
+ * as overflowed instead, and the caller reads the input again without preallocated storage.
+ *
+ * @return TRUE if the column has been widened, ERROR otherwise.
+ */
+static bool_t widenColumn(csvData_t *df, csvRowStorage_t *storage, int col, csvType_t type)
+{
+    csvType_t oldType = df->types[col];
+    void *oldBlock = storage->typed->columns[col];
+
+    if(storage->preallocated == TRUE)
+    {
+        storage->typed->overflowed = TRUE;
+        return ERROR;
+    }
+
+    void *block = arenaAllocDedicated(df->arena, typeSize(type) * (size_t)storage->rowCapacity);
+
+    if(block == NULL)
+    {
+        return ERROR;
+    }
+
+    for(int row=0; row<df->rows; row++)
+    {
+        if(type == CSV_TYPE_FLOAT64)
+        {
+            ((double *)block)[row] = readValue(oldBlock, oldType, (size_t)row);
+        }
+        else
+        {
+            storeInteger(block, type, (size_t)row, readInteger(oldBlock, oldType, (size_t)row));
+        }
+    }
+
+    arenaRelease(df->arena, oldBlock);
+    storage->typed->columns[col] = block;
+    df->types[col] = type;
+
+    return TRUE;
+}
+
+/**
+ * @brief Append an empty row to the column blocks of a typed read.
+ *
+ * @return The row of the column blocks the new row is written to, or -1 on failure.
+ */
+static long appendTypedRow(csvData_t *df, csvRowStorage_t *storage)
+{
+    if(df->rows == storage->rowCapacity && growTypedStorage(df, storage) == ERROR)
+    {
+        fprintf(stderr, "Could not allocate memory for row %d.\n", df->rows);
+        return -1;
+    }
+
+    long row = storage->typed->rowOffset + df->rows;
+
+    for(int col=0; col<df->cols; col++) //missing fields are left as zero, or as the -1 code of no category
+    {
+        if(df->types[col] == CSV_TYPE_CATEGORY)
+        {
+            storeInteger(storage->typed->columns[col], CSV_TYPE_CATEGORY, (size_t)row, -1);
+        }
+        else
+        {
+            memset((char *)storage->typed->columns[col] + typeSize(df->types[col]) * row, 0, typeSize(df->types[col]));
+        }
+    }
+
+    df->rows++;
+
+    return row;
+}
+
+/**
+ * @brief Convert the field [first, last) into the data point at 'row' of a typed column.
+ *
+ * Floats are parsed with parseFloat() and doubles through the C library. Integers that do not fit
+ * their column, or numbers that are not integers, widen the column to the narrowest type that holds
+ * them, so no value is ever truncated. Text is coded through the category table of the column; in a
+ * numeric column it is zero, like atof() would make it.
+ */
+static void storeTypedField(csvData_t *df, csvRowStorage_t *storage, int col, size_t row, const char *first,
+                            const char *last)
+{
+    csvType_t type = df->types[col];
+    void *block = storage->typed->columns[col];
+
+    trimField(&first, &last, df->delim);
+
+    if(type == CSV_TYPE_FLOAT32)
+    {
+        float value = 0.0f;
+
+        if(first < last)
+        {
+            (void)parseFloat(first, last, &value);
+        }
+
+        ((float *)block)[row] = value;
+        return;
+    }
+    else if(first == last)
+    {
+        return; //empty fields keep their zero, or their missing category
+    }
+    else if(type == CSV_TYPE_CATEGORY && memchr(first, '"', (size_t)(last - first)) != NULL) //escaped quotes are coded unescaped
+    {
+        char *copy = (char *)malloc((size_t)(last - first));
+        int code = (copy != NULL) ? lookupCategory(&storage->typed->categories[col], copy, unquoteField(first, last, copy)) : -1;
+
+        storeInteger(block, type, row, code);
+        free(copy);
+        return;
+    }
+    else if(type == CSV_TYPE_CATEGORY)
+    {
+        storeInteger(block, type, row, lookupCategory(&storage->typed->categories[col], first, (size_t)(last - first)));
+        return;
+    }
+    else if(type == CSV_TYPE_FLOAT64)
+    {
+        double value = 0.0;
+        (void)parseDouble(first, last, &value);
+        ((double *)block)[row] = value;
+        return;
+    }
+
+    int64_t integer = 0;
+    double real = 0.0;
+    csvType_t kind = classifyField(first, last, &integer, &real);
+    csvType_t needed = (kind == CSV_TYPE_INT64) ? integerType(integer) : CSV_TYPE_FLOAT64;
+
+    if(kind == CSV_TYPE_CATEGORY)
+    {
+        return;
+    }
+    else if((needed == CSV_TYPE_FLOAT64 || needed > type) && widenColumn(df, storage, col, needed) != TRUE)
+    {
+        return; //preallocated storage is read again, or memory ran out and the value stays zero
+    }
+
+    block = storage->typed->columns[col];
+
+    if(df->types[col] == CSV_TYPE_FLOAT64)
+    {
+        ((double *)block)[row] = (kind == CSV_TYPE_INT64) ? (double)integer : real;
+    }
+    else
+    {
+        storeInteger(block, df->types[col], row, integer);
+    }
+}
+
+/**
+ * @brief Parse every row in the range [begin, end) into new rows of the typed columns of a read.
+ *
+ * This is parseRows() for data frames with column types, every field being converted to the type of
+ * its column.
+ *
+ * @return TRUE once every row has been parsed, ERROR if memory could not be allocated.
+ */
+static bool_t parseTypedRows(csvData_t *df, csvRowStorage_t *storage, const char *begin, const char *end)
+{
+    csvScanner_t scanner;
+    const char *fieldStart = begin;
+    long row = -1;
+    int col = 0;
+
+    initScanner(&scanner, begin, end, df->delim[0]);
+
+    while(fieldStart < end)
+    {
+        const char *fieldEnd = nextStructural(&scanner);
+        bool_t rowEnds = (fieldEnd == end || *fieldEnd == '\n') ? TRUE : FALSE;
+
+        if(row < 0) //first field of a row
+        {
+            if(rowEnds == TRUE && isBlank(fieldStart, fieldEnd))
+            {
+                fieldStart = fieldEnd + 1; //whitespace-only rows do not hold any data points
+                continue;
+            }
+            else if(storage->rowLimit > 0 && df->rows >= storage->rowLimit)
+            {
+                return TRUE; //the rows past the limit are never looked at
+            }
+
+            row = appendTypedRow(df, storage);
+            col = 0;
+
+            if(row < 0)
+            {
+                return ERROR;
+            }
+        }
+
+        int column = columnOfField(df, col);
+
+        if(column >= 0) //skipped fields are never converted
+        {
+            storeTypedField(df, storage, column, (size_t)row, fieldStart, fieldEnd);
+        }
+        col++;
+
+        row = (rowEnds == TRUE) ? -1 : row;
+        fieldStart = fieldEnd + 1;
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Move the column blocks and category tables of a typed read into the data frame.
+ *
+ * Grown column blocks are cut down to the number of rows read and every category table becomes the
+ * dictionary of its column, all in the arena of the data frame.
+ *
+ * @return TRUE on success, ERROR if memory could not be allocated.
+ */
+static bool_t finishTypedColumns(csvData_t *df, csvRowStorage_t *storage)
+{
+    csvTypedStorage_t *typed = storage->typed;
+
+    df->dataFrame = NULL;
+    df->values = NULL;
+    df->columns = (float **)arenaAlloc(df->arena, sizeof(float *) * ((df->cols > 0) ? df->cols : 1), CSV_ARENA_MIN_ALIGNMENT);
+
+    if(df->columns == NULL)
+    {
+        fprintf(stderr, "Could not allocate memory for %d columns.\n", df->cols);
+        df->rows = 0;
+        return ERROR;
+    }
+
+    for(int col=0; col<df->cols; col++)
+    {
+        size_t size = typeSize(df->types[col]);
+        void *block = typed->columns[col];
+
+        if(block == NULL || (storage->preallocated == FALSE && df->rows < storage->rowCapacity))
+        {
+            void *exact = arenaAlloc(df->arena, size * (size_t)((df->rows > 0) ? df->rows : 1), CSV_ALIGNMENT);
+
+            if(exact != NULL && block != NULL) //give back the unused part of the geometric growth
+            {
+                memcpy(exact, block, size * df->rows);
+                arenaRelease(df->arena, block);
+            }
+
+            block = (exact != NULL) ? exact : block;
+        }
+
+        df->columns[col] = (float *)block;
+
+        if(block == NULL)
+        {
+            fprintf(stderr, "Could not allocate memory for column %d.\n", col);
+            df->rows = 0;
+            return ERROR;
+        }
+
+        const csvCategoryTable_t *table = &typed->categories[col];
+        csvDictionary_t *dictionary = &df->dictionaries[col];
+        dictionary->values = (table->count > 0) ? (char **)arenaAlloc(df->arena, sizeof(char *) * table->count, CSV_ARENA_MIN_ALIGNMENT) : NULL;
+        dictionary->count = (dictionary->values != NULL) ? table->count : 0;
+
+        for(int code=0; code<dictionary->count; code++)
+        {
+            size_t length = strlen(table->values[code]);
+            dictionary->values[code] = (char *)arenaAlloc(df->arena, length + 1, 1);
+
+            if(dictionary->values[code] == NULL)
+            {
+                dictionary->count = code; //codes past the last value are unknown
+                return ERROR;
+            }
+
+            memcpy(dictionary->values[code], table->values[code], length + 1);
+        }
+
+        if(dictionary->count < table->count)
+        {
+            return ERROR;
+        }
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Merge the category tables of the chunks of a parallel read, in file order.
+ *
+ * Every chunk codes its categories on its own. The values of each chunk are added to the shared table
+ * in the order of their codes, which gives every value the code of its first appearance in the file,
+ * and the codes written by the chunk are rewritten to the shared ones.
+ *
+ * @return TRUE on success, ERROR if memory could not be allocated.
+ */
+static bool_t mergeCategoryTables(csvData_t *df, csvTypedStorage_t *typed, csvChunk_t *chunks, size_t chunkCount)
+{
+    for(int col=0; col<df->cols; col++)
+    {
+        if(df->types[col] != CSV_TYPE_CATEGORY)
+        {
+            continue;
+        }
+
+        int32_t *codes = (int32_t *)typed->columns[col];
+
+        for(size_t index=0; index<chunkCount; index++)
+        {
+            const csvCategoryTable_t *local = &chunks[index].typed.categories[col];
+            int *remap = (int *)malloc(sizeof(int) * ((local->count > 0) ? local->count : 1));
+
+            if(remap == NULL)
+            {
+                return ERROR;
+            }
+
+            for(int code=0; code<local->count; code++)
+            {
+                remap[code] = lookupCategory(&typed->categories[col], local->values[code], strlen(local->values[code]));
+            }
+
+            for(long row=chunks[index].rowOffset; row<chunks[index].rowOffset + chunks[index].rows; row++)
+            {
+                codes[row] = (codes[row] >= 0) ? remap[codes[row]] : codes[row];
+            }
+
+            free(remap);
+        }
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Get a data point of a data frame as a double, whatever its layout and column types.
+ *
+ * @param df A pointer to the data frame.
+ * @param row The row of the data point, from zero.
+ * @param col The column of the data point, from zero.
+ * @return The data point, or the code of its category for CSV_TYPE_CATEGORY columns.
+ *
+ * @code
+ *   // Example usage:
+ *   double id = getDataPoint(dataFrame, 0, 0); // an 'int64_t' column keeps all of its digits
+ * @endcode
+ */
+double getDataPoint(const csvData_t *df, int row, int col)
+{
+    if(df->types != NULL)
+    {
+        return readValue(df->columns[col], df->types[col], (size_t)row);
+    }
+
+    return (df->layout == CSV_LAYOUT_COLUMNAR) ? df->columns[col][row] : df->dataFrame[row][col];
+}
+
+/**
+ * @brief Get the value of a data point of a CSV_TYPE_CATEGORY column.
+ *
+ * @param df A pointer to the data frame.
+ * @param row The row of the data point, from zero.
+ * @param col The column of the data point, from zero.
+ * @return The null-terminated value, owned by the data frame, or NULL if the field was empty or the
+ *         column is not categorical.
+ */
+const char *getCategory(const csvData_t *df, int row, int col)
+{
+    if(df->types == NULL || df->types[col] != CSV_TYPE_CATEGORY)
+    {
+        return NULL;
+    }
+
+    int32_t code = ((const int32_t *)df->columns[col])[row];
+
+    return (code >= 0 && code < df->dictionaries[col].count) ? df->dictionaries[col].values[code] : NULL;
+}
+
+//ROW FILTERS -----------------------------------------------------------------
+
+/**
+ * @brief Set up the row filter asked for by the loader options.
+ *
+ * The fields handed to the filter are picked by name out of 'filterNames' or, if it is NULL, by
+ * position out of 'filterIndices', among every field of the input: a row can be filtered on a feature
+ * the projection does not load. Without either, every field is handed over in file order.
+ *
+ * @param df A pointer to the data frame, with the feature names and columns of the header row and
+ *           before any projection.
+ * @param options A pointer to the loader options.
+ * @param filter A pointer to the filter to set up.
+ * @return TRUE if rows are filtered, FALSE without a filter, ERROR if a feature does not exist or
+ *         memory could not be allocated.
+ *
+ * @note Every filter set up successfully must be released with closeFilter().
+ */
+static bool_t initFilter(const csvData_t *df, const csvOptions_t *options, csvFilter_t *filter)
+{
+    memset(filter, 0, sizeof(csvFilter_t));
+
+    if(options->filter == NULL)
+    {
+        return FALSE;
+    }
+
+    bool_t everyField = (options->filterNames == NULL && options->filterIndices == NULL) ? TRUE : FALSE;
+
+    filter->test = options->filter;
+    filter->context = options->filterContext;
+    filter->fields = df->cols;
+    filter->tokenCount = (everyField == TRUE) ? df->cols : options->filterCount;
+    filter->fieldTokens = (int *)malloc(sizeof(int) * ((df->cols > 0) ? df->cols : 1));
+
+    if(filter->fieldTokens == NULL)
+    {
+        return ERROR;
+    }
+
+    for(int field=0; field<df->cols; field++)
+    {
+        filter->fieldTokens[field] = (everyField == TRUE) ? field : -1;
+    }
+
+    for(int entry=0; everyField == FALSE && entry<options->filterCount; entry++)
+    {
+        int field = (options->filterNames != NULL) ?
+                    lookupFeatureName(df, options->filterNames[entry], strlen(options->filterNames[entry])) :
+                    options->filterIndices[entry];
+
+        if(field < 0 || field >= df->cols)
+        {
+            if(options->filterNames != NULL)
+            {
+                fprintf(stderr, "Unknown filter column \"%s\".\n", options->filterNames[entry]);
+            }
+            else
+            {
+                fprintf(stderr, "Unknown filter column %d.\n", options->filterIndices[entry]);
+            }
+
+            return ERROR;
+        }
+
+        filter->fieldTokens[field] = entry; //a field asked for twice goes to its last token only
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Release a row filter.
+ */
+static void closeFilter(csvFilter_t *filter)
+{
+    free(filter->fieldTokens);
+    memset(filter, 0, sizeof(csvFilter_t));
+}
+
+/**
+ * @brief Parse the rows in the range [begin, end) that pass a row filter.
+ *
+ * Every row is split into its fields by the structural scanner, and the padded-off fields the filter
+ * asked for are handed to it as tokens straight out of the input. Only the rows it keeps are parsed,
+ * or offered to a sample, so rejected rows are never converted nor stored.
+ *
+ * @param df A pointer to the data frame to append the rows to.
+ * @param storage A pointer to the row storage state of the read, or NULL to only count the rows kept.
+ * @param filter A pointer to the row filter.
+ * @param begin The first character of the rows.
+ * @param end One past the last character of the rows.
+ * @param quoted Set to TRUE if the range ends inside a quoted field, may be NULL.
+ * @param reservoir A pointer to the reservoir sample the kept rows are offered to when 'storage' is
+ *                  NULL, or NULL.
+ * @return The number of rows kept, or -1 if memory could not be allocated.
+ */
+static long filterRows(csvData_t *df, csvRowStorage_t *storage, const csvFilter_t *filter, const char *begin,
+                       const char *end, bool_t *quoted, csvReservoir_t *reservoir)
+{
+    csvToken_t *tokens = (csvToken_t *)malloc(sizeof(csvToken_t) * ((filter->tokenCount > 0) ? filter->tokenCount : 1));
+    csvScanner_t scanner;
+    const char *rowStart = begin, *fieldStart = begin;
+    long kept = 0;
+    int field = 0;
+
+    if(tokens == NULL)
+    {
+        return -1;
+    }
+
+    for(int token=0; token<filter->tokenCount; token++)
+    {
+        tokens[token].text = "";
+        tokens[token].length = 0;
+    }
+
+    initScanner(&scanner, begin, end, df->delim[0]);
+
+    while(fieldStart < end)
+    {
+        const char *fieldEnd = nextStructural(&scanner);
+        bool_t rowEnds = (fieldEnd == end || *fieldEnd == '\n') ? TRUE : FALSE;
+
+        if(field == 0 && rowEnds == TRUE && isBlank(fieldStart, fieldEnd))
+        {
+            rowStart = fieldStart = fieldEnd + 1; //whitespace-only rows do not hold any data points
+            continue;
+        }
+        else if(field == 0 && storage != NULL && storage->rowLimit > 0 && df->rows >= storage->rowLimit)
+        {
+            break; //the rows past the limit are not handed to the filter
+        }
+
+        int token = (field < filter->fields) ? filter->fieldTokens[field] : -1;
+
+        if(token >= 0)
+        {
+            const char *first = fieldStart, *last = fieldEnd;
+
+            trimField(&first, &last, df->delim);
+            tokens[token].text = first;
+            tokens[token].length = (size_t)(last - first);
+        }
+
+        field++;
+        fieldStart = fieldEnd + 1;
+
+        if(rowEnds == FALSE)
+        {
+            continue;
+        }
+
+        const char *rowEnd = (fieldEnd < end) ? fieldEnd + 1 : end;
+
+        if(filter->test(tokens, filter->tokenCount, filter->context) == TRUE)
+        {
+            if((storage != NULL && parseRows(df, storage, rowStart, rowEnd) == ERROR) ||
+               (storage == NULL && reservoir != NULL && offerRow(reservoir, rowStart, rowEnd) == ERROR))
+            {
+                kept = -1;
+                break;
+            }
+
+            kept++;
+        }
+
+        for(int token=0; token<filter->tokenCount; token++) //fields missing from the next row are empty
+        {
+            tokens[token].text = "";
+            tokens[token].length = 0;
+        }
+
+        field = 0;
+        rowStart = rowEnd;
+    }
+
+    if(quoted != NULL)
+    {
+        *quoted = (scanner.quoted != 0) ? TRUE : FALSE;
+    }
+
+    free(tokens);
+
+    return kept;
+}
+
+/**
+ * @brief Parse the rows in the range [begin, end), through a row filter if there is one.
+ *
+ * @return TRUE once every row has been parsed, ERROR if memory could not be allocated.
+ */
+static bool_t parseKeptRows(csvData_t *df, csvRowStorage_t *storage, const csvFilter_t *filter, const char *begin,
+                            const char *end)
+{
+    if(filter == NULL || filter->test == NULL)
+    {
+        return parseRows(df, storage, begin, end);
+    }
+
+    return (filterRows(df, storage, filter, begin, end, NULL, NULL) >= 0) ? TRUE : ERROR;
+}
+
+//ROW SAMPLING ----------------------------------------------------------------
+
+/**
+ * @brief Find the end of the first 'rows' rows of the range [begin, end) that are not blank.
+ *
+ * @param rows The number of rows wanted, set to the number of rows found.
+ * @return A pointer to the first character after the rows found.
+ */
+static const char *findRowsEnd(const char *begin, const char *end, long *rows)
+{
+    const char *row = begin;
+    long found = 0;
+
+    while(row < end && found < *rows)
+    {
+        bool_t quoted = FALSE;
+        const char *rowEnd = findRowEnd(row, end, &quoted);
+        rowEnd = (rowEnd < end) ? rowEnd + 1 : end;
+
+        found += isBlank(row, rowEnd) ? 0 : 1;
+        row = rowEnd;
+    }
+
+    *rows = found;
+
+    return row;
+}
+
+/**
+ * @brief Draw the next number of a splitmix64 random number generator.
+ */
+static uint64_t nextRandom(uint64_t *state)
+{
+    uint64_t value = (*state += 0x9e3779b97f4a7c15ull);
+
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+
+    return value ^ (value >> 31);
+}
+
+/**
+ * @brief Prepare an empty reservoir sample of 'size' rows.
+ *
+ * @param reservoir A pointer to the reservoir to prepare.
+ * @param size The number of rows of the sample.
+ * @param seed The seed of the random number generator.
+ * @param copies TRUE to keep copies of the rows, for inputs whose rows do not stay in memory.
+ * @return TRUE on success, ERROR if memory could not be allocated.
+ *
+ * @note Every reservoir must be released with closeReservoir().
+ */
+static bool_t initReservoir(csvReservoir_t *reservoir, long size, unsigned long seed, bool_t copies)
+{
+    memset(reservoir, 0, sizeof(csvReservoir_t));
+    reservoir->size = size;
+    reservoir->state = (uint64_t)seed;
+    reservoir->copies = copies;
+    reservoir->rows = (csvSampledRow_t *)malloc(sizeof(csvSampledRow_t) * (size_t)((size > 0) ? size : 1));
+
+    return (reservoir->rows != NULL) ? TRUE : ERROR;
+}
+
+/**
+ * @brief Release a reservoir and the copies of its rows.
+ */
+static void closeReservoir(csvReservoir_t *reservoir)
+{
+    for(long row=0; reservoir->copies == TRUE && row<reservoir->count; row++)
+    {
+        free((char *)reservoir->rows[row].begin);
+    }
+
+    free(reservoir->rows);
+    memset(reservoir, 0, sizeof(csvReservoir_t));
+}
+
+/**
+ * @brief Offer the row [begin, end) to a reservoir sample.
+ *
+ * Once the reservoir is full, the n-th row offered replaces a random row of the sample with a
+ * probability of size/n, so every row ends up in the sample with the same probability (Algorithm R).
+ *
+ * @return TRUE on success, ERROR if the row could not be copied.
+ */
+static bool_t offerRow(csvReservoir_t *reservoir, const char *begin, const char *end)
+{
+    uint64_t high = 0, low = 0;
+    long slot = reservoir->count;
+
+    if(reservoir->count == reservoir->size) //a random row of the full sample, or none
+    {
+        multiply64(nextRandom(&reservoir->state), (uint64_t)reservoir->seen + 1, &high, &low);
+        slot = (high < (uint64_t)reservoir->size) ? (long)high : -1;
+    }
+
+    if(slot >= 0)
+    {
+        csvSampledRow_t *sampled = &reservoir->rows[slot];
+        const char *rowBegin = begin;
+
+        if(reservoir->copies == TRUE)
+        {
+            char *copy = (char *)malloc((size_t)(end - begin));
+
+            if(copy == NULL)
+            {
+                return ERROR;
+            }
+
+            memcpy(copy, begin, (size_t)(end - begin));
+            free((slot < reservoir->count) ? (char *)sampled->begin : NULL);
+            rowBegin = copy;
+        }
+
+        sampled->index = reservoir->seen;
+        sampled->begin = rowBegin;
+        sampled->end = rowBegin + (end - begin);
+        reservoir->count += (slot == reservoir->count) ? 1 : 0;
+    }
+
+    reservoir->seen++;
+
+    return TRUE;
+}
+
+/**
+ * @brief Offer every row of the range [begin, end) that is not blank to a reservoir sample.
+ *
+ * With a row filter only the rows it keeps are offered, so the sample is drawn from the rows that
+ * would have been loaded and is as large as the reservoir whenever enough of them are kept. Rows are
+ * only delimited and handed to the filter, never parsed.
+ *
+ * @param filter A pointer to the row filter, or NULL to offer every row.
+ * @return TRUE on success, ERROR if memory could not be allocated.
+ */
+static bool_t offerRows(csvReservoir_t *reservoir, csvData_t *df, const csvFilter_t *filter, const char *begin, const char *end)
+{
+    if(filter != NULL && filter->test != NULL)
+    {
+        return (filterRows(df, NULL, filter, begin, end, NULL, reservoir) >= 0) ? TRUE : ERROR;
+    }
+
+    for(const char *row = begin; row < end; )
+    {
+        bool_t quoted = FALSE;
+        const char *rowEnd = findRowEnd(row, end, &quoted);
+        rowEnd = (rowEnd < end) ? rowEnd + 1 : end;
+
+        if(!isBlank(row, rowEnd) && offerRow(reservoir, row, rowEnd) == ERROR)
+        {
+            return ERROR;
+        }
+
+        row = rowEnd;
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Order two sampled rows by their position in the input, for qsort().
+ */
+static int compareSampledRows(const void *first, const void *second)
+{
+    long a = ((const csvSampledRow_t *)first)->index, b = ((const csvSampledRow_t *)second)->index;
+
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Parse the rows of a reservoir sample, in the order they have in the input.
+ *
+ * The rows have been through the row filter already when they were offered, see offerRows().
+ *
+ * @return TRUE once every sampled row has been parsed, ERROR if memory could not be allocated.
+ */
+static bool_t parseReservoir(csvData_t *df, csvRowStorage_t *storage, csvReservoir_t *reservoir)
+{
+    bool_t status = TRUE;
+
+    qsort(reservoir->rows, (size_t)reservoir->count, sizeof(csvSampledRow_t), compareSampledRows);
+
+    for(long row=0; status == TRUE && row<reservoir->count; row++)
+    {
+        status = parseRows(df, storage, reservoir->rows[row].begin, reservoir->rows[row].end);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Parse the rows found at 'size' evenly spaced byte offsets of the range [begin, end).
+ *
+ * Every offset is moved forward to the start of the next row, so only the pages holding the sampled
+ * rows are ever read from a memory mapped input. Long rows are more likely to be hit than short ones.
+ * The sampled rows go through the row filter afterwards, so a filter leaves fewer than 'size' of them.
+ *
+ * @return TRUE once every sampled row has been parsed, ERROR if memory could not be allocated.
+ */
+static bool_t parseStride(csvData_t *df, csvRowStorage_t *storage, const csvFilter_t *filter, const char *begin,
+                          const char *end, long size)
+{
+    size_t bytes = (size_t)(end - begin);
+    const char *previousEnd = begin;
+    bool_t status = TRUE;
+
+    for(long sample=0; status == TRUE && sample<size; sample++)
+    {
+        const char *row = begin + bytes / (size_t)size * (size_t)sample + bytes % (size_t)size * (size_t)sample / (size_t)size;
+
+        if(row > begin && row[-1] != '\n') //an offset inside a row samples the next one, taken to be outside quotes
+        {
+            row = memchr(row, '\n', (size_t)(end - row));
+            row = (row != NULL) ? row + 1 : end;
+        }
+
+        row = (row > previousEnd) ? row : previousEnd; //rows are sampled once, in order
+
+        long rows = 1;
+        const char *rowEnd = findRowsEnd(row, end, &rows);
+
+        if(rows == 0)
+        {
+            break; //only blank rows are left
+        }
+
+        status = parseKeptRows(df, storage, filter, row, rowEnd);
+        previousEnd = rowEnd;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Parse a sample of the data point rows of an input held in memory, see csvSampling_t.
+ *
+ * @param df A pointer to the data frame to fill, its columns must be known.
+ * @param options A pointer to the loader options, for the sampling mode, size, seed and row limit.
+ * @param filter A pointer to the filter the sampled rows go through, or NULL to keep them all.
+ * @param begin The first character of the data point rows.
+ * @param end One past the last character of the data point rows.
+ * @return TRUE if the data frame has been filled, ERROR if memory could not be allocated.
+ */
+static bool_t parseSampledRange(csvData_t *df, const csvOptions_t *options, const csvFilter_t *filter, const char *begin,
+                                const char *end)
+{
+    csvRowStorage_t storage = {0, NULL, 1, FALSE, NULL, options->limit};
+    csvTypedStorage_t typed;
+    csvReservoir_t reservoir;
+    bool_t status = TRUE;
+
+    if(df->types != NULL)
+    {
+        storage.typed = &typed;
+        status = initTypedStorage(df, &typed);
+    }
+
+    if(status == TRUE && options->sampling == CSV_SAMPLE_STRIDE)
+    {
+        status = parseStride(df, &storage, filter, begin, end, options->sampleSize);
+    }
+    else if(status == TRUE && (status = initReservoir(&reservoir, options->sampleSize, options->sampleSeed, FALSE)) == TRUE)
+    {
+        status = offerRows(&reservoir, df, filter, begin, end);
+        status = (status == TRUE) ? parseReservoir(df, &storage, &reservoir) : status;
+        closeReservoir(&reservoir);
+    }
+
+    status = (finishDataFrame(df, &storage) == TRUE) ? status : ERROR;
+
+    if(storage.typed != NULL)
+    {
+        closeTypedStorage(df, &typed);
+    }
+
+    return (status == TRUE) ? TRUE : ERROR;
+}
+
+//COMPRESSED INPUTS -----------------------------------------------------------
+
+#define CSV_CODEC_SNIFF_BYTES   (4)     // first bytes detectCodec() needs to tell every codec apart
+
+#if CSV_GZIP == 1 || CSV_ZSTD == 1
+/**
+ * @brief Read a little-endian 16-bit integer.
+ */
+static uint32_t readLittle16(const unsigned char *bytes)
+{
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8);
+}
+
+/**
+ * @brief Read a little-endian 32-bit integer.
+ */
+static uint32_t readLittle32(const unsigned char *bytes)
+{
+    return readLittle16(bytes) | (readLittle16(bytes + 2) << 16);
+}
+#endif
+
+/**
+ * @brief Tell the compressed format of an input from its first bytes.
+ *
+ * @return The codec the input is compressed with, CSV_CODEC_NONE for plain text or for a format the
+ *         library has been built without.
+ */
+static csvCodec_t detectCodec(const unsigned char *bytes, size_t size)
+{
+#if CSV_GZIP == 1
+    if(size >= 3 && bytes[0] == 0x1F && bytes[1] == 0x8B && bytes[2] == 8)
+    {
+        return CSV_CODEC_GZIP;
+    }
+#endif
+#if CSV_ZSTD == 1
+    if(size >= 4 && readLittle32(bytes) == ZSTD_MAGICNUMBER)
+    {
+        return CSV_CODEC_ZSTD;
+    }
+#endif
+    (void)bytes;
+    (void)size;
+
+    return CSV_CODEC_NONE;
+}
+
+/**
+ * @brief Start decompressing an input.
+ *
+ * @param decoder A pointer to the decoder to set up.
+ * @param codec The codec the input is compressed with.
+ * @param bytes The first compressed bytes, already read off the input.
+ * @param count The number of bytes in 'bytes'.
+ * @param whole TRUE if 'bytes' is the whole input, which is then decompressed in place, FALSE if the
+ *              rest is read from a descriptor. The bytes are copied in that case.
+ * @return TRUE on success, ERROR if memory could not be allocated.
+ *
+ * @note Every decoder must be released with closeDecoder(), even if this function fails.
+ */
+static bool_t openDecoder(csvDecoder_t *decoder, csvCodec_t codec, const unsigned char *bytes, size_t count, bool_t whole)
+{
+    memset(decoder, 0, sizeof(csvDecoder_t));
+    decoder->codec = codec;
+    decoder->frameEnded = TRUE; //an empty input is a complete one
+    decoder->endOfInput = whole;
+    decoder->inputFilled = count;
+
+    if(whole == TRUE)
+    {
+        decoder->input = (unsigned char *)bytes;
+    }
+    else
+    {
+        decoder->inputCapacity = (count > CSV_READ_BLOCK_SIZE) ? count : CSV_READ_BLOCK_SIZE;
+        decoder->input = (unsigned char *)malloc(decoder->inputCapacity);
+
+        if(decoder->input == NULL)
+        {
+            return ERROR;
+        }
+
+        memcpy(decoder->input, bytes, count);
+    }
+
+#if CSV_GZIP == 1
+    if(codec == CSV_CODEC_GZIP && inflateInit2(&decoder->zlib, 15 + 16) != Z_OK) //15 + 16: a gzip wrapper, the largest window
+    {
+        decoder->codec = CSV_CODEC_NONE;
+        return ERROR;
+    }
+#endif
+#if CSV_ZSTD == 1
+    if(codec == CSV_CODEC_ZSTD && (decoder->zstd = ZSTD_createDStream()) == NULL)
+    {
+        return ERROR;
+    }
+#endif
+
+    return TRUE;
+}
+
+/**
+ * @brief Release a decoder.
+ */
+static void closeDecoder(csvDecoder_t *decoder)
+{
+#if CSV_GZIP == 1
+    if(decoder->codec == CSV_CODEC_GZIP)
+    {
+        inflateEnd(&decoder->zlib);
+    }
+#endif
+#if CSV_ZSTD == 1
+    ZSTD_freeDStream(decoder->zstd);
+#endif
+
+    if(decoder->inputCapacity > 0)
+    {
+        free(decoder->input);
+    }
+
+    memset(decoder, 0, sizeof(csvDecoder_t));
+}
+
+/**
+ * @brief Decompress the next bytes of an input.
+ *
+ * Compressed bytes are read off the descriptor a block at a time whenever the decoder runs out of
+ * them. Members and frames that follow one another are decompressed as one input.
+ *
+ * @param decoder A pointer to the decoder.
+ * @param fd The descriptor the compressed bytes are read from, unused if the decoder holds them all.
+ * @param target Where to decompress to.
+ * @param capacity The number of bytes 'target' has room for.
+ * @return The number of bytes decompressed, zero at the end of the input, or -1 if the input could not
+ *         be read or is corrupt or truncated.
+ */
+static long decodeBlock(csvDecoder_t *decoder, int fd, char *target, size_t capacity)
+{
+    size_t produced = 0;
+
+    while(produced == 0 && capacity > 0)
+    {
+        if(decoder->inputStart == decoder->inputFilled && decoder->endOfInput == FALSE)
+        {
+            ssize_t bytesRead = read(fd, decoder->input, decoder->inputCapacity);
+
+            CSV_STATS_ADD(decoder->stats, reads, 1);
+            CSV_STATS_ADD(decoder->stats, syscalls, 1);
+
+            if(bytesRead < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            else if(bytesRead < 0)
+            {
+                return -1;
+            }
+
+            CSV_STATS_ADD(decoder->stats, bytes, bytesRead);
+            decoder->inputStart = 0;
+            decoder->inputFilled = (size_t)bytesRead;
+            decoder->endOfInput = (bytesRead == 0) ? TRUE : FALSE;
+            continue;
+        }
+
+        if(decoder->inputStart == decoder->inputFilled)
+        {
+            return (decoder->frameEnded == TRUE) ? 0 : -1; //the input ends inside a member or frame
+        }
+
+#if CSV_GZIP == 1
+        if(decoder->codec == CSV_CODEC_GZIP)
+        {
+            if(decoder->frameEnded == TRUE && decoder->zlib.total_in > 0 && inflateReset(&decoder->zlib) != Z_OK)
+            {
+                return -1; //the next member starts where the last one ended
+            }
+
+            decoder->zlib.next_in = decoder->input + decoder->inputStart;
+            decoder->zlib.avail_in = (uInt)((decoder->inputFilled - decoder->inputStart < UINT_MAX) ? decoder->inputFilled - decoder->inputStart : UINT_MAX);
+            decoder->zlib.next_out = (Bytef *)target;
+            decoder->zlib.avail_out = (uInt)((capacity < UINT_MAX) ? capacity : UINT_MAX);
+
+            int result = inflate(&decoder->zlib, Z_NO_FLUSH);
+
+            decoder->inputStart = (size_t)(decoder->zlib.next_in - decoder->input);
+            produced = (size_t)((char *)decoder->zlib.next_out - target);
+            decoder->frameEnded = (result == Z_STREAM_END) ? TRUE : FALSE;
+
+            if(result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR)
+            {
+                return -1;
+            }
+        }
+#endif
+#if CSV_ZSTD == 1
+        if(decoder->codec == CSV_CODEC_ZSTD)
+        {
+            ZSTD_inBuffer source = {decoder->input, decoder->inputFilled, decoder->inputStart};
+            ZSTD_outBuffer destination = {target, capacity, produced};
+            size_t result = ZSTD_decompressStream(decoder->zstd, &destination, &source);
+
+            if(ZSTD_isError(result))
+            {
+                return -1;
+            }
+
+            decoder->inputStart = source.pos;
+            produced = destination.pos;
+            decoder->frameEnded = (result == 0) ? TRUE : FALSE;
+        }
+#endif
+#if CSV_GZIP != 1 && CSV_ZSTD != 1
+        (void)target;
+        return -1; //built without any codec, detectCodec() never opens a decoder
+#endif
+    }
+
+    return (long)produced;
+}
+
+#if CSV_GZIP == 1
+/**
+ * @brief Get the size of a bgzip member from the 'BC' field of its gzip header.
+ *
+ * @return The number of compressed bytes of the member, zero if it is not a bgzip member.
+ */
+static size_t bgzipMemberSize(const unsigned char *member, size_t available)
+{
+    if(available < 18 || member[0] != 0x1F || member[1] != 0x8B || member[2] != 8 || (member[3] & 4) == 0)
+    {
+        return 0; //bgzip members always carry the extra field
+    }
+
+    size_t extraEnd = 12 + readLittle16(member + 10);
+
+    for(size_t field=12; field + 4 <= extraEnd && extraEnd <= available; field += 4 + readLittle16(member + field + 2))
+    {
+        if(member[field] == 'B' && member[field + 1] == 'C' && readLittle16(member + field + 2) == 2 && field + 6 <= extraEnd)
+        {
+            size_t size = (size_t)readLittle16(member + field + 4) + 1;
+            return (size >= extraEnd + 8 && size <= available) ? size : 0; //the deflate data and the trailer follow
+        }
+    }
+
+    return 0;
+}
+#endif
+
+/**
+ * @brief Find the members or frames of a compressed input and the size each one decompresses to.
+ *
+ * Only bgzip members, whose headers give their compressed size, and zstd frames that record their
+ * decompressed size can be found without decompressing the input.
+ *
+ * @param count Set to the number of frames found.
+ * @return An array of 'count' jobs of one frame each, without targets, or NULL if the input can not
+ *         be split into frames or memory could not be allocated.
+ */
+static csvFrameJob_t *findFrames(csvCodec_t codec, const unsigned char *data, size_t size, size_t *count)
+{
+    csvFrameJob_t *frames = NULL;
+    size_t capacity = 0, decodedSize = 0;
+
+    *count = 0;
+
+    for(size_t offset=0; offset<size; )
+    {
+        size_t frameSize = 0, targetSize = 0;
+
+#if CSV_GZIP == 1
+        if(codec == CSV_CODEC_GZIP && (frameSize = bgzipMemberSize(data + offset, size - offset)) > 0)
+        {
+            targetSize = readLittle32(data + offset + frameSize - 4); //ISIZE, never past 64 KiB for bgzip
+        }
+#endif
+#if CSV_ZSTD == 1
+        if(codec == CSV_CODEC_ZSTD)
+        {
+            size_t found = ZSTD_findFrameCompressedSize(data + offset, size - offset);
+            unsigned long long content = (size - offset >= 4 && (readLittle32(data + offset) & 0xFFFFFFF0u) == ZSTD_MAGIC_SKIPPABLE_START) ?
+                                         0 : ZSTD_getFrameContentSize(data + offset, size - offset);
+
+            frameSize = (ZSTD_isError(found) || content == ZSTD_CONTENTSIZE_UNKNOWN || content == ZSTD_CONTENTSIZE_ERROR) ? 0 : found;
+            targetSize = (size_t)content;
+        }
+#endif
+
+        if(frameSize == 0 || targetSize > SIZE_MAX - 1 - decodedSize)
+        {
+            free(frames);
+            return NULL;
+        }
+
+        if(*count == capacity)
+        {
+            size_t grown = (capacity > 0) ? capacity * 2 : 64;
+            csvFrameJob_t *larger = (csvFrameJob_t *)realloc(frames, sizeof(csvFrameJob_t) * grown);
+
+            if(larger == NULL)
+            {
+                free(frames);
+                return NULL;
+            }
+
+            frames = larger;
+            capacity = grown;
+        }
+
+        frames[*count] = (csvFrameJob_t){data + offset, frameSize, NULL, targetSize, codec, TRUE};
+        (*count)++;
+        decodedSize += targetSize;
+        offset += frameSize;
+    }
+
+    return frames;
+}
+
+/**
+ * @brief Decompression task: decompress a run of whole members or frames into their own slice of the output.
+ */
+static void decodeFramesTask(void *arg)
+{
+    csvFrameJob_t *job = (csvFrameJob_t *)arg;
+    csvDecoder_t decoder;
+    size_t produced = 0;
+    long bytes = 0;
+
+    job->status = openDecoder(&decoder, job->codec, job->source, job->sourceSize, TRUE);
+
+    while(job->status == TRUE && (bytes = decodeBlock(&decoder, -1, job->target + produced, job->targetSize - produced)) > 0)
+    {
+        produced += (size_t)bytes;
+    }
+
+    char spare;
+
+    if(job->status == TRUE && (bytes < 0 || produced != job->targetSize || decodeBlock(&decoder, -1, &spare, 1) != 0))
+    {
+        job->status = ERROR; //the frames do not decompress to the size they record
+    }
+
+    closeDecoder(&decoder);
+}
+
+/**
+ * @brief Decompress a compressed input held in memory, replacing it with the decompressed text.
+ *
+ * Inputs whose members or frames can be found up front, bgzip files and zstd files made of frames that
+ * record their size such as seekable ones, are decompressed in parallel: the sizes give the offset of
+ * every frame in the output, allocated once, and runs of frames are decompressed straight into their
+ * slice of it on the thread pool. Any other compressed input is decompressed on the calling thread.
+ *
+ * @param input A pointer to the input, it is released and replaced if it is compressed.
+ * @param threads The number of threads to decompress with, or zero to use one thread per online CPU.
+ * @return TRUE if the input holds plain text, FALSE if it was compressed and has been decompressed,
+ *         ERROR if it is corrupt or memory could not be allocated.
+ */
+static bool_t decompressInput(csvInput_t *input, int threads)
+{
+    const unsigned char *data = (const unsigned char *)input->data;
+    csvCodec_t codec = detectCodec(data, input->size);
+    csvInput_t decoded;
+    size_t frameCount = 0;
+    bool_t status = TRUE;
+
+    if(codec == CSV_CODEC_NONE)
+    {
+        return TRUE;
+    }
+
+    memset(&decoded, 0, sizeof(decoded));
+    threads = resolveThreadCount(threads);
+
+    csvFrameJob_t *frames = (threads > 1) ? findFrames(codec, data, input->size, &frameCount) : NULL;
+
+    if(frames != NULL && frameCount > 1)
+    {
+        size_t jobCount = (size_t)threads * CSV_CHUNKS_PER_THREAD;
+        jobCount = (jobCount < frameCount) ? jobCount : frameCount;
+
+        for(size_t frame=0; frame<frameCount; frame++)
+        {
+            decoded.size += frames[frame].targetSize;
+        }
+
+        csvFrameJob_t *jobs = (csvFrameJob_t *)calloc(jobCount, sizeof(csvFrameJob_t));
+        csvThreadPool_t *pool = (jobs != NULL) ? createThreadPool(threads, (int)jobCount) : NULL;
+
+        decoded.buffer = (pool != NULL) ? (char *)malloc(decoded.size + 1) : NULL;
+        status = (decoded.buffer != NULL) ? TRUE : ERROR;
+
+        for(size_t job=0, frame=0, offset=0; status == TRUE && job<jobCount; job++) //every job takes a run of frames
+        {
+            size_t last = frameCount * (job + 1) / jobCount;
+
+            jobs[job] = (csvFrameJob_t){frames[frame].source, 0, decoded.buffer + offset, 0, codec, TRUE};
+
+            for(; frame<last; frame++)
+            {
+                jobs[job].sourceSize += frames[frame].sourceSize;
+                jobs[job].targetSize += frames[frame].targetSize;
+            }
+
+            offset += jobs[job].targetSize;
+            submitTask(pool, decodeFramesTask, &jobs[job]);
+        }
+
+        if(pool != NULL)
+        {
+            waitThreadPool(pool);
+            destroyThreadPool(pool);
+        }
+
+        for(size_t job=0; status == TRUE && job<jobCount; job++)
+        {
+            status = jobs[job].status;
+        }
+
+        free(jobs);
+    }
+    else
+    {
+        csvDecoder_t decoder;
+        size_t capacity = (input->size < SIZE_MAX / 4) ? input->size * 4 : input->size; //text usually shrinks more than 4 times
+        long bytes = 0;
+
+        status = openDecoder(&decoder, codec, data, input->size, TRUE);
+        capacity = (capacity > CSV_READ_BLOCK_SIZE) ? capacity : CSV_READ_BLOCK_SIZE;
+        decoded.buffer = (status == TRUE) ? (char *)malloc(capacity + 1) : NULL;
+        status = (decoded.buffer != NULL) ? status : ERROR;
+
+        while(status == TRUE && (bytes = decodeBlock(&decoder, -1, decoded.buffer + decoded.size, capacity - decoded.size)) > 0)
+        {
+            decoded.size += (size_t)bytes;
+
+            if(decoded.size == capacity)
+            {
+                char *grown = (capacity < SIZE_MAX / 2 - 1) ? (char *)realloc(decoded.buffer, capacity * 2 + 1) : NULL;
+
+                status = (grown != NULL) ? TRUE : ERROR;
+                decoded.buffer = (grown != NULL) ? grown : decoded.buffer;
+                capacity *= 2;
+            }
+        }
+
+        status = (bytes < 0) ? ERROR : status;
+        closeDecoder(&decoder);
+    }
+
+    free(frames);
+
+    if(status != TRUE)
+    {
+        fprintf(stderr, "Could not decompress the input.\n");
+        free(decoded.buffer);
+        return ERROR;
+    }
+
+    decoded.buffer[decoded.size] = '\0';
+    decoded.data = decoded.buffer;
+    closeInput(input);
+    *input = decoded;
+
+    return FALSE;
+}
+
+//STREAMING LINE READER -------------------------------------------------------
+
+/**
+ * @brief Start reading lines from a file descriptor.
+ *
+ * @param reader A pointer to the line reader to set up.
+ * @param fd The file descriptor to read from, it is not closed by the reader.
+ * @param blockSize The initial size of the read buffer, and so the smallest block read at once.
+ * @return TRUE on success, ERROR if the read buffer could not be allocated.
+ */
+static bool_t initLineReader(csvLineReader_t *reader, int fd, size_t blockSize)
+{
+    memset(reader, 0, sizeof(csvLineReader_t));
+    reader->fd = fd;
+    reader->capacity = (blockSize > 0) ? blockSize : CSV_READ_BLOCK_SIZE;
+    reader->buffer = (char *)malloc(reader->capacity + 1); //one spare byte to terminate the last line
+
+    return (reader->buffer != NULL) ? TRUE : ERROR;
+}
+
+/**
+ * @brief Release the read buffer of a line reader.
+ */
+static void closeLineReader(csvLineReader_t *reader)
+{
+    if(reader->decoder != NULL)
+    {
+        closeDecoder(reader->decoder);
+        free(reader->decoder);
+    }
+
+    free(reader->buffer);
+    memset(reader, 0, sizeof(csvLineReader_t));
+}
+
+/**
+ * @brief Read the next block of the input behind the unconsumed bytes of the read buffer.
+ *
+ * Unconsumed bytes are moved to the front of the buffer first. The buffer only grows, doubling, when
+ * a single line does not fit into it, so it settles at the size of the longest line of the input.
+ * Compressed inputs, told apart by their first bytes, are decompressed as they are read.
+ *
+ * @return TRUE if bytes have been read or the end of the input has been reached, ERROR otherwise.
+ */
+static bool_t fillLineReader(csvLineReader_t *reader)
+{
+    if(reader->start > 0)
+    {
+        memmove(reader->buffer, reader->buffer + reader->start, reader->filled - reader->start);
+        reader->filled -= reader->start;
+        reader->searched -= reader->start;
+        reader->start = 0;
+    }
+
+    if(reader->filled == reader->capacity || (reader->sniffed == FALSE && reader->capacity < CSV_CODEC_SNIFF_BYTES))
+    {
+        //a single line fills the whole buffer, or the buffer can not hold the first bytes of a codec
+        size_t capacity = (reader->capacity * 2 > CSV_CODEC_SNIFF_BYTES) ? reader->capacity * 2 : CSV_CODEC_SNIFF_BYTES;
+        char *grown = (char *)realloc(reader->buffer, capacity + 1);
+
+        if(grown == NULL)
+        {
+            return ERROR;
+        }
+
+        reader->buffer = grown;
+        reader->capacity = capacity;
+    }
+
+    if(reader->decoder != NULL)
+    {
+        uint64_t mark = CSV_STATS_MARK(reader->stats);
+        long bytes = decodeBlock(reader->decoder, reader->fd, reader->buffer + reader->filled, reader->capacity - reader->filled);
+
+        CSV_STATS_PHASE(reader->stats, CSV_PHASE_IO, mark);
+
+        if(bytes < 0)
+        {
+            fprintf(stderr, "Could not decompress the input.\n");
+            return ERROR;
+        }
+
+        reader->filled += (size_t)bytes;
+        reader->endOfInput = (bytes == 0) ? TRUE : FALSE;
+
+        return TRUE;
+    }
+
+    for(;;)
+    {
+        uint64_t mark = CSV_STATS_MARK(reader->stats);
+        ssize_t bytesRead = read(reader->fd, reader->buffer + reader->filled, reader->capacity - reader->filled);
+
+        CSV_STATS_PHASE(reader->stats, CSV_PHASE_IO, mark);
+        CSV_STATS_ADD(reader->stats, reads, 1);
+        CSV_STATS_ADD(reader->stats, syscalls, 1);
+
+        if(bytesRead < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else if(bytesRead < 0)
+        {
+            return ERROR;
+        }
+
+        CSV_STATS_ADD(reader->stats, bytes, bytesRead);
+        reader->filled += (size_t)bytesRead;
+        reader->endOfInput = (bytesRead == 0) ? TRUE : FALSE;
+
+        if(reader->sniffed == FALSE && (reader->filled >= CSV_CODEC_SNIFF_BYTES || reader->endOfInput == TRUE))
+        {
+            csvCodec_t codec = detectCodec((const unsigned char *)reader->buffer, reader->filled);
+
+            reader->sniffed = TRUE;
+
+            if(codec != CSV_CODEC_NONE) //hand the bytes read so far to a decoder and decompress from there on
+            {
+                reader->decoder = (csvDecoder_t *)malloc(sizeof(csvDecoder_t));
+
+                if(reader->decoder == NULL || openDecoder(reader->decoder, codec, (const unsigned char *)reader->buffer, reader->filled, FALSE) != TRUE)
+                {
+                    return ERROR;
+                }
+
+                reader->decoder->stats = reader->stats;
+                reader->decoder->endOfInput = reader->endOfInput;
+                reader->filled = 0;
+                reader->endOfInput = FALSE;
+
+                return fillLineReader(reader);
+            }
+        }
+        else if(reader->sniffed == FALSE)
+        {
+            continue; //too few bytes to tell yet
+        }
+
+        return TRUE;
+    }
+}
+
+/**
+ * @brief Get the next complete lines out of a line reader.
+ *
+ * The returned range points into the read buffer and stays valid until the next call. It ends right
+ * after a newline, except for the last line of an input that does not end with one, and it is always
+ * followed by a terminating '\0'. Lines can be of any length and are never split, not even on a newline
+ * inside a quoted field.
+ *
+ * @param reader A pointer to the line reader.
+ * @param singleLine TRUE to get exactly one line, FALSE to get every complete line in the buffer.
+ * @param begin Set to the first character of the lines.
+ * @param end Set to one past the last character of the lines.
+ * @return TRUE if lines have been returned, FALSE at the end of the input, ERROR if reading failed.
+ */
+static bool_t readLines(csvLineReader_t *reader, bool_t singleLine, char **begin, char **end)
+{
+    if(reader->terminated == TRUE) //put back the byte the terminator of the previous lines covered
+    {
+        reader->buffer[reader->start] = reader->saved;
+        reader->terminated = FALSE;
+    }
+
+    for(;;)
+    {
+        char *lineEnd = NULL;
+        char *pending = reader->buffer + reader->searched; //bytes before 'searched' hold no row end
+        char *filled = reader->buffer + reader->filled;
+        bool_t quoted = reader->quoted;
+
+        if(singleLine == FALSE && quoted == FALSE && memchr(pending, '"', (size_t)(filled - pending)) == NULL)
+        {
+            for(char *character = filled; character > pending; character--) //without quotes the last newline ends a row
+            {
+                if(character[-1] == '\n')
+                {
+                    lineEnd = character - 1;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            for(const char *rowEnd = findRowEnd(pending, filled, &quoted); rowEnd < filled; rowEnd = findRowEnd(rowEnd + 1, filled, &quoted))
+            {
+                lineEnd = (char *)rowEnd;
+
+                if(singleLine == TRUE)
+                {
+                    break;
+                }
+            }
+        }
+
+        if(lineEnd == NULL && reader->endOfInput == TRUE && reader->start < reader->filled)
+        {
+            lineEnd = reader->buffer + reader->filled - 1; //last line without a trailing newline
+            reader->openBytes = isBlank(reader->buffer + reader->start, reader->buffer + reader->filled) ? 0 : reader->filled - reader->start;
+        }
+
+        if(lineEnd != NULL)
+        {
+            *begin = reader->buffer + reader->start;
+            *end = lineEnd + 1;
+            reader->start = reader->searched = (size_t)(*end - reader->buffer);
+            reader->quoted = FALSE;
+            reader->saved = **end;
+            reader->terminated = TRUE;
+            **end = '\0';
+            return TRUE;
+        }
+
+        if(reader->endOfInput == TRUE)
+        {
+            return FALSE;
+        }
+
+        reader->searched = reader->filled;
+        reader->quoted = quoted;
+
+        if(fillLineReader(reader) == ERROR)
+        {
+            return ERROR;
+        }
+    }
+}
+
+/**
+ * @brief Take the feature names, or the number of columns if there are none, off a streamed input.
+ *
+ * @param df A pointer to the data frame to fill.
+ * @param reader A pointer to a line reader positioned at the start of the input.
+ * @param header TRUE if the first row holds the feature names.
+ * @param lines Set to the first character of the data point rows read so far.
+ * @param linesEnd Set to one past the last character of the data point rows read so far.
+ * @return TRUE if there are data point rows, FALSE at the end of the input, ERROR if reading failed.
+ */
+static bool_t parseStreamHeader(csvData_t *df, csvLineReader_t *reader, bool_t header, char **lines, char **linesEnd)
+{
+    bool_t status = readLines(reader, TRUE, lines, linesEnd); //get the first line of csv file
+
+    if(header == TRUE)
+    {
+        reader->openBytes = 0; //the feature names are never parsed again by refreshCsv()
+        extractFeatureNames(df, (status == TRUE) ? *lines : NULL);
+        return (status == TRUE) ? readLines(reader, FALSE, lines, linesEnd) : status;
+    }
+
+    while(status == TRUE && isBlank(*lines, *linesEnd)) //the first data point row gives the column count
+    {
+        status = readLines(reader, TRUE, lines, linesEnd);
+    }
+
+    extractFeatureNames(df, NULL);
+    df->cols = (status == TRUE) ? countFields(*lines, *linesEnd, df->delim[0]) : 0;
+
+    return status;
+}
+
+/**
+ * @brief Parse a whole input into a data frame through a streaming line reader.
+ *
+ * Every complete line of a block is parsed in place. Rows can be of any length: the read buffer grows
+ * when a single row does not fit into it and is reused for the whole input.
+ *
+ * @param df A pointer to the data frame to fill.
+ * @param reader A pointer to a line reader positioned at the start of the input.
+ * @param options A pointer to the loader options, for the header row and the projected columns.
+ * @return TRUE once the input has been read, ERROR if a projected column does not exist or the input could not be read.
+ */
+static bool_t parseStream(csvData_t *df, csvLineReader_t *reader, const csvOptions_t *options)
+{
+    char *lines = NULL, *linesEnd = NULL;
+    csvRowStorage_t storage = {0, NULL, 1, FALSE, NULL, 0};
+
+    //EXTRACT FEATURE NAMES ---------------------------------------------------
+
+    bool_t status = parseStreamHeader(df, reader, options->header, &lines, &linesEnd);
+
+    csvTypedStorage_t typed;
+    csvFilter_t filter;
+
+    if(initFilter(df, options, &filter) == ERROR || projectColumns(df, options) == ERROR ||
+       resolveColumnTypes(df, options, lines, linesEnd) == ERROR)
+    {
+        closeFilter(&filter);
+        return ERROR;
+    }
+
+    if(df->types != NULL)
+    {
+        storage.typed = &typed;
+
+        if(initTypedStorage(df, &typed) == ERROR)
+        {
+            closeTypedStorage(df, &typed);
+            closeFilter(&filter);
+            return ERROR;
+        }
+    }
+
+    //EXTRACT DATA POINTS------------------------------------------------------
+
+    csvReservoir_t reservoir;
+    bool_t sampled = (options->sampling != CSV_SAMPLE_NONE) ? TRUE : FALSE; //a stride needs the input size, streams are reservoir sampled
+    storage.rowLimit = options->limit;
+
+    if(sampled == TRUE && initReservoir(&reservoir, options->sampleSize, options->sampleSeed, TRUE) == ERROR)
+    {
+        status = ERROR;
+    }
+
+    while(status == TRUE && (storage.rowLimit == 0 || df->rows < storage.rowLimit)) //every complete line in the buffer
+    {
+        status = (sampled == TRUE) ? offerRows(&reservoir, df, &filter, lines, linesEnd) : parseKeptRows(df, &storage, &filter, lines, linesEnd);
+        status = (status == TRUE) ? readLines(reader, FALSE, &lines, &linesEnd) : status;
+    }
+
+    if(sampled == TRUE && status != ERROR)
+    {
+        status = parseReservoir(df, &storage, &reservoir);
+    }
+
+    if(sampled == TRUE)
+    {
+        closeReservoir(&reservoir);
+    }
+
+    status = (finishDataFrame(df, &storage) == TRUE) ? status : ERROR;
+    closeFilter(&filter);
+
+    if(storage.typed != NULL)
+    {
+        closeTypedStorage(df, &typed);
+    }
+
+    return (status == ERROR) ? ERROR : TRUE; //a read error, such as a truncated compressed input, fails the load
+}
+
+/**
+ * @brief Load data from a '.csv' file into a CSV data frame.
+ *
+ * This function loads the '.csv' file pointed to by 'filePtr', or the file at CSV_PATH if 'filePtr'
+ * is NULL, into a CSV data frame. It extracts feature names from the first row and stores
+ * them in the data frame's 'params' member. Data points are read and stored in the 'dataFrame'
+ * member of the data frame.
+ *
+ * This is loadCsvEx() with the default options of initCsvOptions(): the file is read in a single
+ * pass, the number of columns is taken from the feature names row and the row storage is grown
+ * geometrically while the data points are being read. Rows can be of any length.
+ *
+ * A seekable file is read through its descriptor from the position of the stream, so bytes the stream
+ * has buffered or consumed already are neither lost nor read twice. Pipes and other streams that can
+ * not be positioned are read to their end through stdio and parsed from memory.
+ *
+ * @param filePtr A pointer to an open '.csv' file, read from its current position, or NULL to load
+ *                CSV_PATH. The file is left open, positioned at its end.
+ * @return A pointer to a dynamically allocated 'csvData_t' structure representing the loaded data frame,
+ *         or NULL if the file could not be opened or memory could not be allocated.
+ *
+ * @note The caller is responsible for freeing the returned data frame with csvFree() when it is no
+ *       longer needed. All of its memory lives in one arena, so rows must never be freed one by one.
+ *
+ * @code
+ *   // Example usage:
+ *   FILE *file = NULL;
+ *   csvData_t *dataFrame = loadCsv(file);
+ *   if (dataFrame != NULL)
+ *   {
+ *       // Use the loaded data frame...
+ *       // Don't forget to free the allocated memory when done.
+ *       csvFree(dataFrame);
+ *   }
+ *   else
+ *   {
+ *       puts("Error occurred while loading the '.csv' file.");
+ *   }
+ *   // Load data from a '.csv' file into a CSV data frame...
+ * @endcode
+ */
+csvData_t *loadCsv(FILE *filePtr)
+{
+    csvOptions_t options;
+    csvInput_t input;
+
+    initCsvOptions(&options);
+
+    if(filePtr == NULL)
+    {
+        return loadCsvEx(&options);
+    }
+
+    long position = ftell(filePtr);
+
+    if(position >= 0 && fflush(filePtr) == 0 && lseek(fileno(filePtr), (off_t)position, SEEK_SET) == (off_t)position)
+    {
+        options.fd = fileno(filePtr);
+        csvData_t *df = loadCsvEx(&options);
+        (void)fseek(filePtr, 0, SEEK_END); //read to its end through the descriptor, the buffer of the stream is stale
+
+        return df;
+    }
+
+    if(readStream(filePtr, &input) == ERROR)
+    {
+        fprintf(stderr, "Could not read the file.\n");
+        return NULL;
+    }
+
+    options.buffer = input.data;
+    options.bufferSize = input.size;
+    csvData_t *df = loadCsvEx(&options);
+    closeInput(&input);
+
+    return df;
+}
+
+/**
+ * @brief Map the rest of an open regular file, from the current position of its descriptor on.
+ *
+ * @param fd The file descriptor to map, it can be closed as soon as this function returns.
+ * @param input A pointer to the input description to fill.
+ * @param stats A pointer to the load statistics to add the system calls to, or NULL.
+ * @return TRUE if the input has been mapped, FALSE if it can not be, such as for pipes or empty files.
+ *
+ * @note Every input mapped successfully must be released with closeInput().
+ */
+static bool_t mapInput(int fd, csvInput_t *input, csvLoadStats_t *stats)
+{
+    struct stat fileStat;
+    off_t offset = lseek(fd, 0, SEEK_CUR);
+
+    memset(input, 0, sizeof(csvInput_t));
+    CSV_STATS_ADD(stats, syscalls, (offset < 0) ? 1 : 2);
+
+    if(offset < 0 || fstat(fd, &fileStat) != 0 || ! S_ISREG(fileStat.st_mode) || fileStat.st_size <= offset)
+    {
+        return FALSE;
+    }
+
+    void *mapping = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    CSV_STATS_ADD(stats, syscalls, 1);
+
+    if(mapping == MAP_FAILED)
+    {
+        return FALSE;
+    }
+
+    (void)posix_madvise(mapping, (size_t)fileStat.st_size, POSIX_MADV_SEQUENTIAL);
+    CSV_STATS_ADD(stats, syscalls, 1);
+    input->mapping = mapping;
+    input->mappingSize = (size_t)fileStat.st_size;
+    input->data = (const char *)mapping + offset;
+    input->size = (size_t)(fileStat.st_size - offset);
+
+    return TRUE;
+}
+
+/**
+ * @brief Open a '.csv' file as a single contiguous range of bytes.
+ *
+ * Regular files are memory mapped read-only and advised for sequential access, so the parser works
+ * straight out of the page cache. Pipes, character devices and any file that can not be mapped are
+ * read with plain read() calls into a heap buffer instead.
+ *
+ * @param path The path of the '.csv' file to open.
+ * @param input A pointer to the input description to fill.
+ * @return TRUE if the input is ready to be parsed, ERROR otherwise.
+ *
+ * @note Every input opened successfully must be released with closeInput().
+ */
+static bool_t openInput(const char *path, csvInput_t *input)
+{
+    int fd = open(path, O_RDONLY);
+
+    if(fd < 0)
+    {
+        memset(input, 0, sizeof(csvInput_t));
+        return ERROR;
+    }
+
+    if(mapInput(fd, input, NULL) == TRUE)
+    {
+        close(fd);
+        return TRUE;
+    }
+
+    size_t capacity = CSV_READ_BLOCK_SIZE; //fall back to reading the whole input in large blocks
+    input->buffer = (char *)malloc(capacity + 1);
+
+    while(input->buffer != NULL)
+    {
+        ssize_t bytesRead = read(fd, input->buffer + input->size, capacity - input->size);
+
+        if(bytesRead == 0)
+        {
+            break;
+        }
+        else if(bytesRead < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            free(input->buffer);
+            input->buffer = NULL;
+            break;
+        }
+
+        input->size += (size_t)bytesRead;
+
+        if(input->size == capacity)
+        {
+            char *grown = (char *)realloc(input->buffer, capacity * 2 + 1);
+
+            if(grown == NULL)
+            {
+                free(input->buffer);
+            }
+            input->buffer = grown;
+            capacity *= 2;
+        }
+    }
+
+    close(fd);
+
+    if(input->buffer == NULL)
+    {
+        return ERROR;
+    }
+
+    input->buffer[input->size] = '\0';
+    input->data = input->buffer;
+
+    return TRUE;
+}
+
+/**
+ * @brief Read the rest of a stdio stream into a heap buffer, for streams that can not be positioned.
+ *
+ * @param file The stream to read from its current position on, whatever it has buffered included.
+ * @param input A pointer to the input description to fill.
+ * @return TRUE if the input is ready to be parsed, ERROR otherwise.
+ *
+ * @note Every input read successfully must be released with closeInput().
+ */
+static bool_t readStream(FILE *file, csvInput_t *input)
+{
+    size_t capacity = CSV_READ_BLOCK_SIZE;
+
+    memset(input, 0, sizeof(csvInput_t));
+    input->buffer = (char *)malloc(capacity + 1);
+
+    while(input->buffer != NULL)
+    {
+        input->size += fread(input->buffer + input->size, 1, capacity - input->size, file);
+
+        if(input->size < capacity)
+        {
+            break;
+        }
+
+        char *grown = (char *)realloc(input->buffer, capacity * 2 + 1);
+
+        if(grown == NULL)
+        {
+            free(input->buffer);
+        }
+        input->buffer = grown;
+        capacity *= 2;
+    }
+
+    if(input->buffer == NULL || ferror(file))
+    {
+        free(input->buffer);
+        memset(input, 0, sizeof(csvInput_t));
+        return ERROR;
+    }
+
+    input->buffer[input->size] = '\0';
+    input->data = input->buffer;
+
+    return TRUE;
+}
+
+/**
+ * @brief Release an input opened with openInput().
+ *
+ * @param input A pointer to the input to release.
+ */
+static void closeInput(csvInput_t *input)
+{
+    if(input->mapping != NULL)
+    {
+        munmap(input->mapping, input->mappingSize);
+    }
+
+    free(input->buffer);
+    memset(input, 0, sizeof(csvInput_t));
+}
+
+/**
+ * @brief Extract the feature names from the first row of an input held in memory.
+ *
+ * @param df A pointer to the data frame to fill.
+ * @param begin The first character of the input.
+ * @param end One past the last character of the input.
+ * @return A pointer to the first character of the data point rows, or NULL if memory could not be
+ *         allocated.
+ */
+static const char *parseHeader(csvData_t *df, const char *begin, const char *end)
+{
+    if(begin >= end)
+    {
+        extractFeatureNames(df, NULL);
+        return end;
+    }
+
+    bool_t quoted = FALSE;
+    const char *lineEnd = findRowEnd(begin, end, &quoted);
+
+    char *header = (char *)malloc((size_t)(lineEnd - begin) + 1); //names are split in a writable copy
+
+    if(header == NULL)
+    {
+        fprintf(stderr, "Could not allocate memory for the header.\n");
+        return NULL;
+    }
+
+    memcpy(header, begin, (size_t)(lineEnd - begin));
+    header[lineEnd - begin] = '\0';
+
+    extractFeatureNames(df, header);
+    free(header);
+
+    return (lineEnd < end) ? lineEnd + 1 : end;
+}
+
+/**
+ * @brief Take the feature names, or the number of columns if there are none, off an input held in memory.
+ *
+ * @param df A pointer to the data frame to fill.
+ * @param begin The first character of the input.
+ * @param end One past the last character of the input.
+ * @param header TRUE if the first row holds the feature names.
+ * @return A pointer to the first character of the data point rows, or NULL if memory could not be
+ *         allocated.
+ */
+static const char *parseRangeHeader(csvData_t *df, const char *begin, const char *end, bool_t header)
+{
+    if(header == TRUE)
+    {
+        return parseHeader(df, begin, end);
+    }
+
+    extractFeatureNames(df, NULL);
+    df->cols = countFields(begin, end, df->delim[0]);
+
+    return begin;
+}
+
+/**
+ * @brief Load data from a '.csv' file into a CSV data frame through a memory mapping.
+ *
+ * This function fills the same 'csvData_t' as loadCsv(), loading the file at 'path' with the default
+ * options of loadCsvEx(): the file is mapped and the data points are parsed directly out of the mapped
+ * region. Inputs that can not be mapped, such as pipes, are read with plain read() calls in large
+ * blocks instead. Rows that only hold whitespace are skipped.
+ *
+ * @param path The path of the '.csv' file to load, or NULL to load CSV_PATH.
+ * @return A pointer to a dynamically allocated 'csvData_t' structure representing the loaded data frame,
+ *         or NULL if the file could not be opened or memory could not be allocated.
+ *
+ * @note The returned data frame must be freed with csvFree().
+ *
+ * @code
+ *   // Example usage:
+ *   csvData_t *dataFrame = loadCsvMmap("data.csv");
+ *   if (dataFrame != NULL)
+ *   {
+ *       // Use the loaded data frame...
+ *   }
+ *   else
+ *   {
+ *       puts("Error occurred while loading the '.csv' file.");
+ *   }
+ * @endcode
+ */
+csvData_t *loadCsvMmap(const char *path)
+{
+    csvOptions_t options;
+
+    initCsvOptions(&options);
+    options.path = path;
+
+    return loadCsvEx(&options);
+}
+
+/**
+ * @brief Release the data point storage of a data frame, whatever its layout.
+ *
+ * Large blocks go back to the allocator right away. The separate rows of 'CSV_LAYOUT_ROWS' are
+ * small arena blocks that are only released by csvFree().
+ *
+ * @param df A pointer to the data frame whose data points will be released.
+ */
+static void releaseDataPoints(csvData_t *df)
+{
+    arenaRelease(df->arena, df->dataFrame); //the contiguous block starts at the row pointers...
+    arenaRelease(df->arena, df->columns);   //...and the columnar block at the column pointers, rows stay in the arena
+
+    df->dataFrame = NULL;
+    df->columns = NULL;
+    df->values = NULL;
+}
+
+/**
+ * @brief Convert a data frame between the row-major and column-major layouts.
+ *
+ * This function copies the data points of 'df' into freshly allocated storage of the requested
+ * layout and releases the old storage. The copy is done in square tiles so that both the rows being
+ * read and the columns being written stay in cache, instead of striding across the whole data
+ * frame for every element.
+ *
+ * @param df A pointer to the data frame to convert.
+ * @param layout The layout the data frame should have once the function returns.
+ * @return TRUE if the data frame now has the requested layout, ERROR if memory could not be allocated
+ *         or the data frame has typed columns, which only come in the columnar layout, in which case
+ *         the data frame is left untouched.
+ *
+ * @code
+ *   // Example usage:
+ *   csvData_t *dataFrame = loadCsvMmap("data.csv");
+ *   if (dataFrame != NULL && transposeDataFrame(dataFrame, CSV_LAYOUT_COLUMNAR) == TRUE)
+ *   {
+ *       float *firstFeature = dataFrame->columns[0]; // 'rows' consecutive values
+ *   }
+ * @endcode
+ */
+bool_t transposeDataFrame(csvData_t *df, csvLayout_t layout)
+{
+    enum {TILE = 16};
+    float **newRows = NULL, **newColumns = NULL, *newValues = NULL;
+
+    if(df->layout == layout)
+    {
+        return TRUE;
+    }
+    else if(df->types != NULL)
+    {
+        return ERROR;
+    }
+
+    if(layout == CSV_LAYOUT_COLUMNAR)
+    {
+        size_t stride = columnStride(df->rows);
+        newColumns = allocPointerBlock(df->arena, (size_t)df->cols, stride * df->cols, &newValues);
+
+        if(newColumns == NULL)
+        {
+            return ERROR;
+        }
+
+        for(int col=0; col<df->cols; col++)
+        {
+            newColumns[col] = newValues + (size_t)col * stride;
+        }
+    }
+    else if(layout == CSV_LAYOUT_CONTIGUOUS)
+    {
+        newRows = allocPointerBlock(df->arena, (size_t)df->rows, (size_t)df->rows * df->cols, &newValues);
+
+        if(newRows == NULL)
+        {
+            return ERROR;
+        }
+
+        for(int row=0; row<df->rows; row++)
+        {
+            newRows[row] = newValues + (size_t)row * df->cols;
+        }
+    }
+    else
+    {
+        newRows = (float **)arenaAlloc(df->arena, sizeof(float *) * ((df->rows > 0) ? df->rows : 1), CSV_ARENA_MIN_ALIGNMENT);
+
+        for(int row=0; newRows != NULL && row<df->rows; row++)
+        {
+            newRows[row] = (float *)arenaAlloc(df->arena, sizeof(float) * ((df->cols > 0) ? df->cols : 1), CSV_ARENA_MIN_ALIGNMENT);
+
+            if(newRows[row] == NULL)
+            {
+                arenaRelease(df->arena, newRows);
+                newRows = NULL;
+            }
+        }
+
+        if(newRows == NULL)
+        {
+            return ERROR;
+        }
+    }
+
+    if(df->layout == CSV_LAYOUT_COLUMNAR || layout == CSV_LAYOUT_COLUMNAR)
+    {
+        for(int rowTile=0; rowTile<df->rows; rowTile+=TILE) //transpose one tile at a time
+        {
+            int rowEnd = (rowTile + TILE < df->rows) ? rowTile + TILE : df->rows;
+
+            for(int colTile=0; colTile<df->cols; colTile+=TILE)
+            {
+                int colEnd = (colTile + TILE < df->cols) ? colTile + TILE : df->cols;
+
+                for(int row=rowTile; row<rowEnd; row++)
+                {
+                    for(int col=colTile; col<colEnd; col++)
+                    {
+                        if(layout == CSV_LAYOUT_COLUMNAR)
+                        {
+                            newColumns[col][row] = df->dataFrame[row][col];
+                        }
+                        else
+                        {
+                            newRows[row][col] = df->columns[col][row];
+                        }
+                    }
+                }
+            }
+        }
+    }
+    else //only the row storage changes, every row is copied as a whole
+    {
+        for(int row=0; row<df->rows; row++)
+        {
+            memcpy(newRows[row], df->dataFrame[row], sizeof(float) * df->cols);
+        }
+    }
+
+    releaseDataPoints(df);
+
+    df->layout = layout;
+    df->dataFrame = newRows;
+    df->columns = newColumns;
+    df->values = (layout == CSV_LAYOUT_ROWS) ? NULL : newValues;
+    df->rowCapacity = (layout == CSV_LAYOUT_COLUMNAR) ? (int)columnStride(df->rows) : df->rows;
+
+    return TRUE;
+}
+
+//PARALLEL LOADING ------------------------------------------------------------
+
+/**
+ * @brief Body of a worker thread: run tasks from the queue until the pool is destroyed.
+ */
+static void *threadPoolWorker(void *arg)
+{
+    csvThreadPool_t *pool = (csvThreadPool_t *)arg;
+
+    pthread_mutex_lock(&pool->lock);
+
+    for(;;)
+    {
+        while(pool->taskHead == pool->taskTail && pool->stopping == FALSE)
+        {
+            pthread_cond_wait(&pool->taskReady, &pool->lock);
+        }
+
+        if(pool->taskHead == pool->taskTail) //stopping and nothing left to run
+        {
+            break;
+        }
+
+        csvTask_t task = pool->tasks[pool->taskHead++];
+        pthread_mutex_unlock(&pool->lock);
+
+        task.run(task.arg);
+
+        pthread_mutex_lock(&pool->lock);
+        if(--pool->pending == 0)
+        {
+            pthread_cond_broadcast(&pool->tasksDone);
+        }
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+/**
+ * @brief Start a pool of worker threads.
+ *
+ * @param threads The number of workers. With a single worker no thread is started and tasks run on
+ *                the calling thread as they are submitted.
+ * @param maxTasks The largest number of tasks submitted between two calls to waitThreadPool().
+ * @return A pointer to the pool, or NULL on failure.
+ */
+static csvThreadPool_t *createThreadPool(int threads, int maxTasks)
+{
+    csvThreadPool_t *pool = (csvThreadPool_t *)calloc(1, sizeof(csvThreadPool_t));
+
+    if(pool == NULL)
+    {
+        return NULL;
+    }
+
+    pool->tasks = (csvTask_t *)malloc(sizeof(csvTask_t) * ((maxTasks > 0) ? maxTasks : 1));
+    pool->workers = (pthread_t *)malloc(sizeof(pthread_t) * ((threads > 1) ? threads : 1));
+
+    if(pool->tasks == NULL || pool->workers == NULL)
+    {
+        free(pool->tasks);
+        free(pool->workers);
+        free(pool);
+        return NULL;
+    }
+
+    pool->taskCapacity = (maxTasks > 0) ? maxTasks : 1;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->taskReady, NULL);
+    pthread_cond_init(&pool->tasksDone, NULL);
+
+    for(int worker=0; threads > 1 && worker<threads; worker++)
+    {
+        if(pthread_create(&pool->workers[worker], NULL, threadPoolWorker, pool) != 0)
+        {
+            break; //run with the workers that could be started
+        }
+        pool->workerCount++;
+    }
+
+    return pool;
+}
+
+/**
+ * @brief Queue a task on the pool, or run it right away if the pool has no workers.
+ */
+static void submitTask(csvThreadPool_t *pool, void (*run)(void *arg), void *arg)
+{
+    if(pool->workerCount == 0 || pool->taskTail == pool->taskCapacity)
+    {
+        run(arg);
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->tasks[pool->taskTail].run = run;
+    pool->tasks[pool->taskTail].arg = arg;
+    pool->taskTail++;
+    pool->pending++;
+    pthread_cond_signal(&pool->taskReady);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief Wait until every submitted task has finished, then reset the task queue.
+ */
+static void waitThreadPool(csvThreadPool_t *pool)
+{
+    pthread_mutex_lock(&pool->lock);
+
+    while(pool->pending > 0)
+    {
+        pthread_cond_wait(&pool->tasksDone, &pool->lock);
+    }
+
+    pool->taskHead = pool->taskTail = 0;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief Stop the workers of a pool and release it.
+ */
+static void destroyThreadPool(csvThreadPool_t *pool)
+{
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = TRUE;
+    pthread_cond_broadcast(&pool->taskReady);
+    pthread_mutex_unlock(&pool->lock);
+
+    for(int worker=0; worker<pool->workerCount; worker++)
+    {
+        pthread_join(pool->workers[worker], NULL);
+    }
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->taskReady);
+    pthread_cond_destroy(&pool->tasksDone);
+    free(pool->workers);
+    free(pool->tasks);
+    free(pool);
+}
+
+/**
+ * @brief Resolve a requested thread count, where zero or less means one thread per online CPU.
+ */
+static int resolveThreadCount(int threads)
+{
+    if(threads > 0)
+    {
+        return threads;
+    }
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return (cpus > 0) ? (int)cpus : 1;
+}
+
+/**
+ * @brief First phase task: count the rows of a chunk.
+ */
+static void countChunkTask(void *arg)
+{
+    csvChunk_t *chunk = (csvChunk_t *)arg;
+
+    if(chunk->filter != NULL) //only the rows the filter keeps are stored
+    {
+        long rows = filterRows(chunk->df, NULL, chunk->filter, chunk->begin, chunk->end, &chunk->quoted, NULL);
+        chunk->rows = (rows > 0) ? rows : 0;
+        return;
+    }
+
+    chunk->rows = countRows(chunk->begin, chunk->end, chunk->df->delim[0], &chunk->quoted);
+}
+
+/**
+ * @brief Second phase task: parse the rows of a chunk straight into its slice of the data frame.
+ *
+ * The chunk works on a copy of the data frame whose row storage starts at the first row of the chunk
+ * and holds exactly the rows counted in the first phase.
+ */
+static void parseChunkTask(void *arg)
+{
+    csvChunk_t *chunk = (csvChunk_t *)arg;
+    csvData_t slice = *chunk->df;
+    csvRowStorage_t storage = {(int)chunk->rows, NULL, 1, TRUE, NULL, 0};
+
+    slice.rows = 0;
+
+    if(slice.types != NULL) //typed columns are shared, category tables belong to the chunk
+    {
+        storage.typed = &chunk->typed;
+        storage.typed->rowOffset = chunk->rowOffset;
+    }
+    else if(slice.layout == CSV_LAYOUT_COLUMNAR)
+    {
+        storage.values = slice.values + chunk->rowOffset;
+        storage.stride = columnStride(chunk->df->rows);
+    }
+    else if(slice.layout == CSV_LAYOUT_CONTIGUOUS)
+    {
+        storage.values = slice.values + (size_t)chunk->rowOffset * slice.cols;
+    }
+    else
+    {
+        slice.dataFrame = chunk->df->dataFrame + chunk->rowOffset;
+    }
+
+    chunk->status = parseKeptRows(&slice, &storage, chunk->filter, chunk->begin, chunk->end);
+    chunk->status = (chunk->status == TRUE && slice.rows != chunk->rows) ? ERROR : chunk->status;
+}
+
+/**
+ * @brief Allocate the final storage of a data frame whose row count is known up front.
+ *
+ * @return TRUE on success, ERROR if memory could not be allocated.
+ */
+static bool_t allocDataPoints(csvData_t *df)
+{
+    if(df->layout == CSV_LAYOUT_CONTIGUOUS)
+    {
+        df->dataFrame = allocPointerBlock(df->arena, (size_t)df->rows, (size_t)df->rows * df->cols, &df->values);
+
+        for(int row=0; df->dataFrame != NULL && row<df->rows; row++)
+        {
+            df->dataFrame[row] = df->values + (size_t)row * df->cols;
+        }
+
+        return (df->dataFrame != NULL) ? TRUE : ERROR;
+    }
+    else if(df->layout == CSV_LAYOUT_COLUMNAR)
+    {
+        size_t stride = columnStride(df->rows);
+        df->columns = allocPointerBlock(df->arena, (size_t)df->cols, stride * df->cols, &df->values);
+
+        for(int col=0; df->columns != NULL && col<df->cols; col++)
+        {
+            df->columns[col] = df->values + (size_t)col * stride;
+        }
+
+        return (df->columns != NULL) ? TRUE : ERROR;
+    }
+
+    float *values = NULL; //rows are separate but laid out in one block, so chunks need not allocate
+    df->dataFrame = allocPointerBlock(df->arena, (size_t)df->rows, (size_t)df->rows * df->cols, &values);
+
+    for(int row=0; df->dataFrame != NULL && row<df->rows; row++)
+    {
+        df->dataFrame[row] = values + (size_t)row * df->cols;
+    }
+
+    return (df->dataFrame != NULL) ? TRUE : ERROR;
+}
+
+/**
+ * @brief Get the number of chunks the ranges of rows of a parallel parse are cut into.
+ *
+ * @param ranges The data point rows of every input.
+ * @param rangeCount The number of ranges.
+ * @param threads The number of threads the chunks go to.
+ * @param targetChunks Set to the number of chunks aimed at over every range.
+ * @param dataBytes Set to the number of bytes of every range.
+ * @return The number of chunks, at least one per range, or zero if the ranges are too small to be split.
+ */
+static size_t planChunks(const csvRange_t *ranges, size_t rangeCount, int threads, size_t *targetChunks, size_t *dataBytes)
+{
+    size_t chunkCount = 0;
+
+    *dataBytes = 0;
+
+    for(size_t range=0; range<rangeCount; range++)
+    {
+        *dataBytes += (size_t)(ranges[range].end - ranges[range].begin);
+    }
+
+    *targetChunks = (size_t)threads * CSV_CHUNKS_PER_THREAD; //more chunks than threads evens out the load
+    *targetChunks = (*dataBytes / *targetChunks < CSV_MIN_CHUNK_SIZE) ? *dataBytes / CSV_MIN_CHUNK_SIZE : *targetChunks;
+
+    for(size_t range=0; range<rangeCount && *targetChunks > 1; range++) //every range gets its share of the chunks
+    {
+        size_t share = (size_t)((double)(ranges[range].end - ranges[range].begin) * *targetChunks / *dataBytes + 0.5);
+        chunkCount += (share > 1) ? share : 1;
+    }
+
+    return chunkCount;
+}
+
+/**
+ * @brief Cut the ranges of rows into the chunks planned by planChunks() and count the rows of every chunk.
+ *
+ * Boundaries are placed on the first newline past an even split, then moved on to the end of the row
+ * for the chunks the count found to end inside a quoted field, see parseRanges().
+ *
+ * @param filter A pointer to the filter the counts go through, or NULL to count every row.
+ * @param chunks The 'chunkCount' zero-initialized chunks to fill.
+ * @param pool A pointer to the thread pool the rows are counted on.
+ */
+static void splitChunks(csvData_t *df, const csvRange_t *ranges, size_t rangeCount, size_t targetChunks, size_t dataBytes,
+                        const csvFilter_t *filter, csvChunk_t *chunks, size_t chunkCount, csvThreadPool_t *pool)
+{
+    for(size_t range=0, index=0; range<rangeCount; range++) //chunk boundaries are moved forward onto the next newline
+    {
+        const char *begin = ranges[range].begin, *end = ranges[range].end;
+        size_t rangeBytes = (size_t)(end - begin);
+        size_t share = (size_t)((double)rangeBytes * targetChunks / dataBytes + 0.5);
+
+        share = (share > 1) ? share : 1;
+
+        for(size_t part=0; part<share; part++, index++)
+        {
+            const char *chunkBegin = (part == 0) ? begin : chunks[index - 1].end;
+            const char *chunkEnd = (part + 1 == share) ? end : begin + rangeBytes / share * (part + 1);
+            chunkEnd = (chunkEnd > chunkBegin) ? chunkEnd : chunkBegin;
+
+            if(chunkEnd < end && part + 1 < share)
+            {
+                const char *newline = memchr(chunkEnd, '\n', (size_t)(end - chunkEnd));
+                chunkEnd = (newline != NULL) ? newline + 1 : end;
+            }
+
+            chunks[index].df = df;
+            chunks[index].filter = filter;
+            chunks[index].begin = chunkBegin;
+            chunks[index].end = chunkEnd;
+            chunks[index].rangeEnd = end;
+            submitTask(pool, countChunkTask, &chunks[index]);
+        }
+    }
+
+    waitThreadPool(pool);
+
+    for(size_t index=0; index + 1<chunkCount; index++) //a chunk ending inside quotes ends on a newline of a quoted field
+    {
+        const char *end = chunks[index].rangeEnd;
+
+        if(chunks[index].quoted == FALSE || chunks[index].end == end)
+        {
+            continue;
+        }
+
+        bool_t quoted = TRUE;
+        const char *rowEnd = findRowEnd(chunks[index].end, end, &quoted);
+        const char *boundary = (rowEnd < end) ? rowEnd + 1 : end;
+
+        chunks[index].end = boundary; //the row the boundary fell into goes to this chunk
+        countChunkTask(&chunks[index]);
+
+        for(size_t next=index + 1; next<chunkCount && chunks[next].rangeEnd == end && chunks[next].begin < boundary; next++)
+        {
+            chunks[next].begin = boundary; //the next chunks of the range start after it
+            chunks[next].end = (chunks[next].end > boundary) ? chunks[next].end : boundary;
+            countChunkTask(&chunks[next]);
+        }
+    }
+}
+
+/**
+ * @brief Parse the data point rows of one or more inputs held in memory, on one or more threads.
+ *
+ * The rows of the ranges are appended in order, as if they were a single input. On a single thread
+ * they are appended to geometrically grown storage. On several threads every range is cut into chunks
+ * ending on newline boundaries, as many per range as its share of the bytes, and the chunks of every
+ * range go to the same thread pool, so that small ranges are parsed alongside the chunks of large
+ * ones. In a first pass the worker threads count the rows of every chunk off the newline masks of the
+ * structural scanner; a prefix sum over those counts gives the first row of each chunk, the final
+ * storage is allocated once, and in a second pass every chunk is parsed straight into its own slice of
+ * it. Rows therefore come out in order, whatever the number of threads, and nothing is copied after
+ * parsing.
+ *
+ * Chunk boundaries are placed on the first newline past an even split, as if it were outside quotes.
+ * The first pass tells whether every chunk really ended outside a quoted field; a chunk that did not
+ * ends on a newline of a quoted field, so its boundary is moved on to the end of that row and only
+ * the chunks on both sides of it are counted again. Chunks never reach past the end of their range.
+ *
+ * @param df A pointer to the data frame to fill, its columns must be known.
+ * @param ranges The data point rows of every input, in the order they are loaded in.
+ * @param rangeCount The number of ranges.
+ * @param threads The number of threads to parse with, or zero to use one thread per online CPU.
+ * @param filter A pointer to the filter deciding which rows are loaded, or NULL to load every row. The
+ *               first pass then counts the rows the filter keeps.
+ * @param limit The number of rows the parse stops at, zero to parse every row. With a filter, the
+ *              rows are then parsed on a single thread.
+ * @param stats A pointer to the load statistics to add the time of the scan, parse and finish phases
+ *              to, or NULL.
+ * @return TRUE if the data frame has been filled, ERROR if the parse ran out of memory.
+ */
+static bool_t parseRanges(csvData_t *df, const csvRange_t *ranges, size_t rangeCount, int threads, const csvFilter_t *filter,
+                          long limit, csvLoadStats_t *stats)
+{
+    csvRowStorage_t storage = {0, NULL, 1, FALSE, NULL, limit};
+    csvTypedStorage_t typed;
+    uint64_t mark = CSV_STATS_MARK(stats);
+
+    if(df->types != NULL)
+    {
+        storage.typed = &typed;
+
+        if(initTypedStorage(df, &typed) == ERROR)
+        {
+            closeTypedStorage(df, &typed);
+            return ERROR;
+        }
+    }
+
+    threads = (filter != NULL && limit > 0) ? 1 : resolveThreadCount(threads); //kept rows are only known once filtered
+
+    size_t dataBytes = 0, targetChunks = 0;
+    size_t chunkCount = planChunks(ranges, rangeCount, threads, &targetChunks, &dataBytes);
+
+    if(threads == 1 || chunkCount <= 1)
+    {
+        bool_t status = TRUE;
+
+        for(size_t range=0; status == TRUE && range<rangeCount; range++)
+        {
+            status = parseKeptRows(df, &storage, filter, ranges[range].begin, ranges[range].end);
+        }
+
+        CSV_STATS_PHASE(stats, CSV_PHASE_PARSE, mark);
+        status = (finishDataFrame(df, &storage) == TRUE) ? status : ERROR; //the storage is given back either way
+        CSV_STATS_PHASE(stats, CSV_PHASE_FINISH, mark);
+
+        if(storage.typed != NULL)
+        {
+            closeTypedStorage(df, &typed);
+        }
+
+        return status;
+    }
+
+    csvChunk_t *chunks = (csvChunk_t *)calloc(chunkCount, sizeof(csvChunk_t));
+    csvThreadPool_t *pool = (chunks != NULL) ? createThreadPool(threads, (int)chunkCount) : NULL;
+
+    if(pool == NULL)
+    {
+        free(chunks);
+
+        if(storage.typed != NULL)
+        {
+            closeTypedStorage(df, &typed);
+        }
+
+        return ERROR;
+    }
+
+    splitChunks(df, ranges, rangeCount, targetChunks, dataBytes, filter, chunks, chunkCount, pool);
+
+    long totalRows = 0;
+
+    CSV_STATS_PHASE(stats, CSV_PHASE_SCAN, mark);
+
+    for(size_t index=0; index<chunkCount; index++) //prefix sum of the row counts
+    {
+        chunks[index].rowOffset = totalRows;
+        totalRows += chunks[index].rows;
+    }
+
+    df->rows = (int)totalRows;
+    bool_t status = (totalRows > INT32_MAX) ? ERROR : TRUE;
+    bool_t overflowed = FALSE;
+
+    status = (status == TRUE) ? ((storage.typed != NULL) ? allocTypedColumns(df, &storage, df->rows) : allocDataPoints(df)) : status;
+
+    for(size_t index=0; status == TRUE && storage.typed != NULL && index<chunkCount; index++)
+    {
+        status = initTypedStorage(df, &chunks[index].typed);
+
+        if(status == TRUE)
+        {
+            memcpy(chunks[index].typed.columns, typed.columns, sizeof(void *) * df->cols);
+        }
+    }
+
+    for(size_t index=0; status == TRUE && index<chunkCount; index++)
+    {
+        submitTask(pool, parseChunkTask, &chunks[index]);
+    }
+
+    waitThreadPool(pool);
+    CSV_STATS_PHASE(stats, CSV_PHASE_PARSE, mark);
+
+    for(size_t index=0; status == TRUE && index<chunkCount; index++)
+    {
+        status = (chunks[index].status == TRUE) ? TRUE : ERROR;
+        overflowed = (chunks[index].typed.overflowed == TRUE) ? TRUE : overflowed;
+    }
+
+    if(status == TRUE && storage.typed != NULL && overflowed == FALSE)
+    {
+        status = mergeCategoryTables(df, &typed, chunks, chunkCount);
+    }
+
+    for(size_t index=0; storage.typed != NULL && index<chunkCount; index++)
+    {
+        closeTypedStorage(df, &chunks[index].typed);
+    }
+
+    destroyThreadPool(pool);
+    free(chunks);
+
+    if(status == TRUE && overflowed == TRUE) //a sampled type was too narrow, read again on one thread to widen it
+    {
+        for(int col=0; col<df->cols; col++)
+        {
+            arenaRelease(df->arena, typed.columns[col]);
+        }
+
+        closeTypedStorage(df, &typed);
+        df->rows = 0;
+        CSV_STATS_PHASE(stats, CSV_PHASE_FINISH, mark);
+
+        return parseRanges(df, ranges, rangeCount, 1, filter, limit, stats);
+    }
+
+    if(status != TRUE)
+    {
+        fprintf(stderr, "Could not load the data points of %ld rows.\n", totalRows);
+
+        if(storage.typed != NULL)
+        {
+            closeTypedStorage(df, &typed);
+        }
+
+        return ERROR;
+    }
+
+    storage.preallocated = TRUE;
+    status = finishDataFrame(df, &storage);
+    CSV_STATS_PHASE(stats, CSV_PHASE_FINISH, mark);
+
+    if(storage.typed != NULL)
+    {
+        closeTypedStorage(df, &typed);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Parse the data point rows of an input held in memory, on one or more threads.
+ *
+ * This is parseRanges() on the single range [begin, end).
+ */
+static bool_t parseRange(csvData_t *df, const char *begin, const char *end, int threads, const csvFilter_t *filter,
+                         long limit, csvLoadStats_t *stats)
+{
+    csvRange_t range = {begin, end};
+
+    return parseRanges(df, &range, 1, threads, filter, limit, stats);
+}
+
+/**
+ * @brief Load data from a '.csv' file into a CSV data frame on several threads.
+ *
+ * This is loadCsvEx() on the file at 'path' with the given thread count, see parseRanges() for how
+ * the work is split between the threads.
+ *
+ * @param path The path of the '.csv' file to load, or NULL to load CSV_PATH.
+ * @param threads The number of threads to parse with, or zero to use one thread per online CPU.
+ * @return A pointer to a dynamically allocated 'csvData_t' structure representing the loaded data frame,
+ *         or NULL if the file could not be opened or memory could not be allocated.
+ *
+ * @note The returned data frame must be freed with csvFree().
+ *
+ * @code
+ *   // Example usage:
+ *   csvData_t *dataFrame = loadCsvParallel("data.csv", 0); // one thread per CPU
+ *   if (dataFrame != NULL)
+ *   {
+ *       // Use the loaded data frame...
+ *   }
+ * @endcode
+ */
+csvData_t *loadCsvParallel(const char *path, int threads)
+{
+    csvOptions_t options;
+
+    initCsvOptions(&options);
+    options.path = path;
+    options.threads = threads;
+
+    return loadCsvEx(&options);
+}
+
+/**
+ * @brief Tell whether the header row of an input matches the feature names of a data frame.
+ *
+ * @return TRUE if the input has the same feature names, or the same number of fields without a header
+ *         row, FALSE if it does not, ERROR if memory could not be allocated.
+ */
+static bool_t matchRangeHeader(const csvData_t *df, const char *begin, const char *end, bool_t header, const char **rows)
+{
+    csvData_t *other = newDataFrame(df->delim, df->layout, NULL);
+
+    if(other == NULL)
+    {
+        return ERROR;
+    }
+
+    *rows = parseRangeHeader(other, begin, end, header);
+    bool_t match = (*rows == NULL) ? ERROR : (other->cols == df->cols) ? TRUE : FALSE;
+
+    for(int col=0; match == TRUE && df->names != NULL && other->names != NULL && col<df->cols; col++)
+    {
+        match = (strcmp(df->names[col], other->names[col]) == 0) ? TRUE : FALSE;
+    }
+
+    csvFree(other);
+
+    return match;
+}
+
+/**
+ * @brief Load a dataset sharded across several '.csv' files into a single CSV data frame.
+ *
+ * Every file is memory mapped, or read into memory if it can not be, and must have the same header
+ * row as the first one; files without a header row must have as many fields on their first row. The
+ * rows of every file are then concatenated in the order of 'paths': all the files are cut into chunks
+ * that go to one thread pool, whose threads take the next chunk as soon as they are done with one, so
+ * that the chunks of a large file are parsed alongside small files. The row counts of the first pass
+ * give the row every chunk starts at, and each is parsed straight into its slice of the storage of the
+ * data frame, which is allocated once, see parseRanges(). Empty files are passed over.
+ *
+ * The options work as for loadCsvEx(), the first file taking the place of 'path': the deliminator,
+ * header setting, layout, allocator, thread count, projection, column types and row filter apply to
+ * every file. Column types are inferred from the first rows of the largest file. 'fd', 'buffer',
+ * 'cache', 'limit', 'sampling' and 'stats' are not used.
+ *
+ * @param paths The paths of the '.csv' files to load.
+ * @param count The number of files.
+ * @param options A pointer to the loader options, or NULL to use the defaults of initCsvOptions().
+ * @return A pointer to a dynamically allocated 'csvData_t' structure holding the rows of every file, or
+ *         NULL if a file could not be opened, the headers do not match or memory could not be allocated.
+ *
+ * @note The returned data frame must be freed with csvFree().
+ *
+ * @code
+ *   // Example usage:
+ *   const char *shards[] = {"part-0.csv", "part-1.csv", "part-2.csv"};
+ *   csvOptions_t options;
+ *   initCsvOptions(&options);
+ *   options.threads = 0; // one thread per CPU
+ *   csvData_t *dataFrame = loadCsvDataset(shards, 3, &options);
+ * @endcode
+ */
+csvData_t *loadCsvDataset(const char *const *paths, int count, const csvOptions_t *options)
+{
+    csvOptions_t defaults;
+
+    if(options == NULL)
+    {
+        initCsvOptions(&defaults);
+        options = &defaults;
+    }
+
+    if(paths == NULL || count <= 0)
+    {
+        return NULL;
+    }
+
+    const char *delim = (options->delim != NULL && options->delim[0] != '\0') ? options->delim : CSV_DELIM;
+    csvData_t *df = newDataFrame(delim, options->layout, options->allocator);
+    csvInput_t *inputs = (csvInput_t *)calloc((size_t)count, sizeof(csvInput_t));
+    csvRange_t *ranges = (csvRange_t *)malloc(sizeof(csvRange_t) * (size_t)count);
+    bool_t status = (df != NULL && inputs != NULL && ranges != NULL) ? TRUE : ERROR;
+    int opened = 0, first = -1, largest = -1;
+
+    for(; status == TRUE && opened<count; opened++)
+    {
+        status = (paths[opened] != NULL) ? openInput(paths[opened], &inputs[opened]) : ERROR;
+
+        if(status == TRUE && decompressInput(&inputs[opened], options->threads) == ERROR)
+        {
+            closeInput(&inputs[opened]); //opened but corrupt, the cleanup below only closes the inputs before it
+            status = ERROR;
+        }
+
+        if(status != TRUE)
+        {
+            fprintf(stderr, "Could not open the file %s.\n", (paths[opened] != NULL) ? paths[opened] : "(null)");
+            break;
+        }
+
+        const char *begin = inputs[opened].data, *end = inputs[opened].data + inputs[opened].size;
+        ranges[opened].end = end;
+
+        if(isBlank(begin, end))
+        {
+            ranges[opened].begin = end; //empty files hold no rows, and no header to match
+        }
+        else if(first < 0) //the feature names come from the first file that is not empty
+        {
+            ranges[opened].begin = parseRangeHeader(df, begin, end, options->header);
+            first = opened;
+
+            if(ranges[opened].begin == NULL)
+            {
+                status = ERROR;
+                opened++;
+                break;
+            }
+        }
+        else if((status = matchRangeHeader(df, begin, end, options->header, &ranges[opened].begin)) != TRUE)
+        {
+            fprintf(stderr, "The header of %s does not match the header of %s.\n", paths[opened], paths[first]);
+            status = ERROR;
+            opened++;
+            break;
+        }
+
+        if(largest < 0 || ranges[opened].end - ranges[opened].begin > ranges[largest].end - ranges[largest].begin)
+        {
+            largest = opened; //the most rows to infer column types from
+        }
+    }
+
+    csvFilter_t filter;
+
+    memset(&filter, 0, sizeof(filter));
+
+    if(status == TRUE)
+    {
+        status = (initFilter(df, options, &filter) != ERROR) ? projectColumns(df, options) : ERROR;
+        status = (status == TRUE && largest >= 0) ? resolveColumnTypes(df, options, ranges[largest].begin, ranges[largest].end) : status;
+    }
+
+    if(status == TRUE)
+    {
+        status = parseRanges(df, ranges, (size_t)count, options->threads, (filter.test != NULL) ? &filter : NULL, 0, NULL);
+    }
+
+    closeFilter(&filter);
+
+    for(int input=0; input<opened; input++)
+    {
+        closeInput(&inputs[input]);
+    }
+
+    free(inputs);
+    free(ranges);
+
+    if(status != TRUE && df != NULL)
+    {
+        csvFree(df);
+        df = NULL;
+    }
+
+    return df;
+}
+
+//BINARY CACHE ----------------------------------------------------------------
+
+#define CSV_CACHE_MAGIC         ("OCSVBIN")
+#define CSV_CACHE_VERSION       (3)
+#define CSV_CACHE_BYTE_ORDER    (0x01020304u)
+#define CSV_CACHE_HASH_BYTES    (1 << 16)
+
+/**
+ * @brief Hash a range of bytes with 64-bit FNV-1a, continuing from 'hash'.
+ */
+static uint64_t hashBytes(uint64_t hash, const unsigned char *bytes, size_t count)
+{
+    for(size_t index=0; index<count; index++)
+    {
+        hash = (hash ^ bytes[index]) * 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Describe the '.csv' file a cache belongs to: its size, modification time and a sampled hash.
+ *
+ * Only the first and last 'CSV_CACHE_HASH_BYTES' bytes are hashed, next to the size and modification
+ * time, so that checking a cache costs the same whatever the size of the file.
+ *
+ * @param fd A descriptor of the '.csv' file, its position is left unchanged.
+ * @param identity A pointer to the cache header whose 'source' fields are filled.
+ * @return TRUE if the file is a regular file that can be cached, FALSE otherwise.
+ */
+static bool_t identifySource(int fd, csvCacheHeader_t *identity)
+{
+    struct stat fileStat;
+    unsigned char sample[4096];
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    if(fstat(fd, &fileStat) != 0 || ! S_ISREG(fileStat.st_mode))
+    {
+        return FALSE;
+    }
+
+    off_t size = fileStat.st_size;
+    off_t ranges[2][2] = {{0, (size < CSV_CACHE_HASH_BYTES) ? size : CSV_CACHE_HASH_BYTES},
+                          {(size > 2 * CSV_CACHE_HASH_BYTES) ? size - CSV_CACHE_HASH_BYTES : size, size}};
+
+    for(int range=0; range<2; range++)
+    {
+        for(off_t offset = ranges[range][0]; offset < ranges[range][1]; )
+        {
+            size_t wanted = (size_t)(ranges[range][1] - offset);
+            ssize_t bytesRead = pread(fd, sample, (wanted < sizeof(sample)) ? wanted : sizeof(sample), offset);
+
+            if(bytesRead <= 0)
+            {
+                return FALSE;
+            }
+
+            hash = hashBytes(hash, sample, (size_t)bytesRead);
+            offset += bytesRead;
+        }
+    }
+
+    identity->sourceSize = (int64_t)size;
+    identity->sourceMtimeSec = (int64_t)fileStat.st_mtim.tv_sec;
+    identity->sourceMtimeNsec = (int64_t)fileStat.st_mtim.tv_nsec;
+    identity->sourceHash = hash;
+
+    return TRUE;
+}
+
+/**
+ * @brief Get the path of the cache of a '.csv' file, to be freed by the caller.
+ */
+static char *cachePathOf(const csvOptions_t *options, const char *path)
+{
+    const char *base = (options->cachePath != NULL) ? options->cachePath : path;
+    const char *suffix = (options->cachePath != NULL) ? "" : CSV_CACHE_SUFFIX;
+    char *cachePath = (char *)malloc(strlen(base) + strlen(suffix) + 1);
+
+    if(cachePath != NULL)
+    {
+        strcpy(cachePath, base);
+        strcat(cachePath, suffix);
+    }
+
+    return cachePath;
+}
+
+/**
+ * @brief Load a data frame from its binary cache, if the cache is valid for the '.csv' file.
+ *
+ * The cache is memory mapped, and for the row layouts the data points are used straight out of the
+ * mapping: only the row pointers and the feature names are allocated, so the load does no parsing and
+ * no copy. The columnar layout is filled from the mapping in one pass. The mapping belongs to the
+ * arena of the data frame and is released by csvFree().
+ *
+ * @param cachePath The path of the cache file.
+ * @param identity The header fields the '.csv' file has now, see identifySource().
+ * @param df A pointer to a new data frame to fill.
+ * @return TRUE if the data frame has been loaded, FALSE if the cache is missing, stale or invalid.
+ */
+static bool_t loadCacheFile(const char *cachePath, const csvCacheHeader_t *identity, csvData_t *df)
+{
+    struct stat fileStat;
+    int fd = open(cachePath, O_RDONLY);
+
+    if(fd < 0)
+    {
+        return FALSE;
+    }
+
+    if(fstat(fd, &fileStat) != 0 || (size_t)fileStat.st_size < sizeof(csvCacheHeader_t))
+    {
+        close(fd);
+        return FALSE;
+    }
+
+    void *mapping = mmap(NULL, (size_t)fileStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if(mapping == MAP_FAILED)
+    {
+        return FALSE;
+    }
+
+    const csvCacheHeader_t *header = (const csvCacheHeader_t *)mapping;
+    uint64_t valueBytes = (uint64_t)header->rows * (uint64_t)header->cols * sizeof(float);
+
+    if(memcmp(header->magic, CSV_CACHE_MAGIC, sizeof(CSV_CACHE_MAGIC)) != 0 || header->version != CSV_CACHE_VERSION ||
+       header->byteOrder != CSV_CACHE_BYTE_ORDER || header->sourceSize != identity->sourceSize ||
+       header->sourceMtimeSec != identity->sourceMtimeSec || header->sourceMtimeNsec != identity->sourceMtimeNsec ||
+       header->sourceHash != identity->sourceHash || header->header != identity->header ||
+       strncmp(header->delim, identity->delim, sizeof(header->delim)) != 0 || header->rows < 0 || header->cols < 0 ||
+       header->rows > INT32_MAX || header->cols > INT32_MAX || header->valuesOffset % CSV_ALIGNMENT != 0 ||
+       header->valuesOffset < sizeof(csvCacheHeader_t) + header->namesLength ||
+       header->valuesOffset + valueBytes > (uint64_t)fileStat.st_size || header->openBytes > (uint64_t)header->sourceSize)
+    {
+        munmap(mapping, (size_t)fileStat.st_size);
+        return FALSE;
+    }
+
+    float *values = (float *)((char *)mapping + header->valuesOffset);
+    csvRowStorage_t storage = {(int)header->rows, NULL, 1, TRUE, NULL, 0};
+
+    const char *names = (const char *)mapping + sizeof(csvCacheHeader_t);
+    char *block = (char *)arenaAlloc(df->arena, header->namesLength + 1, 1);
+    int64_t nameCount = 0;
+
+    for(uint64_t index=0; index<header->namesLength; index++)
+    {
+        nameCount += (names[index] == '\0') ? 1 : 0;
+    }
+
+    if(block == NULL || (header->namesLength > 0 && (nameCount != header->cols || names[header->namesLength - 1] != '\0')))
+    {
+        munmap(mapping, (size_t)fileStat.st_size); //every feature name has to be there, terminated
+        return FALSE;
+    }
+
+    memcpy(block, names, header->namesLength);
+    block[header->namesLength] = '\0';
+
+    df->rows = (int)header->rows;
+    df->cols = (int)header->cols;
+    df->fields = df->cols;
+    df->params = block;
+    df->sourceOffset = header->sourceSize - (int64_t)header->openBytes; //a last row with no newline is parsed again on refresh
+    df->openRows = (header->openBytes > 0) ? 1 : 0;
+    df->dataFrame = (df->layout != CSV_LAYOUT_COLUMNAR) ?
+                    (float **)arenaAlloc(df->arena, sizeof(float *) * ((df->rows > 0) ? df->rows : 1), CSV_ARENA_MIN_ALIGNMENT) :
+                    allocPointerBlock(df->arena, (size_t)df->cols, columnStride(df->rows) * df->cols, &df->values);
+
+    if(df->dataFrame == NULL || (header->namesLength > 0 && indexFeatureNames(df, block) != TRUE))
+    {
+        munmap(mapping, (size_t)fileStat.st_size);
+        return FALSE;
+    }
+
+    if(df->layout == CSV_LAYOUT_COLUMNAR) //the cache is row-major, columns are gathered in one pass
+    {
+        df->columns = df->dataFrame;
+        df->dataFrame = NULL;
+
+        for(int col=0; col<df->cols; col++)
+        {
+            df->columns[col] = df->values + (size_t)col * columnStride(df->rows);
+        }
+
+        for(int row=0; row<df->rows; row++)
+        {
+            for(int col=0; col<df->cols; col++)
+            {
+                df->columns[col][row] = values[(size_t)row * df->cols + col];
+            }
+        }
+
+        munmap(mapping, (size_t)fileStat.st_size);
+    }
+    else
+    {
+        for(int row=0; row<df->rows; row++) //rows point straight into the copy-on-write mapping
+        {
+            df->dataFrame[row] = values + (size_t)row * df->cols;
+        }
+
+        df->values = (df->layout == CSV_LAYOUT_CONTIGUOUS) ? values : NULL;
+        df->arena->mapping = mapping;
+        df->arena->mappingSize = (size_t)fileStat.st_size;
+    }
+
+    return finishDataFrame(df, &storage);
+}
+
+/**
+ * @brief Write all of 'count' bytes to a file descriptor.
+ */
+static bool_t writeAll(int fd, const void *bytes, size_t count)
+{
+    while(count > 0)
+    {
+        ssize_t written = write(fd, bytes, count);
+
+        if(written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else if(written <= 0)
+        {
+            return ERROR;
+        }
+
+        bytes = (const char *)bytes + written;
+        count -= (size_t)written;
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Write the binary cache of a freshly parsed data frame.
+ *
+ * The cache holds a 'csvCacheHeader_t', the feature names and the data points as one row-major array
+ * starting on a 'CSV_ALIGNMENT' boundary. It is written to a temporary file first and renamed over
+ * the old cache once complete, so a reader never maps a half written cache.
+ *
+ * @param cachePath The path of the cache file.
+ * @param identity The header fields describing the '.csv' file, see identifySource().
+ * @param df A pointer to the data frame to write.
+ * @return TRUE if the cache has been written, ERROR otherwise.
+ */
+static bool_t writeCacheFile(const char *cachePath, const csvCacheHeader_t *identity, const csvData_t *df)
+{
+    csvCacheHeader_t header = *identity;
+    char *tempPath = (char *)malloc(strlen(cachePath) + sizeof(".tmp"));
+    float *staging = (float *)malloc(CSV_READ_BLOCK_SIZE);
+    size_t stagingCount = CSV_READ_BLOCK_SIZE / sizeof(float), staged = 0;
+    static const char padding[CSV_ALIGNMENT] = {0};
+
+    if(tempPath == NULL || staging == NULL)
+    {
+        free(tempPath);
+        free(staging);
+        return ERROR;
+    }
+
+    strcpy(tempPath, cachePath);
+    strcat(tempPath, ".tmp");
+
+    memcpy(header.magic, CSV_CACHE_MAGIC, sizeof(CSV_CACHE_MAGIC));
+    header.version = CSV_CACHE_VERSION;
+    header.byteOrder = CSV_CACHE_BYTE_ORDER;
+    header.rows = df->rows;
+    header.cols = df->cols;
+    header.openBytes = (df->sourceOffset >= 0) ? (uint32_t)(identity->sourceSize - df->sourceOffset) : 0;
+    header.namesLength = 0;
+
+    for(int col=0; df->names != NULL && col<df->cols; col++)
+    {
+        header.namesLength += strlen(df->names[col]) + 1;
+    }
+
+    header.valuesOffset = (sizeof(header) + header.namesLength + CSV_ALIGNMENT - 1) / CSV_ALIGNMENT * CSV_ALIGNMENT;
+
+    int fd = open(tempPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    bool_t status = (fd >= 0) ? TRUE : ERROR;
+
+    status = (status == TRUE) ? writeAll(fd, &header, sizeof(header)) : status;
+    for(int col=0; status == TRUE && df->names != NULL && col<df->cols; col++)
+    {
+        status = writeAll(fd, df->names[col], strlen(df->names[col]) + 1);
+    }
+
+    status = (status == TRUE) ? writeAll(fd, padding, header.valuesOffset - sizeof(header) - header.namesLength) : status;
+
+    if(status == TRUE && df->layout == CSV_LAYOUT_CONTIGUOUS)
+    {
+        status = writeAll(fd, df->values, sizeof(float) * (size_t)df->rows * df->cols);
+    }
+    else
+    {
+        for(int row=0; status == TRUE && row<df->rows; row++) //gathered into row-major blocks
+        {
+            for(int col=0; col<df->cols; col++)
+            {
+                staging[staged++] = (df->layout == CSV_LAYOUT_COLUMNAR) ? df->columns[col][row] : df->dataFrame[row][col];
+
+                if(staged == stagingCount)
+                {
+                    status = writeAll(fd, staging, sizeof(float) * staged);
+                    staged = 0;
+                }
+            }
+        }
+
+        status = (status == TRUE) ? writeAll(fd, staging, sizeof(float) * staged) : status;
+    }
+
+    if(fd >= 0 && close(fd) != 0)
+    {
+        status = ERROR;
+    }
+
+    if(status == TRUE && rename(tempPath, cachePath) != 0)
+    {
+        status = ERROR;
+    }
+
+    if(status != TRUE)
+    {
+        unlink(tempPath);
+    }
+
+    free(tempPath);
+    free(staging);
+
+    return status;
+}
+
+//LOADER OPTIONS --------------------------------------------------------------
+
+/**
+ * @brief Fill a set of loader options with the defaults.
+ *
+ * The defaults load CSV_PATH with the CSV_DELIM deliminator and the CSV_LAYOUT layout on a single
+ * thread, taking the feature names from the first row, which is exactly what loadCsv() does. The
+ * binary cache is used if 'CSV_CACHE' is turned on.
+ *
+ * @param options A pointer to the options to fill.
+ */
+void initCsvOptions(csvOptions_t *options)
+{
+    memset(options, 0, sizeof(csvOptions_t));
+    options->path = CSV_PATH;
+    options->fd = -1;
+    options->delim = CSV_DELIM;
+    options->header = TRUE;
+    options->threads = 1;
+    options->layout = CSV_LAYOUT;
+    options->readBlockSize = CSV_READ_BLOCK_SIZE;
+    options->cache = (CSV_CACHE == 1) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Load '.csv' data from a file, a file descriptor or memory into a CSV data frame.
+ *
+ * The input is taken from 'buffer' if it is set, from 'fd' if it is not negative and from 'path'
+ * otherwise. Inputs held in memory and regular files, which are memory mapped, are parsed in place
+ * and can be parsed on several threads. Other inputs, such as pipes, are streamed through a read
+ * buffer of 'readBlockSize' bytes that grows only when a single row does not fit into it. A file
+ * descriptor is read from its current position and is left open.
+ *
+ * Without a header row the feature names are left empty and the number of columns is taken from the
+ * first row of data points.
+ *
+ * With 'cache' set, a file loaded from 'path' is first looked up in its binary cache, by default the
+ * file named 'path' followed by CSV_CACHE_SUFFIX. A cache whose recorded size, modification time and
+ * sampled hash of the '.csv' file still match, and that was parsed with the same deliminator and
+ * header setting, is memory mapped instead of parsing the file. Otherwise the file is parsed and the
+ * cache is written for the next load.
+ *
+ * With 'columnNames' or 'columnIndices' set, only the listed features are loaded, as columns in the order
+ * they are listed in, and the other fields are passed over without being converted.
+ *
+ * With 'columnTypes' or 'inferTypes' set, every column is stored in its own type, see csvType_t, in
+ * the columnar layout. CSV_TYPE_AUTO columns are inferred from the first 'typeSampleRows' rows; a
+ * later value that does not fit the inferred, or given, integer type widens its column, so precision
+ * is never lost. Text columns are coded through a dictionary per column.
+ *
+ * With 'filter' set, every row is first split into its raw fields, and only the rows the filter keeps
+ * are converted and stored. The filter gets the fields of 'filterNames' or 'filterIndices', which do
+ * not have to be loaded, as padded-off tokens pointing into the input. On several threads it is called
+ * from every parsing thread, and up to twice for each row: it must only depend on its tokens.
+ *
+ * With 'limit' set, reading stops once that many rows, after the filter, have been loaded: a memory
+ * mapped file is only touched up to the last of them. With 'sampling' set, 'sampleSize' rows are drawn
+ * instead, kept in file order: CSV_SAMPLE_RESERVOIR draws a uniform sample, the same for the same
+ * 'sampleSeed', and CSV_SAMPLE_STRIDE picks evenly spaced rows of a mapped file by byte offset without
+ * scanning the others. Streamed inputs are always reservoir sampled.
+ * Projected, typed, filtered, limited and sampled loads do not use the binary cache.
+ *
+ * A data frame loaded from a file or a file descriptor can take the rows appended to it later with
+ * refreshCsv().
+ *
+ * With 'stats' set and CSV_STATS on, the counters of the load are written to it, see csvLoadStats_t:
+ * the wall time of every phase, the system calls made on the input, and the allocations and peak
+ * memory of the dataframe arena. Scratch buffers the loader frees before it returns are not counted.
+ * Streamed inputs time their reads as I/O and everything else as parsing.
+ *
+ * @param options A pointer to the loader options, or NULL to use the defaults of initCsvOptions().
+ * @return A pointer to a dynamically allocated 'csvData_t' structure representing the loaded data frame,
+ *         or NULL if the input could not be opened or memory could not be allocated.
+ *
+ * @note The returned data frame must be freed with csvFree().
+ *
+ * @code
+ *   // Example usage:
+ *   csvOptions_t options;
+ *   initCsvOptions(&options);
+ *   options.path = "data.tsv";
+ *   options.delim = "\t";
+ *   options.threads = 0; // one thread per CPU
+ *   csvData_t *dataFrame = loadCsvEx(&options);
+ *   if (dataFrame != NULL)
+ *   {
+ *       // Use the loaded data frame...
+ *   }
+ * @endcode
+ */
+csvData_t *loadCsvEx(const csvOptions_t *options)
+{
+    csvOptions_t defaults;
+    csvInput_t input;
+    bool_t status = TRUE;
+
+    if(options == NULL)
+    {
+        initCsvOptions(&defaults);
+        options = &defaults;
+    }
+
+    csvLoadStats_t *stats = (CSV_STATS == 1) ? options->stats : NULL;
+    uint64_t start = CSV_STATS_MARK(stats), mark = start;
+    int fd = options->fd;
+
+    memset(&input, 0, sizeof(input)); //a borrowed buffer has no mapping or buffer of its own for closeInput()
+
+    if(stats != NULL)
+    {
+        memset(stats, 0, sizeof(csvLoadStats_t));
+    }
+
+    if(options->buffer == NULL && fd < 0)
+    {
+        fd = open((options->path != NULL) ? options->path : CSV_PATH, O_RDONLY);
+        CSV_STATS_ADD(stats, syscalls, 1);
+
+        if(fd < 0)
+        {
+            fprintf(stderr, "Could not open the file.\n");
+            return NULL;
+        }
+    }
+
+    const char *delim = (options->delim != NULL && options->delim[0] != '\0') ? options->delim : CSV_DELIM;
+    csvData_t *df = newDataFrame(delim, options->layout, options->allocator);
+    csvCacheHeader_t identity;
+    char *cachePath = NULL;
+
+    memset(&identity, 0, sizeof(identity));
+    strncpy(identity.delim, delim, sizeof(identity.delim) - 1);
+    identity.header = (options->header == TRUE) ? 1 : 0;
+
+    bool_t reshaped = (options->columnNames != NULL || options->columnIndices != NULL || options->columnTypes != NULL ||
+                       options->inferTypes == TRUE || options->filter != NULL || options->limit > 0 ||
+                       options->sampling != CSV_SAMPLE_NONE) ? TRUE : FALSE;
+
+    if(df != NULL && options->cache == TRUE && reshaped == FALSE && options->buffer == NULL && options->fd < 0 &&
+       identifySource(fd, &identity) == TRUE)
+    {
+        cachePath = cachePathOf(options, (options->path != NULL) ? options->path : CSV_PATH);
+    }
+
+    if(df == NULL)
+    {
+        status = ERROR;
+    }
+    else if(cachePath != NULL && loadCacheFile(cachePath, &identity, df) == TRUE) //nothing left to parse
+    {
+        free(cachePath);
+        cachePath = NULL;
+        CSV_STATS_ADD(stats, syscalls, 4); //open, fstat, mmap and close of the cache file
+        CSV_STATS_ADD(stats, bytes, (size_t)df->rows * (size_t)df->cols * sizeof(float));
+        CSV_STATS_PHASE(stats, CSV_PHASE_IO, mark);
+    }
+    else if(options->buffer != NULL || mapInput(fd, &input, stats) == TRUE) //parsed in place
+    {
+        if(options->buffer != NULL) //borrowed, closeInput() leaves it alone
+        {
+            input.data = options->buffer;
+            input.size = options->bufferSize;
+        }
+
+        bool_t plain = decompressInput(&input, options->threads);
+        const char *begin = input.data;
+        const char *end = (plain != ERROR) ? input.data + input.size : input.data; //nothing to parse out of a corrupt input
+        const char *inputBegin = begin;
+
+        csvFilter_t filter;
+
+        CSV_STATS_PHASE(stats, CSV_PHASE_IO, mark);
+        const char *rows = parseRangeHeader(df, begin, end, options->header);
+        begin = (rows != NULL) ? rows : end; //nothing to parse if the header could not be read
+        status = (initFilter(df, options, &filter) != ERROR) ? projectColumns(df, options) : ERROR;
+        status = (plain == ERROR || rows == NULL) ? ERROR : status;
+        status = (status == TRUE) ? resolveColumnTypes(df, options, begin, end) : status;
+        const csvFilter_t *rowFilter = (filter.test != NULL) ? &filter : NULL;
+        long limit = options->limit;
+
+        CSV_STATS_PHASE(stats, CSV_PHASE_HEADER, mark);
+
+        if(options->sampling == CSV_SAMPLE_STRIDE && input.mapping != NULL)
+        {
+            (void)posix_madvise(input.mapping, input.mappingSize, POSIX_MADV_RANDOM); //no read-ahead between samples
+            CSV_STATS_ADD(stats, syscalls, 1);
+        }
+
+        if(status == TRUE && options->sampling != CSV_SAMPLE_NONE)
+        {
+            status = parseSampledRange(df, options, rowFilter, begin, end);
+            CSV_STATS_PHASE(stats, CSV_PHASE_PARSE, mark);
+        }
+        else if(status == TRUE)
+        {
+            end = (limit > 0 && rowFilter == NULL) ? findRowsEnd(begin, end, &limit) : end; //nothing past the limit is touched
+            CSV_STATS_PHASE(stats, CSV_PHASE_SCAN, mark);
+            status = parseRange(df, begin, end, options->threads, rowFilter, options->limit, stats);
+            mark = CSV_STATS_MARK(stats);
+        }
+
+        CSV_STATS_ADD(stats, bytes, end - inputBegin);
+        closeFilter(&filter);
+
+        if(options->buffer == NULL && rowFilter == NULL && plain == TRUE && options->limit <= 0 &&
+           options->sampling == CSV_SAMPLE_NONE && df->types == NULL) //compressed inputs are not refreshed
+        {
+            const char *inputEnd = input.data + input.size;
+            const char *rowsEnd = findLastRowEnd(begin, inputEnd); //the rows refreshCsv() would take as complete
+
+            df->openRows = isBlank(rowsEnd, inputEnd) ? 0 : 1;
+            df->sourceOffset = (int64_t)(input.mappingSize - input.size) + (((df->openRows > 0) ? rowsEnd : inputEnd) - input.data);
+        }
+
+        if(options->buffer == NULL)
+        {
+            CSV_STATS_ADD(stats, syscalls, (input.mapping != NULL) ? 1 : 0); //munmap
+        }
+
+        closeInput(&input);
+    }
+    else //streamed through a read buffer
+    {
+        csvLineReader_t reader;
+        status = initLineReader(&reader, fd, options->readBlockSize);
+        reader.stats = stats;
+
+        if(status == TRUE)
+        {
+            uint64_t readNs = (stats != NULL) ? stats->phaseNs[CSV_PHASE_IO] : 0;
+
+            CSV_STATS_PHASE(stats, CSV_PHASE_IO, mark);
+            status = parseStream(df, &reader, options);
+            bool_t plain = (reader.decoder == NULL) ? TRUE : FALSE;
+            size_t openBytes = reader.openBytes;
+            closeLineReader(&reader);
+            CSV_STATS_PHASE(stats, CSV_PHASE_PARSE, mark);
+            off_t position = (options->filter == NULL && plain == TRUE) ? lseek(fd, 0, SEEK_CUR) : -1; //-1 for pipes
+            df->sourceOffset = (position >= 0) ? (int64_t)position - (int64_t)openBytes : -1;
+            df->openRows = (openBytes > 0) ? 1 : 0;
+
+            if(stats != NULL) //the reads are timed on their own, within the parse
+            {
+                readNs = stats->phaseNs[CSV_PHASE_IO] - readNs;
+                stats->phaseNs[CSV_PHASE_PARSE] -= (readNs < stats->phaseNs[CSV_PHASE_PARSE]) ? readNs : stats->phaseNs[CSV_PHASE_PARSE];
+            }
+        }
+    }
+
+    if(fd >= 0 && fd != options->fd)
+    {
+        close(fd);
+        CSV_STATS_ADD(stats, syscalls, 1);
+    }
+
+    CSV_STATS_PHASE(stats, CSV_PHASE_IO, mark);
+
+    if(status == TRUE && cachePath != NULL && writeCacheFile(cachePath, &identity, df) != TRUE)
+    {
+        fprintf(stderr, "Could not write the cache file %s.\n", cachePath);
+    }
+
+    free(cachePath);
+    CSV_STATS_PHASE(stats, CSV_PHASE_FINISH, mark);
+
+    if(df != NULL && (options->limit > 0 || options->sampling != CSV_SAMPLE_NONE || df->types != NULL))
+    {
+        df->sourceOffset = -1; //the rows past the loaded ones are not all in the data frame
+    }
+
+    if(status != TRUE && df != NULL)
+    {
+        csvFree(df);
+        df = NULL;
+    }
+
+#if CSV_STATS == 1
+    if(stats != NULL && df != NULL)
+    {
+        stats->rows = (uint64_t)df->rows;
+        stats->fields = (uint64_t)df->rows * (uint64_t)((df->fields > df->cols) ? df->fields : df->cols);
+        stats->allocations = df->arena->allocations;
+        stats->allocatedBytes = df->arena->allocatedBytes;
+        stats->peakBytes = df->arena->peakBytes;
+    }
+
+    if(stats != NULL)
+    {
+        stats->totalNs = statsClock() - start;
+    }
+#endif
+
+    return df;
+}
+
+//INCREMENTAL REFRESH ---------------------------------------------------------
+
+/**
+ * @brief Make room for 'rows' rows in the data point storage of a data frame.
+ *
+ * The storage grows to at least twice its capacity, so that refreshing a data frame over and over
+ * costs amortized constant time per new row. Data points move with the storage of the row layouts
+ * and the columnar layout; the separate rows of 'CSV_LAYOUT_ROWS' never move, and the rows past the
+ * current ones get a block of their own, laid out up front like allocDataPoints() does.
+ *
+ * @return TRUE once the rows past the current ones can be parsed into preallocated storage, ERROR if
+ *         memory could not be allocated, in which case the data frame is left untouched.
+ */
+static bool_t reserveRows(csvData_t *df, int rows)
+{
+    long doubled = (long)df->rowCapacity * 2;
+    int capacity = (rows > df->rowCapacity) ? (int)((doubled > rows && doubled <= INT32_MAX) ? doubled : rows) : df->rowCapacity;
+
+    if(df->layout == CSV_LAYOUT_CONTIGUOUS && capacity > df->rowCapacity)
+    {
+        float *values = NULL;
+        float **rowPointers = allocPointerBlock(df->arena, (size_t)capacity, (size_t)capacity * df->cols, &values);
+
+        if(rowPointers == NULL)
+        {
+            return ERROR;
+        }
+
+        if(df->rows > 0)
+        {
+            memcpy(values, df->values, sizeof(float) * (size_t)df->rows * df->cols);
+        }
+
+        for(int row=0; row<capacity; row++)
+        {
+            rowPointers[row] = values + (size_t)row * df->cols;
+        }
+
+        arenaRelease(df->arena, df->dataFrame); //the old block starts at the row pointers
+        df->dataFrame = rowPointers;
+        df->values = values;
+    }
+    else if(df->layout == CSV_LAYOUT_COLUMNAR && capacity > df->rowCapacity)
+    {
+        size_t stride = columnStride(capacity);
+        float *values = NULL;
+        float **columnPointers = allocPointerBlock(df->arena, (size_t)df->cols, stride * df->cols, &values);
+
+        if(columnPointers == NULL)
+        {
+            return ERROR;
+        }
+
+        for(int col=0; col<df->cols; col++)
+        {
+            columnPointers[col] = values + (size_t)col * stride;
+
+            if(df->rows > 0)
+            {
+                memcpy(columnPointers[col], df->columns[col], sizeof(float) * df->rows);
+            }
+        }
+
+        arenaRelease(df->arena, df->columns);
+        df->columns = columnPointers;
+        df->values = values;
+        capacity = (int)stride;
+    }
+    else if(df->layout == CSV_LAYOUT_ROWS)
+    {
+        if(capacity > df->rowCapacity)
+        {
+            float **rowPointers = (float **)arenaAlloc(df->arena, sizeof(float *) * capacity, CSV_ARENA_MIN_ALIGNMENT);
+
+            if(rowPointers == NULL)
+            {
+                return ERROR;
+            }
+
+            if(df->rows > 0)
+            {
+                memcpy(rowPointers, df->dataFrame, sizeof(float *) * df->rows);
+            }
+
+            df->dataFrame = rowPointers; //the old array stays in the arena, a parallel load lays its rows out behind it
+        }
+
+        float *values = (float *)arenaAlloc(df->arena, sizeof(float) * (size_t)(rows - df->rows) * ((df->cols > 0) ? df->cols : 1),
+                                            CSV_ARENA_MIN_ALIGNMENT);
+
+        if(values == NULL)
+        {
+            df->rowCapacity = capacity; //the grown pointer array already holds every current row
+            return ERROR;
+        }
+
+        for(int row=df->rows; row<rows; row++)
+        {
+            df->dataFrame[row] = values + (size_t)(row - df->rows) * df->cols;
+        }
+    }
+
+    df->rowCapacity = capacity;
+
+    return TRUE;
+}
+
+#if HIGH_DATAFRAME_DETAIL == 1
+/**
+ * @brief Extend the min/max feature values of a data frame over its rows from 'firstRow' on.
+ */
+static void extendMinAndMax(csvData_t *df, int firstRow)
+{
+    for(int col=0; df->minFeatureValues != NULL && df->maxFeatureValues != NULL && col<df->cols; col++)
+    {
+        float min = (firstRow > 0) ? df->minFeatureValues[col] : INFINITY;
+        float max = (firstRow > 0) ? df->maxFeatureValues[col] : -INFINITY;
+
+        for(int row=firstRow; row<df->rows; row++)
+        {
+            float value = (df->layout == CSV_LAYOUT_COLUMNAR) ? df->columns[col][row] : df->dataFrame[row][col];
+
+            min = (value < min) ? value : min;
+            max = (value > max) ? value : max;
+        }
+
+        df->minFeatureValues[col] = min;
+        df->maxFeatureValues[col] = max;
+    }
+}
+#endif
+
+/**
+ * @brief Parse the rows appended to a file past the offset a data frame was loaded up to.
+ *
+ * Only the appended bytes are mapped and scanned. They are parsed up to the last newline outside a
+ * quoted field: a row still being written is left for the next refresh. A last row the data frame
+ * was loaded with before its newline had been written is parsed again once that newline is there,
+ * and replaced by the complete row.
+ *
+ * @return The number of rows appended, or -1 if the file could not be mapped, memory could not be
+ *         allocated or the rows could not be parsed. The data frame and its offset are then unchanged.
+ */
+static long appendFileRows(csvData_t *df, int fd, int64_t fileSize)
+{
+    long pageSize = sysconf(_SC_PAGESIZE);
+    int64_t base = df->sourceOffset / pageSize * pageSize; //mappings start on a page boundary
+    size_t length = (size_t)(fileSize - base);
+    void *mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, (off_t)base);
+
+    if(mapping == MAP_FAILED)
+    {
+        fprintf(stderr, "Could not map the rows appended to the file.\n");
+        return -1;
+    }
+
+    (void)posix_madvise(mapping, length, POSIX_MADV_SEQUENTIAL);
+
+    const char *begin = (const char *)mapping + (df->sourceOffset - base);
+    const char *end = (const char *)mapping + length;
+    const char *rowsEnd = findLastRowEnd(begin, end);
+    long rows = countRows(begin, rowsEnd, df->delim[0], NULL);
+    int firstRow = df->rows;
+    int replaced = (rowsEnd > begin) ? df->openRows : 0; //the open row has been completed, it is in 'rows' again
+    float *openValues = (replaced > 0) ? (float *)malloc(sizeof(float) * (size_t)df->cols) : NULL;
+
+    if(rows > (long)INT32_MAX - df->rows || (rows > 0 && reserveRows(df, df->rows + (int)rows) == ERROR) ||
+       (replaced > 0 && openValues == NULL))
+    {
+        fprintf(stderr, "Could not allocate memory for %ld appended rows.\n", rows);
+        free(openValues);
+        munmap(mapping, length);
+        return -1;
+    }
+
+    for(int col=0; openValues != NULL && col<df->cols; col++) //put back if the rows can not be parsed
+    {
+        openValues[col] = (df->layout == CSV_LAYOUT_COLUMNAR) ? df->columns[col][firstRow - 1] : df->dataFrame[firstRow - 1][col];
+    }
+
+    csvRowStorage_t storage = {df->rowCapacity, df->values, 1, TRUE, NULL, 0};
+    storage.stride = (df->layout == CSV_LAYOUT_COLUMNAR) ? (size_t)df->rowCapacity : 1;
+    df->rows -= replaced; //overwritten in place, rows of 'CSV_LAYOUT_ROWS' keep their storage
+
+    bool_t status = (rows > 0) ? parseRows(df, &storage, begin, rowsEnd) : TRUE; //the storage has room for every counted row
+
+    munmap(mapping, length);
+
+    if(status != TRUE) //the rows stored before the failure are dropped, so that the refresh can be tried again
+    {
+        df->rows = firstRow;
+
+        for(int col=0; openValues != NULL && col<df->cols; col++)
+        {
+            *((df->layout == CSV_LAYOUT_COLUMNAR) ? &df->columns[col][firstRow - 1] : &df->dataFrame[firstRow - 1][col]) = openValues[col];
+        }
+
+        fprintf(stderr, "Could not parse the rows appended to the file.\n");
+        free(openValues);
+        return -1;
+    }
+
+    free(openValues);
+
+    df->sourceOffset += (int64_t)(rowsEnd - begin);
+    df->openRows -= replaced;
+    df->DFSize = (long)df->rows * df->cols;
+#if HIGH_DATAFRAME_DETAIL == 1
+    extendMinAndMax(df, (replaced > 0) ? 0 : firstRow); //the values of the replaced row may have been the extremes
+#endif
+
+    return df->rows - firstRow;
+}
+
+/**
+ * @brief Load the rows appended to a '.csv' file since it was loaded into a data frame.
+ *
+ * The data frame remembers the file offset of its last newline. Only the bytes appended past it
+ * are parsed, up to the last complete row, and the new rows are added at the end of the data frame in
+ * its layout and feature projection. The data point storage grows geometrically, so the amortized
+ * cost of a refresh is linear in the number of new rows, whatever the size of the data frame; with
+ * HIGH_DATAFRAME_DETAIL on, the min/max feature values are extended over the new rows alone.
+ *
+ * Data frames loaded by loadCsvEx() from a file or a file descriptor, including through the binary
+ * cache, can be refreshed. Those read from a buffer or a pipe, and filtered, limited, sampled or typed
+ * loads, can not.
+ *
+ * @param df A pointer to the data frame to refresh.
+ * @param options The options the data frame was loaded with, of which only 'path' and 'fd' are used,
+ *                or NULL to use the defaults of initCsvOptions().
+ * @return The number of rows appended, zero if the file has not grown by a whole row, or -1 if the
+ *         data frame can not be refreshed, the file is shorter than when it was loaded, memory could
+ *         not be allocated or the appended rows could not be parsed; nothing is added then, and the
+ *         next refresh parses them again. Rows already in the data frame are never changed, except a
+ *         last row loaded before its newline had been written: it is replaced by the complete row once
+ *         that newline is appended, and is not counted as appended.
+ *
+ * @note Arrays taken from the data frame, such as 'dataFrame', 'columns' or 'values', may move when it
+ *       is refreshed, the rows of 'CSV_LAYOUT_ROWS' do not.
+ *
+ * @code
+ *   // Example usage:
+ *   csvOptions_t options;
+ *   initCsvOptions(&options);
+ *   options.path = "events.csv";
+ *   csvData_t *dataFrame = loadCsvEx(&options);
+ *   while (dataFrame != NULL && refreshCsv(dataFrame, &options) >= 0)
+ *   {
+ *       // Use the rows loaded so far, then wait for the producer to append more...
+ *   }
+ * @endcode
+ */
+long refreshCsv(csvData_t *df, const csvOptions_t *options)
+{
+    csvOptions_t defaults;
+    struct stat fileStat;
+    long appended = -1;
+
+    if(options == NULL)
+    {
+        initCsvOptions(&defaults);
+        options = &defaults;
+    }
+
+    if(df == NULL || df->arena == NULL || df->sourceOffset < 0 || df->types != NULL || df->cols <= 0)
+    {
+        fprintf(stderr, "The data frame can not be refreshed.\n");
+        return -1;
+    }
+
+    int fd = (options->fd >= 0) ? options->fd : open((options->path != NULL) ? options->path : CSV_PATH, O_RDONLY);
+
+    if(fd < 0)
+    {
+        fprintf(stderr, "Could not open the file.\n");
+        return -1;
+    }
+
+    if(fstat(fd, &fileStat) != 0 || (int64_t)fileStat.st_size < df->sourceOffset)
+    {
+        fprintf(stderr, "The file is shorter than when it was loaded.\n");
+    }
+    else
+    {
+        appended = ((int64_t)fileStat.st_size > df->sourceOffset) ? appendFileRows(df, fd, (int64_t)fileStat.st_size) : 0;
+    }
+
+    if(fd != options->fd)
+    {
+        close(fd);
+    }
+
+    return appended;
+}
+
+//BATCH READER ----------------------------------------------------------------
+
+typedef struct
+{
+    float *values;              //data points of the batch, laid out like the batches of nextBatch()
+    long rows;                  //rows in the batch, zero at the end of the input, -1 if reading failed
+}csvBatchSlot_t;
+
+typedef struct
+{
+    pthread_t producer;         //background thread parsing the batches ahead
+    csvBatchSlot_t *slots;      //ring of parsed batches
+    void *block;                //single allocation holding the data points of every slot
+    int depth;                  //number of slots in the ring
+    long batchRows;             //rows of every slot
+    sem_t ready;                //slots parsed and waiting for the consumer
+    sem_t empty;                //slots the producer may parse into
+    int tail;                   //next slot the producer fills, only touched by the producer
+    int head;                   //slot the consumer reads from, only touched by the consumer
+    long offset;                //rows of the head slot already handed out by nextBatch()
+    bool_t holding;             //the consumer owns the head slot
+    long endRows;               //rows of the last slot, once the consumer has reached it
+    bool_t finished;            //the consumer has reached the end of the input
+    bool_t stopping;            //the reader is being closed, read and written atomically
+}csvPrefetch_t;
+
+struct csvBatchReader
+{
+    csvData_t *header;          //feature names and number of columns, holds no rows
+    csvLineReader_t lines;      //read buffer of streamed inputs
+    bool_t streamed;            //FALSE if the input is a buffer held in memory
+    int fd;                     //descriptor opened by the reader, -1 if it belongs to the caller
+    const char *cursor;         //first character of the rows not handed out yet
+    const char *end;            //one past the last character read so far
+    bool_t status;              //TRUE while there may be rows left, ERROR once reading failed
+    csvPrefetch_t *prefetch;    //batches parsed ahead on a background thread, NULL if unused
+    csvFilter_t filter;         //decides which rows are handed out, without a callback to hand out every row
+};
+
+/**
+ * @brief Open a '.csv' input for reading in batches of rows.
+ *
+ * Only the feature names are read up front. The rows are then handed out by nextBatch() into a buffer
+ * owned by the caller, so memory use is bounded by that buffer plus the read buffer, whatever the size
+ * of the input. Inputs are taken from the same options as loadCsvEx(): files and file descriptors are
+ * streamed through a read buffer of 'readBlockSize' bytes, and buffers in memory are read in place.
+ *
+ * @param options A pointer to the loader options, or NULL to use the defaults of initCsvOptions().
+ * @return A pointer to the batch reader, or NULL if the input could not be opened or memory could not
+ *         be allocated.
+ *
+ * @note Every batch reader must be released with closeBatchReader().
+ *
+ * @code
+ *   // Example usage:
+ *   csvBatchReader_t *reader = openBatchReader(NULL);
+ *   const csvData_t *header = getBatchHeader(reader);
+ *   float *batch = malloc(sizeof(float) * 4096 * header->cols);
+ *   long rows;
+ *   while ((rows = nextBatch(reader, batch, 4096)) > 0)
+ *   {
+ *       // Use the rows of the batch...
+ *   }
+ *   closeBatchReader(reader);
+ *   free(batch);
+ * @endcode
+ */
+csvBatchReader_t *openBatchReader(const csvOptions_t *options)
+{
+    csvOptions_t defaults;
+
+    if(options == NULL)
+    {
+        initCsvOptions(&defaults);
+        options = &defaults;
+    }
+
+    csvBatchReader_t *reader = (csvBatchReader_t *)calloc(1, sizeof(csvBatchReader_t));
+    const char *delim = (options->delim != NULL && options->delim[0] != '\0') ? options->delim : CSV_DELIM;
+
+    if(reader == NULL || (reader->header = newDataFrame(delim, options->layout, options->allocator)) == NULL)
+    {
+        free(reader);
+        return NULL;
+    }
+
+    reader->fd = -1;
+    reader->status = TRUE;
+
+    if(options->buffer != NULL)
+    {
+        reader->end = options->buffer + options->bufferSize;
+        reader->cursor = parseRangeHeader(reader->header, options->buffer, reader->end, options->header);
+
+        if(reader->cursor == NULL || initFilter(reader->header, options, &reader->filter) == ERROR || projectColumns(reader->header, options) == ERROR)
+        {
+            closeBatchReader(reader);
+            return NULL;
+        }
+
+        return reader;
+    }
+
+    int fd = options->fd;
+
+    if(fd < 0 && (fd = reader->fd = open((options->path != NULL) ? options->path : CSV_PATH, O_RDONLY)) < 0)
+    {
+        fprintf(stderr, "Could not open the file.\n");
+        closeBatchReader(reader);
+        return NULL;
+    }
+
+    if(initLineReader(&reader->lines, fd, options->readBlockSize) == ERROR)
+    {
+        closeBatchReader(reader);
+        return NULL;
+    }
+
+    char *lines = NULL, *linesEnd = NULL;
+
+    reader->streamed = TRUE;
+    reader->status = parseStreamHeader(reader->header, &reader->lines, options->header, &lines, &linesEnd);
+    reader->cursor = lines;
+    reader->end = linesEnd;
+
+    if(initFilter(reader->header, options, &reader->filter) == ERROR || projectColumns(reader->header, options) == ERROR)
+    {
+        closeBatchReader(reader);
+        return NULL;
+    }
+
+    return reader;
+}
+
+/**
+ * @brief Get the feature names and the number of columns of a batch reader.
+ *
+ * @return A pointer to a data frame without rows, owned by the reader.
+ */
+const csvData_t *getBatchHeader(const csvBatchReader_t *reader)
+{
+    return reader->header;
+}
+
+/**
+ * @brief Parse the next rows of a batch reader into 'batch', see nextBatch().
+ */
+static long parseBatch(csvBatchReader_t *reader, float *batch, long maxRows)
+{
+    csvData_t slice = *reader->header;
+    long rows = 0;
+
+    slice.layout = (slice.layout == CSV_LAYOUT_COLUMNAR) ? CSV_LAYOUT_COLUMNAR : CSV_LAYOUT_CONTIGUOUS;
+
+    while(rows < maxRows && reader->status == TRUE)
+    {
+        if(reader->cursor >= reader->end)
+        {
+            char *lines = NULL, *linesEnd = NULL;
+
+            reader->status = (reader->streamed == TRUE) ? readLines(&reader->lines, FALSE, &lines, &linesEnd) : FALSE;
+            reader->cursor = lines;
+            reader->end = linesEnd;
+            continue;
+        }
+
+        long wanted = maxRows - rows;
+        const char *rowsEnd = findRowsEnd(reader->cursor, reader->end, &wanted);
+        csvRowStorage_t storage = {(int)wanted, batch + (size_t)rows * slice.cols, 1, TRUE, NULL, 0};
+
+        if(slice.layout == CSV_LAYOUT_COLUMNAR)
+        {
+            storage.values = batch + rows;
+            storage.stride = (size_t)maxRows;
+        }
+
+        slice.rows = 0;
+
+        if(parseKeptRows(&slice, &storage, &reader->filter, reader->cursor, rowsEnd) == ERROR)
+        {
+            reader->status = ERROR; //the rows of the range past the failure are lost, so is the batch
+            return -1;
+        }
+
+        rows += slice.rows;
+        reader->cursor = rowsEnd;
+    }
+
+    return (rows == 0 && reader->status == ERROR) ? -1 : rows;
+}
+
+/**
+ * @brief Wait on a semaphore, going back to sleep if a signal interrupts the wait.
+ */
+static void waitSemaphore(sem_t *semaphore)
+{
+    while(sem_wait(semaphore) != 0 && errno == EINTR)
+    {
+    }
+}
+
+/**
+ * @brief Body of the prefetch thread: parse batches into empty slots of the ring until the input ends.
+ *
+ * The ring is a single-producer/single-consumer queue. Each index is only written by its own side and
+ * every slot changes hands through a semaphore post, so neither side ever takes a lock and the
+ * consumer always sees the data points of a slot that has been posted as ready.
+ */
+static void *prefetchWorker(void *arg)
+{
+    csvBatchReader_t *reader = (csvBatchReader_t *)arg;
+    csvPrefetch_t *prefetch = reader->prefetch;
+
+    for(;;)
+    {
+        waitSemaphore(&prefetch->empty);
+
+        if(__atomic_load_n(&prefetch->stopping, __ATOMIC_ACQUIRE) == TRUE)
+        {
+            break;
+        }
+
+        csvBatchSlot_t *slot = &prefetch->slots[prefetch->tail];
+        slot->rows = parseBatch(reader, slot->values, prefetch->batchRows);
+        prefetch->tail = (prefetch->tail + 1) % prefetch->depth;
+
+        sem_post(&prefetch->ready);
+
+        if(slot->rows <= 0) //the end of the input is handed over like any other batch
+        {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Take ownership of the next parsed slot of the ring, waiting for it if needed.
+ *
+ * @return A pointer to the slot, or NULL once the end of the input has been reached.
+ */
+static csvBatchSlot_t *acquireSlot(csvPrefetch_t *prefetch)
+{
+    if(prefetch->finished == TRUE)
+    {
+        return NULL;
+    }
+
+    if(prefetch->holding == FALSE)
+    {
+        waitSemaphore(&prefetch->ready);
+        prefetch->holding = TRUE;
+        prefetch->offset = 0;
+    }
+
+    csvBatchSlot_t *slot = &prefetch->slots[prefetch->head];
+
+    if(slot->rows <= 0)
+    {
+        prefetch->endRows = slot->rows;
+        prefetch->finished = TRUE;
+        return NULL;
+    }
+
+    return slot;
+}
+
+/**
+ * @brief Give the head slot of the ring back to the producer.
+ */
+static void releaseSlot(csvPrefetch_t *prefetch)
+{
+    if(prefetch->holding == TRUE && prefetch->finished == FALSE)
+    {
+        prefetch->holding = FALSE;
+        prefetch->head = (prefetch->head + 1) % prefetch->depth;
+        sem_post(&prefetch->empty);
+    }
+}
+
+/**
+ * @brief Copy prefetched rows into a buffer owned by the caller, for nextBatch().
+ */
+static long copyPrefetchedRows(csvPrefetch_t *prefetch, const csvData_t *header, float *batch, long maxRows)
+{
+    long rows = 0;
+    csvBatchSlot_t *slot = NULL;
+
+    while(rows < maxRows && (slot = acquireSlot(prefetch)) != NULL)
+    {
+        long count = slot->rows - prefetch->offset;
+        count = (count < maxRows - rows) ? count : maxRows - rows;
+
+        if(header->layout == CSV_LAYOUT_COLUMNAR)
+        {
+            for(int col=0; col<header->cols; col++)
+            {
+                memcpy(batch + (size_t)col * maxRows + rows,
+                       slot->values + (size_t)col * prefetch->batchRows + prefetch->offset, sizeof(float) * count);
+            }
+        }
+        else
+        {
+            memcpy(batch + (size_t)rows * header->cols, slot->values + (size_t)prefetch->offset * header->cols,
+                   sizeof(float) * count * header->cols);
+        }
+
+        rows += count;
+        prefetch->offset += count;
+
+        if(prefetch->offset == slot->rows)
+        {
+            releaseSlot(prefetch);
+        }
+    }
+
+    return (rows == 0 && prefetch->finished == TRUE) ? prefetch->endRows : rows;
+}
+
+/**
+ * @brief Start parsing batches ahead of the consumer on a background thread.
+ *
+ * From then on the reader thread parses batch N+1 to N+depth-1 while the caller works on batch N. The
+ * parsed batches wait in a ring of 'depth' slots of 'batchRows' rows, so the memory used on top of the
+ * read buffer is bounded by 'depth * batchRows * cols' floats, whatever the size of the input. Batches
+ * are then taken with nextBatch(), which copies them into the caller's buffer, or without any copy
+ * with acquireBatch(); the two should not be mixed on the same reader.
+ *
+ * @param reader A pointer to the batch reader, nothing must have been read from it on another thread.
+ * @param batchRows The number of rows of every prefetched batch.
+ * @param depth The number of batches held at most, at least two so that parsing and consuming overlap.
+ * @return TRUE if the prefetch thread has been started, ERROR otherwise, in which case the reader keeps
+ *         parsing on the calling thread.
+ *
+ * @code
+ *   // Example usage:
+ *   csvBatchReader_t *reader = openBatchReader(NULL);
+ *   startPrefetch(reader, 4096, 2); // double buffered
+ *   long rows;
+ *   const float *batch;
+ *   while ((batch = acquireBatch(reader, &rows)) != NULL)
+ *   {
+ *       // Use the rows of the batch while the next one is being parsed...
+ *   }
+ *   closeBatchReader(reader);
+ * @endcode
+ */
+bool_t startPrefetch(csvBatchReader_t *reader, long batchRows, int depth)
+{
+    if(reader->prefetch != NULL || batchRows <= 0)
+    {
+        return ERROR;
+    }
+
+    csvPrefetch_t *prefetch = (csvPrefetch_t *)calloc(1, sizeof(csvPrefetch_t));
+    depth = (depth >= 2) ? depth : 2;
+
+    size_t slotFloats = columnStride((int)batchRows) * ((reader->header->cols > 0) ? reader->header->cols : 1);
+
+    if(prefetch == NULL || posix_memalign(&prefetch->block, CSV_ALIGNMENT, sizeof(float) * slotFloats * depth) != 0)
+    {
+        free(prefetch);
+        return ERROR;
+    }
+
+    prefetch->slots = (csvBatchSlot_t *)calloc(depth, sizeof(csvBatchSlot_t));
+
+    if(prefetch->slots == NULL)
+    {
+        free(prefetch->block);
+        free(prefetch);
+        return ERROR;
+    }
+
+    for(int slot=0; slot<depth; slot++) //every slot starts on a 'CSV_ALIGNMENT' boundary
+    {
+        prefetch->slots[slot].values = (float *)prefetch->block + slotFloats * slot;
+    }
+
+    prefetch->depth = depth;
+    prefetch->batchRows = batchRows;
+    sem_init(&prefetch->ready, 0, 0);
+    sem_init(&prefetch->empty, 0, (unsigned int)depth);
+    reader->prefetch = prefetch;
+
+    if(pthread_create(&prefetch->producer, NULL, prefetchWorker, reader) != 0)
+    {
+        reader->prefetch = NULL;
+        sem_destroy(&prefetch->ready);
+        sem_destroy(&prefetch->empty);
+        free(prefetch->slots);
+        free(prefetch->block);
+        free(prefetch);
+        return ERROR;
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Take the next prefetched batch without copying it.
+ *
+ * The previous batch returned by this function is handed back to the prefetch thread first, so a
+ * batch stays valid until the next call or until the reader is closed.
+ *
+ * @param reader A pointer to a batch reader on which startPrefetch() has been called.
+ * @param rows Set to the number of rows of the batch, zero at the end of the input, or -1 if reading failed.
+ * @return A pointer to the data points of the batch, laid out like the batches of nextBatch() for
+ *         'batchRows' rows, or NULL at the end of the input.
+ */
+const float *acquireBatch(csvBatchReader_t *reader, long *rows)
+{
+    csvPrefetch_t *prefetch = reader->prefetch;
+
+    if(prefetch == NULL)
+    {
+        *rows = -1;
+        return NULL;
+    }
+
+    releaseSlot(prefetch);
+
+    csvBatchSlot_t *slot = acquireSlot(prefetch);
+
+    *rows = (slot != NULL) ? slot->rows : prefetch->endRows;
+
+    return (slot != NULL) ? slot->values : NULL;
+}
+
+/**
+ * @brief Stop the prefetch thread of a batch reader and release the ring.
+ */
+static void stopPrefetch(csvPrefetch_t *prefetch)
+{
+    __atomic_store_n(&prefetch->stopping, TRUE, __ATOMIC_RELEASE);
+    sem_post(&prefetch->empty); //wakes the producer if it waits for an empty slot
+    pthread_join(prefetch->producer, NULL);
+
+    sem_destroy(&prefetch->ready);
+    sem_destroy(&prefetch->empty);
+    free(prefetch->slots);
+    free(prefetch->block);
+    free(prefetch);
+}
+
+/**
+ * @brief Read the next batch of rows into a buffer owned by the caller.
+ *
+ * The rows are written as 'maxRows' rows of 'cols' data points for the row layouts and as 'cols' columns
+ * of 'maxRows' data points for 'CSV_LAYOUT_COLUMNAR'. Nothing is allocated: the rows are parsed straight
+ * out of the read buffer into 'batch'. Missing fields are left as zero and blank rows are skipped, like
+ * loadCsv() does.
+ *
+ * @param reader A pointer to the batch reader.
+ * @param batch A buffer of at least 'maxRows * cols' floats.
+ * @param maxRows The number of rows the buffer can hold.
+ * Once startPrefetch() has been called, the rows come out of the batches parsed ahead by the prefetch
+ * thread and are copied into 'batch', which may be of any size.
+ *
+ * @return The number of rows read, less than 'maxRows' only for the last batch, zero at the end of the
+ *         input, or -1 if reading failed.
+ */
+long nextBatch(csvBatchReader_t *reader, float *batch, long maxRows)
+{
+    if(reader->prefetch != NULL)
+    {
+        return copyPrefetchedRows(reader->prefetch, reader->header, batch, maxRows);
+    }
+
+    return parseBatch(reader, batch, maxRows);
+}
+
+/**
+ * @brief Release a batch reader, closing its input if the reader opened it.
+ */
+void closeBatchReader(csvBatchReader_t *reader)
+{
+    if(reader == NULL)
+    {
+        return;
+    }
+
+    if(reader->prefetch != NULL) //the prefetch thread reads from the line reader
+    {
+        stopPrefetch(reader->prefetch);
+    }
+
+    if(reader->streamed == TRUE)
+    {
+        closeLineReader(&reader->lines);
+    }
+
+    if(reader->fd >= 0)
+    {
+        close(reader->fd);
+    }
+
+    closeFilter(&reader->filter);
+    csvFree(reader->header);
+    free(reader);
+}
+
+//LAZY FRAMES -----------------------------------------------------------------
+
+struct csvLazyFrame
+{
+    csvData_t *header;          //feature names and the numbers of rows and columns, the columns live in its arena
+    csvInput_t input;           //mapped input, unused if the rows are in a buffer of the caller
+    const char *begin;          //first character of the data point rows
+    const char *end;            //one past the last character of the input
+    size_t *rowOffsets;         //offset from 'begin' of every CSV_LAZY_INDEX_STRIDE-th row
+    long offsetCount;           //entries in 'rowOffsets'
+    float **columns;            //data points of every column parsed so far, NULL for the others
+    int threads;                //threads columns are parsed with, zero for one per online CPU
+};
+
+/**
+ * @brief Index the start of every CSV_LAZY_INDEX_STRIDE-th row of a lazy frame and count its rows.
+ *
+ * Only the newlines outside quoted fields are looked at, which the structural scanner finds 64 bytes
+ * at a time: nothing is split into fields nor converted.
+ *
+ * @return TRUE on success, ERROR if memory could not be allocated.
+ */
+static bool_t indexLazyRows(csvLazyFrame_t *frame)
+{
+    csvScanner_t scanner;
+    size_t capacity = 1024;
+    long rows = 0;
+
+    frame->rowOffsets = (size_t *)malloc(sizeof(size_t) * capacity);
+
+    if(frame->rowOffsets == NULL)
+    {
+        return ERROR;
+    }
+
+    startScanner(&scanner, frame->begin, frame->end, '\n', FALSE); //separators are newlines too, only newlines are handed out
+
+    for(const char *rowStart = frame->begin; rowStart < frame->end; )
+    {
+        const char *rowEnd = nextStructural(&scanner);
+
+        if( ! isBlank(rowStart, rowEnd)) //whitespace-only rows are not rows, as for the loader
+        {
+            if(rows % CSV_LAZY_INDEX_STRIDE == 0 && (size_t)frame->offsetCount == capacity)
+            {
+                size_t *grown = (size_t *)realloc(frame->rowOffsets, sizeof(size_t) * capacity * 2);
+
+                if(grown == NULL)
+                {
+                    return ERROR;
+                }
+
+                frame->rowOffsets = grown;
+                capacity *= 2;
+            }
+
+            if(rows % CSV_LAZY_INDEX_STRIDE == 0)
+            {
+                frame->rowOffsets[frame->offsetCount++] = (size_t)(rowStart - frame->begin);
+            }
+
+            rows++;
+        }
+
+        rowStart = rowEnd + 1;
+    }
+
+    if(rows > INT32_MAX)
+    {
+        return ERROR;
+    }
+
+    frame->header->rows = (int)rows;
+
+    return TRUE;
+}
+
+/**
+ * @brief Open a '.csv' input whose columns are only parsed when they are first asked for.
+ *
+ * Opening maps the input and reads the header row, then makes a single pass over the newlines of the
+ * rows to count them and to record where every CSV_LAZY_INDEX_STRIDE-th row starts. No field is split
+ * nor converted, so opening a wide file costs about as much as scanning it once. getLazyColumn() then
+ * parses the column it is asked for out of the mapping, on several threads, each starting from an
+ * entry of the row index, and keeps it for the next calls.
+ *
+ * The input is taken from 'buffer', 'fd' or 'path' as for loadCsvEx(), but must be held in memory or
+ * be a file that can be memory mapped. The deliminator, header setting, allocator and thread count
+ * are taken from the options; the other options are not used.
+ *
+ * @param options A pointer to the loader options, or NULL to use the defaults of initCsvOptions().
+ * @return A pointer to the lazy frame, or NULL if the input could not be mapped or memory could not be
+ *         allocated.
+ *
+ * @note Every lazy frame must be released with closeLazyFrame(). A buffer given in the options must
+ *       outlive it.
+ *
+ * @code
+ *   // Example usage:
+ *   csvLazyFrame_t *frame = openLazyFrame(NULL);
+ *   int col = (frame != NULL) ? getFeatureIndex(getLazyHeader(frame), "price") : -1;
+ *   const float *prices = (col >= 0) ? getLazyColumn(frame, col) : NULL; // parsed now
+ *   prices = getLazyColumn(frame, col);                                   // already there
+ *   closeLazyFrame(frame);
+ * @endcode
+ */
+csvLazyFrame_t *openLazyFrame(const csvOptions_t *options)
+{
+    csvOptions_t defaults;
+
+    if(options == NULL)
+    {
+        initCsvOptions(&defaults);
+        options = &defaults;
+    }
+
+    csvLazyFrame_t *frame = (csvLazyFrame_t *)calloc(1, sizeof(csvLazyFrame_t));
+    const char *delim = (options->delim != NULL && options->delim[0] != '\0') ? options->delim : CSV_DELIM;
+
+    if(frame == NULL || (frame->header = newDataFrame(delim, CSV_LAYOUT_COLUMNAR, options->allocator)) == NULL)
+    {
+        free(frame);
+        return NULL;
+    }
+
+    bool_t status = TRUE;
+    frame->threads = options->threads;
+
+    if(options->buffer != NULL) //borrowed, closeInput() leaves it alone
+    {
+        frame->input.data = options->buffer;
+        frame->input.size = options->bufferSize;
+    }
+    else if(options->fd >= 0)
+    {
+        status = mapInput(options->fd, &frame->input, NULL);
+    }
+    else
+    {
+        status = openInput((options->path != NULL) ? options->path : CSV_PATH, &frame->input);
+    }
+
+    if(status != TRUE)
+    {
+        fprintf(stderr, "Could not map the file.\n");
+        closeLazyFrame(frame);
+        return NULL;
+    }
+
+    if(decompressInput(&frame->input, options->threads) == ERROR) //columns are parsed out of the decompressed text
+    {
+        closeLazyFrame(frame);
+        return NULL;
+    }
+
+    frame->begin = frame->input.data;
+    frame->end = frame->input.data + frame->input.size;
+
+    frame->begin = parseRangeHeader(frame->header, frame->begin, frame->end, options->header);
+    frame->columns = (float **)calloc((frame->header->cols > 0) ? (size_t)frame->header->cols : 1, sizeof(float *));
+
+    if(frame->begin == NULL || frame->columns == NULL || indexLazyRows(frame) != TRUE)
+    {
+        closeLazyFrame(frame);
+        return NULL;
+    }
+
+    frame->header->columns = frame->columns;
+
+    return frame;
+}
+
+/**
+ * @brief Get the feature names and the numbers of rows and columns of a lazy frame.
+ *
+ * @return A pointer to a data frame owned by the lazy frame. Its 'columns' are the columns parsed so
+ *         far, NULL for the others.
+ */
+const csvData_t *getLazyHeader(const csvLazyFrame_t *frame)
+{
+    return frame->header;
+}
+
+/**
+ * @brief Get the data points of a column of a lazy frame, parsing them on first use.
+ *
+ * The rows are cut into chunks on entries of the row index, and every chunk is parsed on the thread
+ * pool with all the fields but the one of the column passed over unconverted, straight into its slice
+ * of the column. The column is kept in the arena of the lazy frame, so later calls return it at once.
+ *
+ * @param frame A pointer to the lazy frame.
+ * @param col The column to get.
+ * @return A pointer to 'rows' data points, or NULL if the column does not exist or memory could not
+ *         be allocated.
+ *
+ * @note Calls on the same lazy frame must not overlap.
+ */
+const float *getLazyColumn(csvLazyFrame_t *frame, int col)
+{
+    csvData_t *header = frame->header;
+
+    if(col < 0 || col >= header->cols || frame->columns[col] != NULL)
+    {
+        return (col >= 0 && col < header->cols) ? frame->columns[col] : NULL;
+    }
+
+    float *values = (float *)arenaAlloc(header->arena, sizeof(float) * (size_t)((header->rows > 0) ? header->rows : 1), CSV_ALIGNMENT);
+    int *fieldColumns = (int *)malloc(sizeof(int) * (size_t)header->cols);
+    int threads = resolveThreadCount(frame->threads);
+    size_t dataBytes = (size_t)(frame->end - frame->begin);
+    long chunkCount = (long)threads * CSV_CHUNKS_PER_THREAD; //more chunks than threads evens out the load
+
+    chunkCount = (dataBytes / (size_t)chunkCount < CSV_MIN_CHUNK_SIZE) ? (long)(dataBytes / CSV_MIN_CHUNK_SIZE) : chunkCount;
+    chunkCount = (chunkCount < frame->offsetCount) ? chunkCount : frame->offsetCount; //chunks start on indexed rows
+    chunkCount = (chunkCount > 1) ? chunkCount : 1;
+
+    csvChunk_t *chunks = (csvChunk_t *)calloc((size_t)chunkCount, sizeof(csvChunk_t));
+    csvThreadPool_t *pool = (chunks != NULL) ? createThreadPool(threads, (int)chunkCount) : NULL;
+    bool_t status = (values != NULL && fieldColumns != NULL && pool != NULL) ? TRUE : ERROR;
+
+    csvData_t view = *header; //a single column data frame over every field of the rows
+
+    view.cols = 1;
+    view.fields = header->cols;
+    view.fieldColumns = fieldColumns;
+    view.layout = CSV_LAYOUT_CONTIGUOUS;
+    view.values = values;
+
+    for(int field=0; status == TRUE && field<header->cols; field++)
+    {
+        fieldColumns[field] = (field == col) ? 0 : -1;
+    }
+
+    for(long index=0; status == TRUE && header->rows > 0 && index<chunkCount; index++)
+    {
+        long first = frame->offsetCount * index / chunkCount, next = frame->offsetCount * (index + 1) / chunkCount;
+        long lastRow = (index + 1 == chunkCount) ? header->rows : next * CSV_LAZY_INDEX_STRIDE;
+
+        chunks[index].df = &view;
+        chunks[index].begin = frame->begin + frame->rowOffsets[first];
+        chunks[index].end = (index + 1 == chunkCount) ? frame->end : frame->begin + frame->rowOffsets[next];
+        chunks[index].rowOffset = first * CSV_LAZY_INDEX_STRIDE;
+        chunks[index].rows = lastRow - chunks[index].rowOffset;
+        submitTask(pool, parseChunkTask, &chunks[index]);
+    }
+
+    if(pool != NULL)
+    {
+        waitThreadPool(pool);
+        destroyThreadPool(pool);
+    }
+
+    for(long index=0; status == TRUE && header->rows > 0 && index<chunkCount; index++)
+    {
+        status = (chunks[index].status == TRUE) ? TRUE : ERROR;
+    }
+
+    free(chunks);
+    free(fieldColumns);
+
+    if(status != TRUE)
+    {
+        fprintf(stderr, "Could not parse column %d.\n", col);
+        arenaRelease(header->arena, values);
+        return NULL;
+    }
+
+    frame->columns[col] = values;
+
+    return values;
+}
+
+/**
+ * @brief Release a lazy frame and every column it has parsed.
+ */
+void closeLazyFrame(csvLazyFrame_t *frame)
+{
+    if(frame == NULL)
+    {
+        return;
+    }
+
+    closeInput(&frame->input);
+    free(frame->rowOffsets);
+    free(frame->columns);
+    csvFree(frame->header);
+    free(frame);
+}
+
+//FEATURE STATISTICS KERNELS --------------------------------------------------
+
+/**
+ * @brief Scalar column statistics kernel, also used for the tails of the SIMD kernels.
+ *
+ * Values are shifted by 'shift' (the first value of the column) before they are summed, which keeps
+ * the single pass variance accurate for features with a large mean and a small spread. NaN values
+ * never win the min/max comparisons, just like in getMinAndMaxFeatureValues().
+ */
+static void columnStatsScalar(const float *values, size_t count, double shift, csvStatsPartial_t *partial)
+{
+    for(size_t index=0; index<count; index++)
+    {
+        double shifted = (double)values[index] - shift;
+
+        partial->min = (values[index] < partial->min) ? values[index] : partial->min;
+        partial->max = (values[index] > partial->max) ? values[index] : partial->max;
+        partial->shiftedSum += shifted;
+        partial->shiftedSquares += shifted * shifted;
+    }
+}
+
+/**
+ * @brief Scalar row statistics kernel, accumulating one row into per-column partial results.
+ */
+static void rowStatsScalar(const float *row, int cols, const double *shifts, float *mins, float *maxs,
+                           double *sums, double *squares)
+{
+    for(int col=0; col<cols; col++)
+    {
+        double shifted = (double)row[col] - shifts[col];
+
+        mins[col] = (row[col] < mins[col]) ? row[col] : mins[col];
+        maxs[col] = (row[col] > maxs[col]) ? row[col] : maxs[col];
+        sums[col] += shifted;
+        squares[col] += shifted * shifted;
+    }
+}
+
+/**
+ * @brief Scalar structural scan of a 64-byte block.
+ */
+static void scanBlockScalar(const char *block, char separator, csvBlockMasks_t *masks)
+{
+    masks->separators = masks->quotes = masks->newlines = 0;
+
+    for(int index=0; index<64; index++)
+    {
+        uint64_t bit = (uint64_t)1 << index;
+
+        masks->separators |= (block[index] == separator) ? bit : 0;
+        masks->quotes |= (block[index] == '"') ? bit : 0;
+        masks->newlines |= (block[index] == '\n') ? bit : 0;
+    }
+}
+
+/**
+ * @brief Scalar quote mask of a block: bit i is set if byte i is inside quotes, the opening quote included.
+ *
+ * The prefix XOR of the quote bits, the carry-less product of the mask with all ones, in six shifts.
+ */
+static uint64_t quoteMaskScalar(uint64_t quotes)
+{
+    quotes ^= quotes << 1;
+    quotes ^= quotes << 2;
+    quotes ^= quotes << 4;
+    quotes ^= quotes << 8;
+    quotes ^= quotes << 16;
+    quotes ^= quotes << 32;
+
+    return quotes;
+}
+
+/**
+ * @brief Apply a transform operation to a single value.
+ */
+static float transformValue(float value, csvOp_t op, float first, float second)
+{
+    switch(op)
+    {
+        case CSV_OP_AFFINE:
+            return value * first + second;
+        case CSV_OP_CLIP:
+            return (value < first) ? first : ((value > second) ? second : value); //NaN fails both comparisons
+        default:
+            return (value != value) ? first : value;
+    }
+}
+
+/**
+ * @brief Scalar column transform kernel, also used for the tails of the SIMD kernels.
+ */
+static void transformColumnScalar(float *values, size_t count, csvOp_t op, float first, float second)
+{
+    for(size_t index=0; index<count; index++)
+    {
+        values[index] = transformValue(values[index], op, first, second);
+    }
+}
+
+/**
+ * @brief Scalar row transform kernel, with the parameters of every column.
+ */
+static void transformRowScalar(float *row, int cols, csvOp_t op, const float *first, const float *second)
+{
+    for(int col=0; col<cols; col++)
+    {
+        row[col] = transformValue(row[col], op, first[col], second[col]);
+    }
+}
+
+static const csvKernels_t scalarKernels = {"scalar", columnStatsScalar, rowStatsScalar, scanBlockScalar, quoteMaskScalar,
+                                           transformColumnScalar, transformRowScalar};
+
+#if CSV_X86_DISPATCH
+
+/**
+ * @brief AVX2 column statistics kernel, eight values per iteration with double precision sums.
+ */
+__attribute__((target("avx2,fma")))
+static void columnStatsAvx2(const float *values, size_t count, double shift, csvStatsPartial_t *partial)
+{
+    __m256 minVec = _mm256_set1_ps(partial->min), maxVec = _mm256_set1_ps(partial->max);
+    __m256d shiftVec = _mm256_set1_pd(shift);
+    __m256d sumLow = _mm256_setzero_pd(), sumHigh = _mm256_setzero_pd();
+    __m256d squaresLow = _mm256_setzero_pd(), squaresHigh = _mm256_setzero_pd();
+    size_t index = 0;
+
+    for(; index + 8 <= count; index += 8)
+    {
+        __m256 x = _mm256_loadu_ps(values + index);
+        minVec = _mm256_min_ps(x, minVec); //the second operand is kept when 'x' is NaN
+        maxVec = _mm256_max_ps(x, maxVec);
+
+        __m256d low = _mm256_sub_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(x)), shiftVec);
+        __m256d high = _mm256_sub_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(x, 1)), shiftVec);
+        sumLow = _mm256_add_pd(sumLow, low);
+        sumHigh = _mm256_add_pd(sumHigh, high);
+        squaresLow = _mm256_fmadd_pd(low, low, squaresLow);
+        squaresHigh = _mm256_fmadd_pd(high, high, squaresHigh);
+    }
+
+    float lanes[8];
+    double sums[4], squares[4];
+
+    _mm256_storeu_ps(lanes, minVec);
+    for(int lane=0; lane<8; lane++)
+    {
+        partial->min = (lanes[lane] < partial->min) ? lanes[lane] : partial->min;
+    }
+    _mm256_storeu_ps(lanes, maxVec);
+    for(int lane=0; lane<8; lane++)
+    {
+        partial->max = (lanes[lane] > partial->max) ? lanes[lane] : partial->max;
+    }
+
+    _mm256_storeu_pd(sums, _mm256_add_pd(sumLow, sumHigh));
+    _mm256_storeu_pd(squares, _mm256_add_pd(squaresLow, squaresHigh));
+    partial->shiftedSum += (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    partial->shiftedSquares += (squares[0] + squares[1]) + (squares[2] + squares[3]);
+
+    columnStatsScalar(values + index, count - index, shift, partial);
+}
+
+/**
+ * @brief AVX2 row statistics kernel, eight columns per iteration.
+ */
+__attribute__((target("avx2,fma")))
+static void rowStatsAvx2(const float *row, int cols, const double *shifts, float *mins, float *maxs,
+                         double *sums, double *squares)
+{
+    int col = 0;
+
+    for(; col + 8 <= cols; col += 8)
+    {
+        __m256 x = _mm256_loadu_ps(row + col);
+        _mm256_storeu_ps(mins + col, _mm256_min_ps(x, _mm256_loadu_ps(mins + col)));
+        _mm256_storeu_ps(maxs + col, _mm256_max_ps(x, _mm256_loadu_ps(maxs + col)));
+
+        __m256d low = _mm256_sub_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(x)), _mm256_loadu_pd(shifts + col));
+        __m256d high = _mm256_sub_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(x, 1)), _mm256_loadu_pd(shifts + col + 4));
+        _mm256_storeu_pd(sums + col, _mm256_add_pd(_mm256_loadu_pd(sums + col), low));
+        _mm256_storeu_pd(sums + col + 4, _mm256_add_pd(_mm256_loadu_pd(sums + col + 4), high));
+        _mm256_storeu_pd(squares + col, _mm256_fmadd_pd(low, low, _mm256_loadu_pd(squares + col)));
+        _mm256_storeu_pd(squares + col + 4, _mm256_fmadd_pd(high, high, _mm256_loadu_pd(squares + col + 4)));
+    }
+
+    _mm256_zeroupper(); //the SSE code of the scalar tail would otherwise pay a state transition on every row
+    rowStatsScalar(row + col, cols - col, shifts + col, mins + col, maxs + col, sums + col, squares + col);
+}
+
+/**
+ * @brief AVX-512 column statistics kernel, sixteen values per iteration with double precision sums.
+ */
+__attribute__((target("avx512f")))
+static void columnStatsAvx512(const float *values, size_t count, double shift, csvStatsPartial_t *partial)
+{
+    __m512 minVec = _mm512_set1_ps(partial->min), maxVec = _mm512_set1_ps(partial->max);
+    __m512d shiftVec = _mm512_set1_pd(shift);
+    __m512d sumLow = _mm512_setzero_pd(), sumHigh = _mm512_setzero_pd();
+    __m512d squaresLow = _mm512_setzero_pd(), squaresHigh = _mm512_setzero_pd();
+    size_t index = 0;
+
+    for(; index + 16 <= count; index += 16)
+    {
+        __m512 x = _mm512_loadu_ps(values + index);
+        minVec = _mm512_min_ps(x, minVec); //the second operand is kept when 'x' is NaN
+        maxVec = _mm512_max_ps(x, maxVec);
+
+        __m512d low = _mm512_sub_pd(_mm512_cvtps_pd(_mm512_castps512_ps256(x)), shiftVec);
+        __m512d high = _mm512_sub_pd(_mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(x), 1))),
+                                     shiftVec);
+        sumLow = _mm512_add_pd(sumLow, low);
+        sumHigh = _mm512_add_pd(sumHigh, high);
+        squaresLow = _mm512_fmadd_pd(low, low, squaresLow);
+        squaresHigh = _mm512_fmadd_pd(high, high, squaresHigh);
+    }
+
+    float lanes[16];
+
+    _mm512_storeu_ps(lanes, minVec);
+    for(int lane=0; lane<16; lane++)
+    {
+        partial->min = (lanes[lane] < partial->min) ? lanes[lane] : partial->min;
+    }
+    _mm512_storeu_ps(lanes, maxVec);
+    for(int lane=0; lane<16; lane++)
+    {
+        partial->max = (lanes[lane] > partial->max) ? lanes[lane] : partial->max;
+    }
+
+    partial->shiftedSum += _mm512_reduce_add_pd(_mm512_add_pd(sumLow, sumHigh));
+    partial->shiftedSquares += _mm512_reduce_add_pd(_mm512_add_pd(squaresLow, squaresHigh));
+
+    columnStatsScalar(values + index, count - index, shift, partial);
+}
+
+/**
+ * @brief AVX-512 row statistics kernel, sixteen columns per iteration.
+ */
+__attribute__((target("avx512f")))
+static void rowStatsAvx512(const float *row, int cols, const double *shifts, float *mins, float *maxs,
+                           double *sums, double *squares)
+{
+    int col = 0;
+
+    for(; col + 16 <= cols; col += 16)
+    {
+        __m512 x = _mm512_loadu_ps(row + col);
+        _mm512_storeu_ps(mins + col, _mm512_min_ps(x, _mm512_loadu_ps(mins + col)));
+        _mm512_storeu_ps(maxs + col, _mm512_max_ps(x, _mm512_loadu_ps(maxs + col)));
+
+        __m512d low = _mm512_sub_pd(_mm512_cvtps_pd(_mm512_castps512_ps256(x)), _mm512_loadu_pd(shifts + col));
+        __m512d high = _mm512_sub_pd(_mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(x), 1))),
+                                     _mm512_loadu_pd(shifts + col + 8));
+        _mm512_storeu_pd(sums + col, _mm512_add_pd(_mm512_loadu_pd(sums + col), low));
+        _mm512_storeu_pd(sums + col + 8, _mm512_add_pd(_mm512_loadu_pd(sums + col + 8), high));
+        _mm512_storeu_pd(squares + col, _mm512_fmadd_pd(low, low, _mm512_loadu_pd(squares + col)));
+        _mm512_storeu_pd(squares + col + 8, _mm512_fmadd_pd(high, high, _mm512_loadu_pd(squares + col + 8)));
+    }
+
+    rowStatsAvx2(row + col, cols - col, shifts + col, mins + col, maxs + col, sums + col, squares + col);
+}
+
+/**
+ * @brief AVX2 structural scan of a 64-byte block, two 32-byte compares per character class.
+ */
+__attribute__((target("avx2")))
+static void scanBlockAvx2(const char *block, char separator, csvBlockMasks_t *masks)
+{
+    __m256i low = _mm256_loadu_si256((const __m256i *)block);
+    __m256i high = _mm256_loadu_si256((const __m256i *)(block + 32));
+    __m256i separatorVec = _mm256_set1_epi8(separator);
+    __m256i quoteVec = _mm256_set1_epi8('"');
+    __m256i newlineVec = _mm256_set1_epi8('\n');
+
+    masks->separators = (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, separatorVec)) |
+                        ((uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, separatorVec)) << 32);
+    masks->quotes = (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, quoteVec)) |
+                    ((uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, quoteVec)) << 32);
+    masks->newlines = (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, newlineVec)) |
+                      ((uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, newlineVec)) << 32);
+}
+
+/**
+ * @brief AVX-512BW structural scan of a 64-byte block, one compare straight into a mask per class.
+ */
+__attribute__((target("avx512f,avx512bw")))
+static void scanBlockAvx512(const char *block, char separator, csvBlockMasks_t *masks)
+{
+    __m512i bytes = _mm512_loadu_si512((const void *)block);
+
+    masks->separators = _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8(separator));
+    masks->quotes = _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8('"'));
+    masks->newlines = _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8('\n'));
+}
+
+/**
+ * @brief PCLMULQDQ quote mask of a block, the carry-less product of the quote bits with all ones.
+ */
+__attribute__((target("pclmul")))
+static uint64_t quoteMaskClmul(uint64_t quotes)
+{
+    __m128i product = _mm_clmulepi64_si128(_mm_set_epi64x(0, (long long)quotes), _mm_set1_epi8((char)0xFF), 0);
+    uint64_t inside;
+
+    _mm_storel_epi64((__m128i *)&inside, product);
+
+    return inside;
+}
+
+/**
+ * @brief Apply a transform operation to eight values with AVX.
+ */
+__attribute__((target("avx2,fma")))
+static inline __m256 transformVectorAvx2(__m256 x, csvOp_t op, __m256 first, __m256 second)
+{
+    switch(op)
+    {
+        case CSV_OP_AFFINE:
+            return _mm256_add_ps(_mm256_mul_ps(x, first), second);
+        case CSV_OP_CLIP:
+            return _mm256_min_ps(second, _mm256_max_ps(first, x)); //the second operand is kept when 'x' is NaN
+        default:
+            return _mm256_blendv_ps(x, first, _mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+    }
+}
+
+/**
+ * @brief AVX2 column transform kernel, eight values per iteration.
+ */
+__attribute__((target("avx2,fma")))
+static void transformColumnAvx2(float *values, size_t count, csvOp_t op, float first, float second)
+{
+    __m256 firstVec = _mm256_set1_ps(first), secondVec = _mm256_set1_ps(second);
+    size_t index = 0;
+
+    for(; index + 8 <= count; index += 8)
+    {
+        _mm256_storeu_ps(values + index, transformVectorAvx2(_mm256_loadu_ps(values + index), op, firstVec, secondVec));
+    }
+
+    transformColumnScalar(values + index, count - index, op, first, second);
+}
+
+/**
+ * @brief AVX2 row transform kernel, eight columns per iteration.
+ */
+__attribute__((target("avx2,fma")))
+static void transformRowAvx2(float *row, int cols, csvOp_t op, const float *first, const float *second)
+{
+    int col = 0;
+
+    for(; col + 8 <= cols; col += 8)
+    {
+        _mm256_storeu_ps(row + col, transformVectorAvx2(_mm256_loadu_ps(row + col), op, _mm256_loadu_ps(first + col),
+                                                        _mm256_loadu_ps(second + col)));
+    }
+
+    _mm256_zeroupper(); //the SSE code of the scalar tail would otherwise pay a state transition on every row
+    transformRowScalar(row + col, cols - col, op, first + col, second + col);
+}
+
+/**
+ * @brief Apply a transform operation to sixteen values with AVX-512.
+ */
+__attribute__((target("avx512f")))
+static inline __m512 transformVectorAvx512(__m512 x, csvOp_t op, __m512 first, __m512 second)
+{
+    switch(op)
+    {
+        case CSV_OP_AFFINE:
+            return _mm512_add_ps(_mm512_mul_ps(x, first), second);
+        case CSV_OP_CLIP:
+            return _mm512_min_ps(second, _mm512_max_ps(first, x)); //the second operand is kept when 'x' is NaN
+        default:
+            return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(x, x, _CMP_UNORD_Q), x, first);
+    }
+}
+
+/**
+ * @brief AVX-512 column transform kernel, sixteen values per iteration.
+ */
+__attribute__((target("avx512f")))
+static void transformColumnAvx512(float *values, size_t count, csvOp_t op, float first, float second)
+{
+    __m512 firstVec = _mm512_set1_ps(first), secondVec = _mm512_set1_ps(second);
+    size_t index = 0;
+
+    for(; index + 16 <= count; index += 16)
+    {
+        _mm512_storeu_ps(values + index, transformVectorAvx512(_mm512_loadu_ps(values + index), op, firstVec, secondVec));
+    }
+
+    transformColumnScalar(values + index, count - index, op, first, second);
+}
+
+/**
+ * @brief AVX-512 row transform kernel, sixteen columns per iteration.
+ */
+__attribute__((target("avx512f")))
+static void transformRowAvx512(float *row, int cols, csvOp_t op, const float *first, const float *second)
+{
+    int col = 0;
+
+    for(; col + 16 <= cols; col += 16)
+    {
+        _mm512_storeu_ps(row + col, transformVectorAvx512(_mm512_loadu_ps(row + col), op, _mm512_loadu_ps(first + col),
+                                                          _mm512_loadu_ps(second + col)));
+    }
+
+    transformRowAvx2(row + col, cols - col, op, first + col, second + col);
+}
+
+static const csvKernels_t avx2Kernels = {"avx2", columnStatsAvx2, rowStatsAvx2, scanBlockAvx2, quoteMaskClmul,
+                                         transformColumnAvx2, transformRowAvx2};
+static const csvKernels_t avx512Kernels = {"avx512", columnStatsAvx512, rowStatsAvx512, scanBlockAvx512, quoteMaskClmul,
+                                           transformColumnAvx512, transformRowAvx512};
+
+#elif CSV_NEON
+
+/**
+ * @brief NEON column statistics kernel, four values per iteration with double precision sums.
+ */
+static void columnStatsNeon(const float *values, size_t count, double shift, csvStatsPartial_t *partial)
+{
+    float32x4_t minVec = vdupq_n_f32(partial->min), maxVec = vdupq_n_f32(partial->max);
+    float64x2_t shiftVec = vdupq_n_f64(shift);
+    float64x2_t sumLow = vdupq_n_f64(0.0), sumHigh = vdupq_n_f64(0.0);
+    float64x2_t squaresLow = vdupq_n_f64(0.0), squaresHigh = vdupq_n_f64(0.0);
+    size_t index = 0;
+
+    for(; index + 4 <= count; index += 4)
+    {
+        float32x4_t x = vld1q_f32(values + index);
+        minVec = vminnmq_f32(minVec, x); //minNum keeps the number when 'x' is NaN
+        maxVec = vmaxnmq_f32(maxVec, x);
+
+        float64x2_t low = vsubq_f64(vcvt_f64_f32(vget_low_f32(x)), shiftVec);
+        float64x2_t high = vsubq_f64(vcvt_high_f64_f32(x), shiftVec);
+        sumLow = vaddq_f64(sumLow, low);
+        sumHigh = vaddq_f64(sumHigh, high);
+        squaresLow = vfmaq_f64(squaresLow, low, low);
+        squaresHigh = vfmaq_f64(squaresHigh, high, high);
+    }
+
+    float minLane = vminnmvq_f32(minVec), maxLane = vmaxnmvq_f32(maxVec);
+    partial->min = (minLane < partial->min) ? minLane : partial->min;
+    partial->max = (maxLane > partial->max) ? maxLane : partial->max;
+    partial->shiftedSum += vaddvq_f64(vaddq_f64(sumLow, sumHigh));
+    partial->shiftedSquares += vaddvq_f64(vaddq_f64(squaresLow, squaresHigh));
+
+    columnStatsScalar(values + index, count - index, shift, partial);
+}
+
+/**
+ * @brief NEON row statistics kernel, four columns per iteration.
+ */
+static void rowStatsNeon(const float *row, int cols, const double *shifts, float *mins, float *maxs,
+                         double *sums, double *squares)
+{
+    int col = 0;
+
+    for(; col + 4 <= cols; col += 4)
+    {
+        float32x4_t x = vld1q_f32(row + col);
+        vst1q_f32(mins + col, vminnmq_f32(vld1q_f32(mins + col), x));
+        vst1q_f32(maxs + col, vmaxnmq_f32(vld1q_f32(maxs + col), x));
+
+        float64x2_t low = vsubq_f64(vcvt_f64_f32(vget_low_f32(x)), vld1q_f64(shifts + col));
+        float64x2_t high = vsubq_f64(vcvt_high_f64_f32(x), vld1q_f64(shifts + col + 2));
+        vst1q_f64(sums + col, vaddq_f64(vld1q_f64(sums + col), low));
+        vst1q_f64(sums + col + 2, vaddq_f64(vld1q_f64(sums + col + 2), high));
+        vst1q_f64(squares + col, vfmaq_f64(vld1q_f64(squares + col), low, low));
+        vst1q_f64(squares + col + 2, vfmaq_f64(vld1q_f64(squares + col + 2), high, high));
+    }
+
+    rowStatsScalar(row + col, cols - col, shifts + col, mins + col, maxs + col, sums + col, squares + col);
+}
+
+/**
+ * @brief Turn four 16-byte NEON compare results into one 64-bit mask.
+ */
+static uint64_t neonMovemask(uint8x16_t chunk0, uint8x16_t chunk1, uint8x16_t chunk2, uint8x16_t chunk3)
+{
+    const uint8x16_t bitWeights = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t sum0 = vpaddq_u8(vandq_u8(chunk0, bitWeights), vandq_u8(chunk1, bitWeights));
+    uint8x16_t sum1 = vpaddq_u8(vandq_u8(chunk2, bitWeights), vandq_u8(chunk3, bitWeights));
+
+    sum0 = vpaddq_u8(sum0, sum1);
+    sum0 = vpaddq_u8(sum0, sum0);
+
+    return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+}
+
+/**
+ * @brief NEON structural scan of a 64-byte block, four 16-byte compares per character class.
+ */
+static void scanBlockNeon(const char *block, char separator, csvBlockMasks_t *masks)
+{
+    const uint8_t *bytes = (const uint8_t *)block;
+    uint8x16_t chunk0 = vld1q_u8(bytes), chunk1 = vld1q_u8(bytes + 16);
+    uint8x16_t chunk2 = vld1q_u8(bytes + 32), chunk3 = vld1q_u8(bytes + 48);
+    uint8x16_t separatorVec = vdupq_n_u8((uint8_t)separator), quoteVec = vdupq_n_u8('"'), newlineVec = vdupq_n_u8('\n');
+
+    masks->separators = neonMovemask(vceqq_u8(chunk0, separatorVec), vceqq_u8(chunk1, separatorVec),
+                                     vceqq_u8(chunk2, separatorVec), vceqq_u8(chunk3, separatorVec));
+    masks->quotes = neonMovemask(vceqq_u8(chunk0, quoteVec), vceqq_u8(chunk1, quoteVec),
+                                 vceqq_u8(chunk2, quoteVec), vceqq_u8(chunk3, quoteVec));
+    masks->newlines = neonMovemask(vceqq_u8(chunk0, newlineVec), vceqq_u8(chunk1, newlineVec),
+                                   vceqq_u8(chunk2, newlineVec), vceqq_u8(chunk3, newlineVec));
+}
+
+#if defined(__ARM_FEATURE_AES)
+/**
+ * @brief PMULL quote mask of a block, the carry-less product of the quote bits with all ones.
+ */
+static uint64_t quoteMaskNeon(uint64_t quotes)
+{
+    return vgetq_lane_u64(vreinterpretq_u64_p128(vmull_p64((poly64_t)quotes, (poly64_t)~(uint64_t)0)), 0);
+}
+#else
+#define quoteMaskNeon       quoteMaskScalar     // PMULL comes with the AES extension
+#endif
+
+/**
+ * @brief Apply a transform operation to four values with NEON.
+ */
+static inline float32x4_t transformVectorNeon(float32x4_t x, csvOp_t op, float32x4_t first, float32x4_t second)
+{
+    switch(op)
+    {
+        case CSV_OP_AFFINE:
+            return vaddq_f32(vmulq_f32(x, first), second);
+        case CSV_OP_CLIP:
+            return vminq_f32(vmaxq_f32(x, first), second); //NaN propagates through both
+        default:
+            return vbslq_f32(vceqq_f32(x, x), x, first);
+    }
+}
+
+/**
+ * @brief NEON column transform kernel, four values per iteration.
+ */
+static void transformColumnNeon(float *values, size_t count, csvOp_t op, float first, float second)
+{
+    float32x4_t firstVec = vdupq_n_f32(first), secondVec = vdupq_n_f32(second);
+    size_t index = 0;
+
+    for(; index + 4 <= count; index += 4)
+    {
+        vst1q_f32(values + index, transformVectorNeon(vld1q_f32(values + index), op, firstVec, secondVec));
+    }
+
+    transformColumnScalar(values + index, count - index, op, first, second);
+}
+
+/**
+ * @brief NEON row transform kernel, four columns per iteration.
+ */
+static void transformRowNeon(float *row, int cols, csvOp_t op, const float *first, const float *second)
+{
+    int col = 0;
+
+    for(; col + 4 <= cols; col += 4)
+    {
+        vst1q_f32(row + col, transformVectorNeon(vld1q_f32(row + col), op, vld1q_f32(first + col), vld1q_f32(second + col)));
+    }
+
+    transformRowScalar(row + col, cols - col, op, first + col, second + col);
+}
+
+static const csvKernels_t neonKernels = {"neon", columnStatsNeon, rowStatsNeon, scanBlockNeon, quoteMaskNeon,
+                                         transformColumnNeon, transformRowNeon};
+
+#endif
+
+/**
+ * @brief Pick the fastest kernels the running CPU supports.
+ *
+ * The choice is made once, on first use. x86 builds check for AVX-512 and AVX2 at runtime, so a
+ * single binary runs everywhere; AArch64 builds always have NEON.
+ *
+ * @return A pointer to the kernel table to use.
+ */
+static const csvKernels_t *selectKernels(void)
+{
+    static const csvKernels_t *selected = NULL;
+
+    if(selected == NULL)
+    {
+        const csvKernels_t *kernels = &scalarKernels;
+#if CSV_X86_DISPATCH
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx2") &&
+           __builtin_cpu_supports("fma") && __builtin_cpu_supports("pclmul"))
+        {
+            kernels = &avx512Kernels;
+        }
+        else if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("pclmul"))
+        {
+            kernels = &avx2Kernels;
+        }
+#elif CSV_NEON
+        kernels = &neonKernels;
+#endif
+        selected = kernels;
+    }
+
+    return selected;
+}
+
+/**
+ * @brief Get the name of the SIMD instruction set used by the vectorized kernels.
+ *
+ * @return One of "avx512", "avx2", "neon" or "scalar".
+ */
+const char *getSimdLevel(void)
+{
+    return selectKernels()->name;
+}
+
+/**
+ * @brief Turn the partial results of a feature into its final statistics.
+ */
+static void finishFeatureStats(const csvStatsPartial_t *partial, long count, double shift, csvFeatureStats_t *stats)
+{
+    stats->count = count;
+
+    if(count == 0)
+    {
+        stats->min = stats->max = NAN;
+        stats->sum = 0.0;
+        stats->mean = stats->variance = NAN;
+        return;
+    }
+
+    double variance = (partial->shiftedSquares - partial->shiftedSum * partial->shiftedSum / count) / count;
+
+    stats->min = partial->min;
+    stats->max = partial->max;
+    stats->sum = partial->shiftedSum + shift * count;
+    stats->mean = stats->sum / count;
+    stats->variance = (variance > 0.0) ? variance : 0.0; //rounding can push a zero variance below zero
+}
+
+/**
+ * @brief Compute the statistics of a single feature stored as one contiguous array.
+ *
+ * The minimum, maximum, sum, mean and population variance are computed in a single pass with the
+ * SIMD kernels selected for the running CPU.
+ *
+ * @param values A pointer to the first value of the feature.
+ * @param count The number of values of the feature.
+ * @param stats A pointer to the statistics to fill.
+ *
+ * @code
+ *   // Example usage:
+ *   csvFeatureStats_t stats;
+ *   getColumnStats(dataFrame->columns[0], dataFrame->rows, &stats);
+ *   printf("mean: %f, variance: %f\n", stats.mean, stats.variance);
+ * @endcode
+ */
+void getColumnStats(const float *values, long count, csvFeatureStats_t *stats)
+{
+    double shift = (count > 0) ? values[0] : 0.0;
+    csvStatsPartial_t partial = {INFINITY, -INFINITY, 0.0, 0.0};
+
+    if(count > 0)
+    {
+        selectKernels()->columnStats(values, (size_t)count, shift, &partial);
+    }
+
+    finishFeatureStats(&partial, count, shift, stats);
+}
+
+/**
+ * @brief Compute the statistics of a typed column that does not hold floats, without the SIMD kernels.
+ */
+static void getTypedColumnStats(const csvData_t *df, int col, csvFeatureStats_t *stats)
+{
+    double shift = (df->rows > 0) ? readValue(df->columns[col], df->types[col], 0) : 0.0;
+    csvStatsPartial_t partial = {INFINITY, -INFINITY, 0.0, 0.0};
+
+    for(int row=0; row<df->rows; row++)
+    {
+        double value = readValue(df->columns[col], df->types[col], (size_t)row);
+        double shifted = value - shift;
+
+        partial.min = ((float)value < partial.min) ? (float)value : partial.min;
+        partial.max = ((float)value > partial.max) ? (float)value : partial.max;
+        partial.shiftedSum += shifted;
+        partial.shiftedSquares += shifted * shifted;
+    }
+
+    finishFeatureStats(&partial, df->rows, shift, stats);
+}
+
+/**
+ * @brief Compute the statistics of every feature of a data frame.
+ *
+ * This function computes the minimum, maximum, sum, mean and population variance of every feature
+ * in a single pass over the data points, whatever the layout of the data frame. Columnar data frames
+ * are reduced one column at a time; for the row layouts a whole row is folded into per-feature
+ * partial results at once, so the data points are read in memory order in both cases.
+ *
+ * NaN values are ignored by the minimum and maximum but propagate into the sum, mean and variance.
+ * Typed columns that are not floats are reduced in double precision, categorical ones over their codes.
+ *
+ * @param df A pointer to the data frame to analyze.
+ * @param stats A pointer to an array of 'df->cols' statistics to fill.
+ * @return TRUE on success, ERROR if memory could not be allocated.
+ *
+ * @code
+ *   // Example usage:
+ *   csvFeatureStats_t *stats = (csvFeatureStats_t *)malloc(sizeof(csvFeatureStats_t) * dataFrame->cols);
+ *   if (getFeatureStats(dataFrame, stats) == TRUE)
+ *   {
+ *       printf("first feature lies in [%f, %f]\n", stats[0].min, stats[0].max);
+ *   }
+ *   free(stats);
+ * @endcode
+ */
+bool_t getFeatureStats(const csvData_t *df, csvFeatureStats_t *stats)
+{
+    if(df->layout == CSV_LAYOUT_COLUMNAR)
+    {
+        for(int col=0; col<df->cols; col++)
+        {
+            if(df->types != NULL && df->types[col] != CSV_TYPE_FLOAT32)
+            {
+                getTypedColumnStats(df, col, &stats[col]);
+            }
+            else
+            {
+                getColumnStats(df->columns[col], df->rows, &stats[col]);
+            }
+        }
+        return TRUE;
+    }
+
+    size_t cols = (df->cols > 0) ? (size_t)df->cols : 1;
+    double *shifts = (double *)malloc(sizeof(double) * cols * 3);
+    float *bounds = (float *)malloc(sizeof(float) * cols * 2);
+
+    if(shifts == NULL || bounds == NULL)
+    {
+        free(shifts);
+        free(bounds);
+        return ERROR;
+    }
+
+    double *sums = shifts + cols, *squares = shifts + cols * 2;
+    float *mins = bounds, *maxs = bounds + cols;
+    const csvKernels_t *kernels = selectKernels();
+
+    for(int col=0; col<df->cols; col++)
+    {
+        shifts[col] = (df->rows > 0) ? df->dataFrame[0][col] : 0.0;
+        sums[col] = squares[col] = 0.0;
+        mins[col] = INFINITY;
+        maxs[col] = -INFINITY;
+    }
+
+    for(int row=0; row<df->rows; row++)
+    {
+        kernels->rowStats(df->dataFrame[row], df->cols, shifts, mins, maxs, sums, squares);
+    }
+
+    for(int col=0; col<df->cols; col++)
+    {
+        csvStatsPartial_t partial = {mins[col], maxs[col], sums[col], squares[col]};
+        finishFeatureStats(&partial, df->rows, shifts[col], &stats[col]);
+    }
+
+    free(shifts);
+    free(bounds);
+
+    return TRUE;
+}
+
+//COLUMN TRANSFORMS -----------------------------------------------------------
+
+/**
+ * @brief Transform task of a columnar data frame: one column, block by block.
+ *
+ * Every operation goes over a block of CSV_TRANSFORM_BLOCK values before the next one does, so the
+ * column is read and written once from memory whatever the number of operations, and the statistics
+ * of the transformed block are folded in while it is still in cache.
+ */
+static void transformColumnTask(void *arg)
+{
+    csvTransformTask_t *task = (csvTransformTask_t *)arg;
+    const csvKernels_t *kernels = selectKernels();
+    float *values = task->df->columns[task->col];
+    size_t rows = (size_t)task->df->rows;
+
+    for(size_t first=0; first<rows; first+=CSV_TRANSFORM_BLOCK)
+    {
+        size_t count = (rows - first < CSV_TRANSFORM_BLOCK) ? rows - first : CSV_TRANSFORM_BLOCK;
+
+        for(int index=0; index<task->opCount; index++)
+        {
+            const csvTransformOp_t *op = &task->ops[index];
+            kernels->transformColumn(values + first, count, op->op, op->first[task->col], op->second[task->col]);
+        }
+
+        if(task->withStats == TRUE)
+        {
+            task->shift = (first == 0) ? values[0] : task->shift;
+            kernels->columnStats(values + first, count, task->shift, &task->partial);
+        }
+    }
+}
+
+/**
+ * @brief Transform task of a row data frame: a range of rows, one whole row at a time.
+ */
+static void transformRowsTask(void *arg)
+{
+    csvTransformTask_t *task = (csvTransformTask_t *)arg;
+    const csvKernels_t *kernels = selectKernels();
+    int cols = task->df->cols;
+
+    for(long row=task->firstRow; row<task->lastRow; row++)
+    {
+        float *values = task->df->dataFrame[row];
+
+        for(int index=0; index<task->opCount; index++)
+        {
+            kernels->transformRow(values, cols, task->ops[index].op, task->ops[index].first, task->ops[index].second);
+        }
+
+        if(task->withStats == TRUE)
+        {
+            kernels->rowStats(values, cols, task->shifts, task->mins, task->maxs, task->sums, task->squares);
+        }
+    }
+}
+
+/**
+ * @brief Apply transform operations to every value of a data frame in a single pass.
+ *
+ * Columnar data frames get a task per column, the row layouts a range of rows per thread with partial
+ * statistics of their own, merged once every task is done.
+ *
+ * @param df A pointer to the data frame to transform.
+ * @param ops The operations to apply, in order, with the parameters of every column.
+ * @param opCount The number of operations, zero to only compute the statistics.
+ * @param threads The number of threads to run.
+ * @param stats A pointer to an array of 'df->cols' statistics of the transformed data frame to fill,
+ *              or NULL to skip them.
+ * @return TRUE on success, ERROR if memory could not be allocated.
+ */
+static bool_t runTransformPass(csvData_t *df, const csvTransformOp_t *ops, int opCount, int threads,
+                               csvFeatureStats_t *stats)
+{
+    bool_t columnar = (df->layout == CSV_LAYOUT_COLUMNAR) ? TRUE : FALSE;
+    size_t cols = (df->cols > 0) ? (size_t)df->cols : 1;
+    int taskCount = (columnar == TRUE) ? (int)cols : ((df->rows < threads) ? ((df->rows > 0) ? df->rows : 1) : threads);
+    csvTransformTask_t *tasks = (csvTransformTask_t *)calloc((size_t)taskCount, sizeof(csvTransformTask_t));
+    double *shifts = NULL, *sums = NULL;
+    float *bounds = NULL;
+
+    if(columnar == FALSE && stats != NULL) //partial results of every row task, shifted by the transformed first row
+    {
+        shifts = (double *)malloc(sizeof(double) * cols * (2 * (size_t)taskCount + 1));
+        bounds = (float *)malloc(sizeof(float) * cols * (2 * (size_t)taskCount + 1));
+    }
+
+    csvThreadPool_t *pool = (tasks != NULL) ? createThreadPool((taskCount < threads) ? taskCount : threads, taskCount) : NULL;
+
+    if(pool == NULL || (columnar == FALSE && stats != NULL && (shifts == NULL || bounds == NULL)))
+    {
+        if(pool != NULL)
+        {
+            destroyThreadPool(pool);
+        }
+        free(tasks);
+        free(shifts);
+        free(bounds);
+        return ERROR;
+    }
+
+    if(shifts != NULL)
+    {
+        float *firstRow = bounds + cols * 2 * (size_t)taskCount;
+
+        sums = shifts + cols;
+
+        for(int col=0; col<df->cols; col++)
+        {
+            firstRow[col] = (df->rows > 0) ? df->dataFrame[0][col] : 0.0f;
+        }
+
+        for(int index=0; df->rows > 0 && index<opCount; index++)
+        {
+            selectKernels()->transformRow(firstRow, df->cols, ops[index].op, ops[index].first, ops[index].second);
+        }
+
+        for(int col=0; col<df->cols; col++)
+        {
+            shifts[col] = firstRow[col];
+        }
+    }
+
+    for(int index=0; index<taskCount; index++)
+    {
+        csvTransformTask_t *task = &tasks[index];
+
+        task->df = df;
+        task->ops = ops;
+        task->opCount = opCount;
+        task->withStats = (stats != NULL) ? TRUE : FALSE;
+        task->partial = (csvStatsPartial_t){INFINITY, -INFINITY, 0.0, 0.0};
+
+        if(columnar == TRUE)
+        {
+            task->col = index;
+
+            if(df->types != NULL && df->types[index] != CSV_TYPE_FLOAT32)
+            {
+                continue; //only the stats of columns that do not hold floats are computed, below
+            }
+
+            submitTask(pool, transformColumnTask, task);
+            continue;
+        }
+
+        task->col = -1;
+        task->firstRow = (long)df->rows * index / taskCount;
+        task->lastRow = (long)df->rows * (index + 1) / taskCount;
+
+        if(shifts != NULL)
+        {
+            task->shifts = shifts;
+            task->sums = sums + cols * 2 * (size_t)index;
+            task->squares = task->sums + cols;
+            task->mins = bounds + cols * 2 * (size_t)index;
+            task->maxs = task->mins + cols;
+
+            for(int col=0; col<df->cols; col++)
+            {
+                task->sums[col] = task->squares[col] = 0.0;
+                task->mins[col] = INFINITY;
+                task->maxs[col] = -INFINITY;
+            }
+        }
+
+        submitTask(pool, transformRowsTask, task);
+    }
+
+    waitThreadPool(pool);
+    destroyThreadPool(pool);
+
+    for(int col=0; stats != NULL && col<df->cols; col++)
+    {
+        if(columnar == TRUE && df->types != NULL && df->types[col] != CSV_TYPE_FLOAT32)
+        {
+            getTypedColumnStats(df, col, &stats[col]);
+        }
+        else if(columnar == TRUE)
+        {
+            finishFeatureStats(&tasks[col].partial, df->rows, tasks[col].shift, &stats[col]);
+        }
+        else
+        {
+            csvStatsPartial_t partial = {INFINITY, -INFINITY, 0.0, 0.0};
+
+            for(int index=0; index<taskCount; index++) //every task shares the shifts, its sums simply add up
+            {
+                partial.min = (tasks[index].mins[col] < partial.min) ? tasks[index].mins[col] : partial.min;
+                partial.max = (tasks[index].maxs[col] > partial.max) ? tasks[index].maxs[col] : partial.max;
+                partial.shiftedSum += tasks[index].sums[col];
+                partial.shiftedSquares += tasks[index].squares[col];
+            }
+
+            finishFeatureStats(&partial, df->rows, shifts[col], &stats[col]);
+        }
+    }
+
+    free(tasks);
+    free(shifts);
+    free(bounds);
+
+    return TRUE;
+}
+
+/**
+ * @brief Derive the statistics of a feature after an affine operation from the ones before it.
+ */
+static void applyAffineToStats(csvFeatureStats_t *stats, float scale, float offset)
+{
+    float low = stats->min * scale + offset, high = stats->max * scale + offset;
+
+    stats->min = (scale < 0.0f) ? high : low;
+    stats->max = (scale < 0.0f) ? low : high;
+    stats->mean = stats->mean * scale + offset;
+    stats->sum = stats->mean * stats->count;
+    stats->variance = stats->variance * scale * scale;
+}
+
+/**
+ * @brief Check the transform steps asked for against a data frame.
+ *
+ * @return TRUE if every step can be applied, ERROR otherwise.
+ */
+static bool_t checkTransforms(const csvData_t *df, const csvTransform_t *steps, int count)
+{
+    for(int index=0; index<count; index++)
+    {
+        const csvTransform_t *step = &steps[index];
+
+        if(step->kind < CSV_TRANSFORM_NORMALIZE || step->kind > CSV_TRANSFORM_FILL_NAN)
+        {
+            fprintf(stderr, "Unknown transform %d.\n", (int)step->kind);
+            return ERROR;
+        }
+        else if(step->col < -1 || step->col >= df->cols)
+        {
+            fprintf(stderr, "Unknown transform column %d.\n", step->col);
+            return ERROR;
+        }
+        else if(step->col >= 0 && df->types != NULL && df->types[step->col] != CSV_TYPE_FLOAT32)
+        {
+            fprintf(stderr, "Column %d does not hold floats.\n", step->col);
+            return ERROR;
+        }
+        else if(step->kind == CSV_TRANSFORM_CLIP && !(step->low <= step->high))
+        {
+            fprintf(stderr, "Empty clipping range.\n");
+            return ERROR;
+        }
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Normalize, standardize, clip and fill the NaN values of the features of a data frame in place.
+ *
+ * The steps are applied in order. They are fused into as few passes over the data points as the
+ * statistics they need allow: runs of clipping and filling steps are applied together, affine steps
+ * in a row are composed into one, and the statistics a normalization or standardization needs are
+ * computed in the same pass as the steps before it. After one of them the statistics are derived
+ * instead of measured, so normalizing then standardizing reads the data points once and writes them
+ * once. Every pass runs one task per column for columnar data frames and a range of rows per thread
+ * for the row layouts, with the SIMD kernels selected for the running CPU.
+ *
+ * Like getFeatureStats(), NaN values propagate into the mean and variance, so a column holding any
+ * should have them filled before it is standardized. Columns that do not hold floats are never
+ * transformed. With HIGH_DATAFRAME_DETAIL on, the min/max feature values are kept up to date.
+ *
+ * @param df A pointer to the data frame to transform.
+ * @param steps A pointer to the transform steps to apply.
+ * @param count The number of steps.
+ * @param threads The number of threads to run, zero or less for one per online CPU.
+ * @param stats A pointer to an array of 'df->cols' statistics of the transformed data frame to fill,
+ *              or NULL. They are computed in the last pass.
+ * @return TRUE on success, ERROR if a step is invalid or memory could not be allocated. The data
+ *         frame may be partially transformed on allocation failures.
+ *
+ * @code
+ *   // Example usage:
+ *   csvTransform_t steps[] = {{CSV_TRANSFORM_FILL_NAN, -1, 0.0f, 0.0f, 0.0f},
+ *                             {CSV_TRANSFORM_STANDARDIZE, -1, 0.0f, 0.0f, 0.0f},
+ *                             {CSV_TRANSFORM_CLIP, -1, -3.0f, 3.0f, 0.0f}};
+ *   transformDataFrame(dataFrame, steps, 3, 0, NULL);
+ * @endcode
+ */
+bool_t transformDataFrame(csvData_t *df, const csvTransform_t *steps, int count, int threads, csvFeatureStats_t *stats)
+{
+    if(df == NULL || (steps == NULL && count > 0) || checkTransforms(df, steps, count) != TRUE)
+    {
+        return ERROR;
+    }
+
+    size_t cols = (df->cols > 0) ? (size_t)df->cols : 1;
+    size_t opSlots = (count > 0) ? (size_t)count : 1;
+    csvTransformOp_t *ops = (csvTransformOp_t *)malloc(sizeof(csvTransformOp_t) * opSlots);
+    float *params = (float *)malloc(sizeof(float) * cols * 2 * opSlots);
+    csvFeatureStats_t *current = (csvFeatureStats_t *)malloc(sizeof(csvFeatureStats_t) * cols);
+    int *known = (int *)calloc(cols, sizeof(int)); //0 for unknown statistics, 1 for derived, 2 for measured ones
+    int opCount = 0;
+    bool_t status = (ops != NULL && params != NULL && current != NULL && known != NULL) ? TRUE : ERROR;
+
+    threads = resolveThreadCount(threads);
+
+    for(int index=0; status == TRUE && index<count; index++)
+    {
+        const csvTransform_t *step = &steps[index];
+        bool_t scaling = (step->kind == CSV_TRANSFORM_NORMALIZE || step->kind == CSV_TRANSFORM_STANDARDIZE) ? TRUE : FALSE;
+        bool_t measure = FALSE;
+
+        for(int col=0; scaling == TRUE && col<df->cols; col++)
+        {
+            measure = ((step->col < 0 || step->col == col) && known[col] == 0) ? TRUE : measure;
+        }
+
+        if(measure == TRUE) //apply the steps so far and measure what the scaling is computed from
+        {
+            status = runTransformPass(df, ops, opCount, threads, current);
+            opCount = 0;
+
+            for(int col=0; col<df->cols; col++)
+            {
+                known[col] = 2;
+            }
+        }
+
+        csvTransformOp_t *op = &ops[opCount];
+
+        op->op = (scaling == TRUE) ? CSV_OP_AFFINE : ((step->kind == CSV_TRANSFORM_CLIP) ? CSV_OP_CLIP : CSV_OP_FILL);
+        op->first = params + cols * 2 * (size_t)opCount;
+        op->second = op->first + cols;
+
+        for(int col=0; status == TRUE && col<df->cols; col++)
+        {
+            bool_t floats = (df->types == NULL || df->types[col] == CSV_TYPE_FLOAT32) ? TRUE : FALSE;
+            bool_t selected = (step->col == col || (step->col < 0 && floats == TRUE)) ? TRUE : FALSE;
+            double scale = 1.0, offset = 0.0;
+
+            if(selected == TRUE && step->kind == CSV_TRANSFORM_NORMALIZE)
+            {
+                double range = (double)current[col].max - current[col].min;
+                scale = (range > 0.0 && isfinite(range)) ? 1.0 / range : 0.0; //constant columns become zero
+                offset = (scale != 0.0) ? -current[col].min * scale : 0.0;
+            }
+            else if(selected == TRUE && step->kind == CSV_TRANSFORM_STANDARDIZE)
+            {
+                double deviation = sqrt(current[col].variance);
+                scale = (deviation > 0.0 && isfinite(deviation)) ? 1.0 / deviation : 0.0;
+                offset = (scale != 0.0) ? -current[col].mean * scale : 0.0;
+            }
+
+            if(op->op == CSV_OP_AFFINE)
+            {
+                op->first[col] = (float)scale;
+                op->second[col] = (float)offset;
+            }
+            else if(op->op == CSV_OP_CLIP) //the identity of unselected columns: an unbounded range, NaN filled with NaN
+            {
+                op->first[col] = (selected == TRUE) ? step->low : -INFINITY;
+                op->second[col] = (selected == TRUE) ? step->high : INFINITY;
+            }
+            else
+            {
+                op->first[col] = (selected == TRUE) ? step->value : NAN;
+                op->second[col] = 0.0f;
+            }
+
+            if(selected == TRUE && op->op == CSV_OP_AFFINE && known[col] != 0)
+            {
+                applyAffineToStats(&current[col], op->first[col], op->second[col]);
+                known[col] = 1;
+            }
+            else if(selected == TRUE && op->op != CSV_OP_AFFINE)
+            {
+                known[col] = 0;
+            }
+        }
+
+        csvTransformOp_t *previous = (opCount > 0) ? &ops[opCount - 1] : NULL;
+
+        if(previous != NULL && previous->op == CSV_OP_AFFINE && op->op == CSV_OP_AFFINE)
+        {
+            for(int col=0; col<df->cols; col++) //(x * a + b) * c + d is x * (a * c) + (b * c + d)
+            {
+                previous->second[col] = previous->second[col] * op->first[col] + op->second[col];
+                previous->first[col] *= op->first[col];
+            }
+        }
+        else
+        {
+            opCount++;
+        }
+    }
+
+#if HIGH_DATAFRAME_DETAIL == 1
+    bool_t measure = (stats != NULL || (df->minFeatureValues != NULL && df->maxFeatureValues != NULL)) ? TRUE : FALSE;
+#else
+    bool_t measure = (stats != NULL) ? TRUE : FALSE;
+#endif
+    bool_t measured = (opCount == 0) ? TRUE : FALSE;
+
+    for(int col=0; col<df->cols; col++)
+    {
+        measured = (known[col] == 2) ? measured : FALSE; //derived statistics are measured again, rounding aside
+    }
+
+    if(status == TRUE && (opCount > 0 || (measure == TRUE && measured == FALSE)))
+    {
+        status = runTransformPass(df, ops, opCount, threads, (measure == TRUE) ? current : NULL);
+    }
+
+    if(status == TRUE && measure == TRUE)
+    {
+#if HIGH_DATAFRAME_DETAIL == 1
+        for(int col=0; df->minFeatureValues != NULL && df->maxFeatureValues != NULL && col<df->cols; col++)
+        {
+            df->minFeatureValues[col] = current[col].min;
+            df->maxFeatureValues[col] = current[col].max;
+        }
+#endif
+        if(stats != NULL)
+        {
+            memcpy(stats, current, sizeof(csvFeatureStats_t) * (size_t)df->cols);
+        }
+    }
+
+    free(ops);
+    free(params);
+    free(current);
+    free(known);
+
+    return status;
+}
+
+//SCAN AGGREGATES -------------------------------------------------------------
+
+/**
+ * @brief Prepare empty partial aggregates of 'cols' columns.
+ *
+ * @return TRUE on success, ERROR if memory could not be allocated.
+ *
+ * @note Every aggregator must be released with closeAggregator(), even if this function fails.
+ */
+static bool_t initAggregator(csvAggregator_t *aggregator, int cols, int bins)
+{
+    size_t slots = (cols > 0) ? (size_t)cols : 1;
+
+    aggregator->rows = 0;
+    aggregator->shifts = (double *)calloc(slots, sizeof(double));
+    aggregator->partials = (csvStatsPartial_t *)malloc(sizeof(csvStatsPartial_t) * slots);
+    aggregator->histograms = (bins > 0) ? (long *)calloc(slots * (size_t)bins, sizeof(long)) : NULL;
+
+    if(aggregator->shifts == NULL || aggregator->partials == NULL || (bins > 0 && aggregator->histograms == NULL))
+    {
+        return ERROR;
+    }
+
+    for(int col=0; col<cols; col++)
+    {
+        aggregator->partials[col] = (csvStatsPartial_t){INFINITY, -INFINITY, 0.0, 0.0};
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Release partial aggregates.
+ */
+static void closeAggregator(csvAggregator_t *aggregator)
+{
+    free(aggregator->shifts);
+    free(aggregator->partials);
+    free(aggregator->histograms);
+    memset(aggregator, 0, sizeof(csvAggregator_t));
+}
+
+/**
+ * @brief Count values into the bins of a histogram over [low, high].
+ *
+ * Values outside the bounds are counted in the closest bin, NaN values are not counted.
+ */
+static void binValues(const float *values, long count, float low, float high, int bins, long *counts)
+{
+    double scale = (high > low) ? bins / ((double)high - low) : 0.0;
+
+    for(long index=0; index<count; index++)
+    {
+        if(values[index] != values[index])
+        {
+            continue;
+        }
+
+        double position = ((double)values[index] - low) * scale;
+        counts[(position <= 0.0) ? 0 : ((position >= bins) ? bins - 1 : (int)position)]++;
+    }
+}
+
+/**
+ * @brief Fold a batch of columnar rows into partial aggregates.
+ *
+ * @param batch A pointer to the first value of the first column of the batch.
+ * @param stride The distance in floats between the first values of two columns.
+ * @param rows The number of rows of the batch.
+ */
+static void foldBatch(csvAggregator_t *aggregator, const csvAggregate_t *aggregate, const float *batch, size_t stride,
+                      long rows)
+{
+    const csvKernels_t *kernels = selectKernels();
+
+    for(int col=0; rows > 0 && col<aggregate->cols; col++)
+    {
+        const float *values = batch + (size_t)col * stride;
+
+        aggregator->shifts[col] = (aggregator->rows == 0) ? values[0] : aggregator->shifts[col];
+        kernels->columnStats(values, (size_t)rows, aggregator->shifts[col], &aggregator->partials[col]);
+
+        if(aggregator->histograms != NULL)
+        {
+            binValues(values, rows, aggregate->low[col], aggregate->high[col], aggregate->bins,
+                      aggregator->histograms + (size_t)col * aggregate->bins);
+        }
+    }
+
+    aggregator->rows += rows;
+}
+
+/**
+ * @brief Merge the partial aggregates of a thread into the total ones.
+ *
+ * Partials shifted by different values do not add up, so the count, mean and sum of squared deviations
+ * of both sides are combined instead, and the total is left shifted by its own mean.
+ */
+static void mergeAggregator(csvAggregator_t *total, const csvAggregator_t *part, int cols, int bins)
+{
+    if(part->rows == 0)
+    {
+        return;
+    }
+
+    for(int col=0; col<cols; col++)
+    {
+        const csvStatsPartial_t *from = &part->partials[col];
+        csvStatsPartial_t *into = &total->partials[col];
+
+        if(total->rows == 0)
+        {
+            *into = *from;
+            total->shifts[col] = part->shifts[col];
+            continue;
+        }
+
+        double totalRows = (double)total->rows, partRows = (double)part->rows, rows = totalRows + partRows;
+        double totalMean = total->shifts[col] + into->shiftedSum / totalRows;
+        double partMean = part->shifts[col] + from->shiftedSum / partRows;
+        double delta = partMean - totalMean;
+
+        into->shiftedSquares = (into->shiftedSquares - into->shiftedSum * into->shiftedSum / totalRows) +
+                               (from->shiftedSquares - from->shiftedSum * from->shiftedSum / partRows) +
+                               delta * delta * totalRows * partRows / rows;
+        into->shiftedSum = 0.0;
+        into->min = (from->min < into->min) ? from->min : into->min;
+        into->max = (from->max > into->max) ? from->max : into->max;
+        total->shifts[col] = totalMean + delta * partRows / rows;
+    }
+
+    for(size_t bin=0; total->histograms != NULL && bin<(size_t)cols * bins; bin++)
+    {
+        total->histograms[bin] += part->histograms[bin];
+    }
+
+    total->rows += part->rows;
+}
+
+/**
+ * @brief Aggregation task: parse the chunks handed out to the task batch by batch and fold every batch in.
+ */
+static void aggregateChunksTask(void *arg)
+{
+    csvAggregateTask_t *task = (csvAggregateTask_t *)arg;
+    size_t index;
+
+    while(task->status == TRUE && (index = __atomic_fetch_add(task->nextChunk, 1, __ATOMIC_RELAXED)) < task->chunkCount)
+    {
+        const csvChunk_t *chunk = &task->chunks[index];
+        csvData_t slice = *chunk->df;
+        const char *cursor = chunk->begin;
+
+        slice.layout = CSV_LAYOUT_COLUMNAR;
+
+        while(task->status == TRUE && cursor < chunk->end)
+        {
+            long wanted = CSV_AGGREGATE_BATCH_ROWS;
+            const char *rowsEnd = findRowsEnd(cursor, chunk->end, &wanted);
+            csvRowStorage_t storage = {(int)wanted, task->batch, CSV_AGGREGATE_BATCH_ROWS, TRUE, NULL, 0};
+
+            slice.rows = 0;
+            task->status = parseKeptRows(&slice, &storage, chunk->filter, cursor, rowsEnd);
+            foldBatch(&task->aggregator, task->aggregate, task->batch, CSV_AGGREGATE_BATCH_ROWS, slice.rows);
+            cursor = rowsEnd;
+        }
+    }
+}
+
+/**
+ * @brief Allocate the aggregates of the columns of a data frame header.
+ *
+ * @param low The lower histogram bound of every column, or NULL to leave them at zero.
+ * @param high The upper histogram bound of every column, or NULL to leave them at zero.
+ * @return A pointer to the aggregates, or NULL if memory could not be allocated.
+ */
+static csvAggregate_t *newAggregate(const csvData_t *header, int bins, const float *low, const float *high)
+{
+    csvAggregate_t *aggregate = (csvAggregate_t *)calloc(1, sizeof(csvAggregate_t));
+    size_t slots = (header->cols > 0) ? (size_t)header->cols : 1, nameBytes = 0;
+
+    if(aggregate == NULL)
+    {
+        return NULL;
+    }
+
+    for(int col=0; header->names != NULL && col<header->cols; col++)
+    {
+        nameBytes += strlen(header->names[col]) + 1;
+    }
+
+    aggregate->cols = header->cols;
+    aggregate->bins = bins;
+    aggregate->stats = (csvFeatureStats_t *)calloc(slots, sizeof(csvFeatureStats_t));
+    aggregate->low = (float *)calloc(slots * 2, sizeof(float));
+    aggregate->high = (aggregate->low != NULL) ? aggregate->low + slots : NULL;
+    aggregate->histograms = (bins > 0) ? (long *)calloc(slots * (size_t)bins, sizeof(long)) : NULL;
+    aggregate->names = (header->names != NULL) ? (char **)malloc(sizeof(char *) * slots + nameBytes) : NULL;
+
+    if(aggregate->stats == NULL || aggregate->low == NULL || (bins > 0 && aggregate->histograms == NULL) ||
+       (header->names != NULL && aggregate->names == NULL))
+    {
+        csvFreeAggregate(aggregate);
+        return NULL;
+    }
+
+    char *name = (aggregate->names != NULL) ? (char *)(aggregate->names + slots) : NULL; //the names follow their pointers
+
+    for(int col=0; col<header->cols; col++)
+    {
+        aggregate->low[col] = (low != NULL) ? low[col] : 0.0f;
+        aggregate->high[col] = (high != NULL) ? high[col] : 0.0f;
+
+        if(name != NULL)
+        {
+            aggregate->names[col] = strcpy(name, header->names[col]);
+            name += strlen(name) + 1;
+        }
+    }
+
+    return aggregate;
+}
+
+/**
+ * @brief Turn the total partial aggregates into the final ones.
+ */
+static void finishAggregate(csvAggregate_t *aggregate, const csvAggregator_t *total)
+{
+    aggregate->rows = total->rows;
+
+    for(int col=0; col<aggregate->cols; col++)
+    {
+        finishFeatureStats(&total->partials[col], total->rows, total->shifts[col], &aggregate->stats[col]);
+    }
+
+    if(total->histograms != NULL)
+    {
+        memcpy(aggregate->histograms, total->histograms, sizeof(long) * (size_t)aggregate->cols * aggregate->bins);
+    }
+}
+
+/**
+ * @brief Aggregate the data point rows of an input held in memory, on one or more threads.
+ *
+ * The rows are cut into chunks like for a parallel load. Every thread takes the next chunk that has not
+ * been folded yet, parses it CSV_AGGREGATE_BATCH_ROWS rows at a time into a batch of its own and folds
+ * the batch into its own partial aggregates, which are merged once every chunk is done.
+ *
+ * @return TRUE on success, ERROR if memory could not be allocated.
+ */
+static bool_t aggregateRange(csvData_t *df, const csvRange_t *range, const csvFilter_t *filter, int threads,
+                             csvAggregate_t *aggregate)
+{
+    size_t dataBytes = 0, targetChunks = 0, nextChunk = 0;
+    size_t chunkCount = planChunks(range, 1, threads, &targetChunks, &dataBytes);
+    bool_t split = (threads > 1 && chunkCount > 1) ? TRUE : FALSE;
+
+    chunkCount = (split == TRUE) ? chunkCount : 1;
+    threads = (split == TRUE) ? threads : 1;
+
+    csvChunk_t *chunks = (csvChunk_t *)calloc(chunkCount, sizeof(csvChunk_t));
+    csvAggregateTask_t *tasks = (csvAggregateTask_t *)calloc((size_t)threads, sizeof(csvAggregateTask_t));
+    csvThreadPool_t *pool = (chunks != NULL && tasks != NULL) ? createThreadPool(threads, (int)chunkCount) : NULL;
+    csvAggregator_t total;
+    bool_t status = (initAggregator(&total, df->cols, aggregate->bins) == TRUE && pool != NULL) ? TRUE : ERROR;
+
+    if(status == TRUE && split == TRUE)
+    {
+        splitChunks(df, range, 1, targetChunks, dataBytes, NULL, chunks, chunkCount, pool); //only the boundaries are kept
+    }
+    else if(status == TRUE)
+    {
+        chunks[0].begin = range->begin;
+        chunks[0].end = chunks[0].rangeEnd = range->end;
+    }
+
+    for(size_t index=0; status == TRUE && index<chunkCount; index++)
+    {
+        chunks[index].df = df;
+        chunks[index].filter = filter;
+    }
+
+    for(int index=0; status == TRUE && index<threads; index++)
+    {
+        tasks[index].chunks = chunks;
+        tasks[index].chunkCount = chunkCount;
+        tasks[index].nextChunk = &nextChunk;
+        tasks[index].aggregate = aggregate;
+        tasks[index].batch = (float *)malloc(sizeof(float) * CSV_AGGREGATE_BATCH_ROWS * ((df->cols > 0) ? df->cols : 1));
+        tasks[index].status = (tasks[index].batch != NULL) ? initAggregator(&tasks[index].aggregator, df->cols, aggregate->bins) : ERROR;
+        status = tasks[index].status;
+    }
+
+    for(int index=0; status == TRUE && index<threads; index++)
+    {
+        submitTask(pool, aggregateChunksTask, &tasks[index]);
+    }
+
+    if(pool != NULL)
+    {
+        waitThreadPool(pool);
+        destroyThreadPool(pool);
+    }
+
+    for(int index=0; tasks != NULL && index<threads; index++)
+    {
+        status = (status == TRUE && tasks[index].status == TRUE) ? TRUE : ERROR;
+
+        if(status == TRUE)
+        {
+            mergeAggregator(&total, &tasks[index].aggregator, df->cols, aggregate->bins);
+        }
+
+        closeAggregator(&tasks[index].aggregator);
+        free(tasks[index].batch);
+    }
+
+    if(status == TRUE)
+    {
+        finishAggregate(aggregate, &total);
+    }
+
+    closeAggregator(&total);
+    free(tasks);
+    free(chunks);
+
+    return status;
+}
+
+/**
+ * @brief Set the histogram bounds of every column of an aggregate to the range of its values.
+ */
+static void setHistogramBounds(csvAggregate_t *aggregate)
+{
+    for(int col=0; col<aggregate->cols; col++)
+    {
+        bool_t empty = (aggregate->stats[col].min <= aggregate->stats[col].max) ? FALSE : TRUE; //no rows, or only NaN values
+        aggregate->low[col] = (empty == TRUE) ? 0.0f : aggregate->stats[col].min;
+        aggregate->high[col] = (empty == TRUE) ? 0.0f : aggregate->stats[col].max;
+    }
+}
+
+/**
+ * @brief Aggregate an input that can not be memory mapped, batch by batch on the calling thread.
+ */
+static csvAggregate_t *aggregateStream(const csvOptions_t *options, int fd, int bins, const float *low, const float *high)
+{
+    csvOptions_t streamed = *options;
+
+    streamed.fd = fd;
+    streamed.layout = CSV_LAYOUT_COLUMNAR; //batches come out one column after the other
+
+    csvBatchReader_t *reader = openBatchReader(&streamed);
+    csvAggregate_t *aggregate = (reader != NULL) ? newAggregate(getBatchHeader(reader), bins, low, high) : NULL;
+    int cols = (aggregate != NULL) ? aggregate->cols : 0;
+    float *batch = (float *)malloc(sizeof(float) * CSV_AGGREGATE_BATCH_ROWS * ((cols > 0) ? cols : 1));
+    csvAggregator_t total;
+    bool_t status = (initAggregator(&total, cols, bins) == TRUE && aggregate != NULL && batch != NULL) ? TRUE : ERROR;
+    long rows;
+
+    while(status == TRUE && (rows = nextBatch(reader, batch, CSV_AGGREGATE_BATCH_ROWS)) != 0)
+    {
+        status = (rows > 0) ? TRUE : ERROR;
+
+        if(status == TRUE)
+        {
+            foldBatch(&total, aggregate, batch, CSV_AGGREGATE_BATCH_ROWS, rows);
+        }
+    }
+
+    if(status == TRUE)
+    {
+        finishAggregate(aggregate, &total);
+    }
+
+    closeAggregator(&total);
+    free(batch);
+
+    if(reader != NULL)
+    {
+        closeBatchReader(reader);
+    }
+
+    if(status != TRUE)
+    {
+        csvFreeAggregate(aggregate);
+        return NULL;
+    }
+
+    return aggregate;
+}
+
+/**
+ * @brief Compute the aggregates of every column of a '.csv' input without loading it.
+ *
+ * The rows are parsed a batch of CSV_AGGREGATE_BATCH_ROWS rows at a time and folded into the count,
+ * minimum, maximum, sum, mean, population variance and histogram of every column before the next
+ * batch is parsed over them, so memory use only grows with the number of columns. Memory mapped
+ * inputs are aggregated on 'options->threads' threads with partial aggregates of their own, merged
+ * at the end; pipes and other inputs that can not be mapped are aggregated on the calling thread.
+ * So are '.gz' and '.zst' files, decompressed as they are read, and read twice if the histogram bounds
+ * are the range of their columns.
+ *
+ * Like getFeatureStats(), NaN values are ignored by the minimum and maximum but propagate into the
+ * sum, mean and variance; they are never counted in a histogram. The delimiter, header, projection
+ * and row filter of the options are honored, every column is aggregated as floats whatever its type.
+ *
+ * @param options A pointer to the loader options, or NULL for the defaults.
+ * @param bins The number of histogram bins of every column, zero to skip the histograms.
+ * @param low The lower bound of the histogram of every column, after any projection. With NULL bounds
+ *            the histograms span the range of every column, which a mapped input is read twice for.
+ * @param high The upper bound of the histogram of every column. Values outside [low, high] are
+ *             counted in the first or last bin.
+ * @return A pointer to the aggregates, or NULL on failure.
+ *
+ * @note Every aggregate must be released with csvFreeAggregate().
+ *
+ * @code
+ *   // Example usage:
+ *   csvAggregate_t *aggregate = aggregateCsv(&options, 0, NULL, NULL);
+ *   printf("%ld rows, first mean %f\n", aggregate->rows, aggregate->stats[0].mean);
+ *   csvFreeAggregate(aggregate);
+ * @endcode
+ */
+csvAggregate_t *aggregateCsv(const csvOptions_t *options, int bins, const float *low, const float *high)
+{
+    csvOptions_t defaults;
+
+    if(options == NULL)
+    {
+        initCsvOptions(&defaults);
+        options = &defaults;
+    }
+
+    if(bins < 0 || (low == NULL) != (high == NULL))
+    {
+        fprintf(stderr, "Invalid histogram bounds.\n");
+        return NULL;
+    }
+
+    const char *delim = (options->delim != NULL && options->delim[0] != '\0') ? options->delim : CSV_DELIM;
+    int fd = (options->buffer != NULL) ? -1 : options->fd;
+    csvInput_t input;
+    csvRange_t range = {options->buffer, (options->buffer != NULL) ? options->buffer + options->bufferSize : NULL};
+
+    memset(&input, 0, sizeof(input));
+
+    if(options->buffer == NULL && fd < 0 && (fd = open((options->path != NULL) ? options->path : CSV_PATH, O_RDONLY)) < 0)
+    {
+        fprintf(stderr, "Could not open the file.\n");
+        return NULL;
+    }
+
+    bool_t mapped = (options->buffer == NULL) ? mapInput(fd, &input, NULL) : FALSE;
+    bool_t compressed = (mapped == TRUE && detectCodec((const unsigned char *)input.data, input.size) != CSV_CODEC_NONE) ? TRUE : FALSE;
+
+    if(options->buffer == NULL && (mapped == FALSE || compressed == TRUE)) //compressed files are decompressed as they are streamed
+    {
+        off_t start = (off_t)(input.mappingSize - input.size);
+        csvAggregate_t *aggregate = NULL;
+
+        closeInput(&input);
+
+        if(bins > 0 && low == NULL && compressed == TRUE) //a first pass finds the range of every column, then the file is read again
+        {
+            csvAggregate_t *bounds = aggregateStream(options, fd, 0, NULL, NULL);
+
+            if(bounds != NULL && lseek(fd, start, SEEK_SET) == start)
+            {
+                setHistogramBounds(bounds);
+                aggregate = aggregateStream(options, fd, bins, bounds->low, bounds->high);
+            }
+
+            csvFreeAggregate(bounds);
+        }
+        else if(bins > 0 && low == NULL)
+        {
+            fprintf(stderr, "Histograms of an input that can not be mapped need bounds.\n");
+        }
+        else
+        {
+            aggregate = aggregateStream(options, fd, bins, low, high);
+        }
+
+        if(fd != options->fd)
+        {
+            close(fd);
+        }
+
+        return aggregate;
+    }
+
+    if(fd >= 0 && fd != options->fd)
+    {
+        close(fd);
+    }
+
+    if(options->buffer != NULL) //borrowed, closeInput() leaves it alone
+    {
+        input.data = options->buffer;
+        input.size = options->bufferSize;
+    }
+
+    bool_t plain = decompressInput(&input, options->threads);
+
+    range.begin = input.data;
+    range.end = (plain != ERROR) ? input.data + input.size : input.data;
+
+    csvData_t *df = newDataFrame(delim, CSV_LAYOUT_COLUMNAR, options->allocator);
+    csvAggregate_t *aggregate = NULL;
+    csvFilter_t filter;
+    bool_t status = (df != NULL && plain != ERROR) ? TRUE : ERROR;
+
+    memset(&filter, 0, sizeof(filter));
+
+    if(status == TRUE)
+    {
+        range.begin = parseRangeHeader(df, range.begin, range.end, options->header);
+        status = (range.begin != NULL && initFilter(df, options, &filter) != ERROR) ? projectColumns(df, options) : ERROR;
+    }
+
+    if(status == TRUE && bins > 0 && low == NULL) //a first pass finds the range of every column
+    {
+        aggregate = newAggregate(df, 0, NULL, NULL);
+        status = (aggregate != NULL) ? aggregateRange(df, &range, (filter.test != NULL) ? &filter : NULL,
+                                                      resolveThreadCount(options->threads), aggregate) : ERROR;
+
+        if(status == TRUE)
+        {
+            setHistogramBounds(aggregate);
+        }
+
+        csvAggregate_t *bounded = (status == TRUE) ? newAggregate(df, bins, aggregate->low, aggregate->high) : NULL;
+
+        csvFreeAggregate(aggregate);
+        aggregate = bounded;
+        status = (aggregate != NULL) ? status : ERROR;
+    }
+    else if(status == TRUE)
+    {
+        aggregate = newAggregate(df, bins, low, high);
+        status = (aggregate != NULL) ? TRUE : ERROR;
+    }
+
+    if(status == TRUE)
+    {
+        status = aggregateRange(df, &range, (filter.test != NULL) ? &filter : NULL, resolveThreadCount(options->threads), aggregate);
+    }
+
+    closeFilter(&filter);
+    closeInput(&input);
+    csvFree(df);
+
+    if(status != TRUE)
+    {
+        csvFreeAggregate(aggregate);
+        return NULL;
+    }
+
+    return aggregate;
+}
+
+/**
+ * @brief Release the aggregates of aggregateCsv().
+ */
+void csvFreeAggregate(csvAggregate_t *aggregate)
+{
+    if(aggregate == NULL)
+    {
+        return;
+    }
+
+    free(aggregate->names);
+    free(aggregate->stats);
+    free(aggregate->low);
+    free(aggregate->histograms);
+    free(aggregate);
+}
+
+//BINARY EXPORT ---------------------------------------------------------------
+
+#define CSV_ARROW_MAGIC         ("ARROW1")
+#define CSV_ARROW_VERSION       (4)     //MetadataVersion V5, the current version of the IPC format
+#define CSV_ARROW_HEADER_SCHEMA (1)     //MessageHeader union members
+#define CSV_ARROW_HEADER_DICTIONARY (2)
+#define CSV_ARROW_HEADER_BATCH  (3)
+#define CSV_ARROW_TYPE_INT      (2)     //Type union members
+#define CSV_ARROW_TYPE_FLOAT    (3)
+#define CSV_ARROW_TYPE_UTF8     (5)
+
+/**
+ * @brief Check whether the host stores integers least significant byte first.
+ */
+static bool_t isLittleEndian(void)
+{
+    const uint16_t probe = 1;
+
+    return (*(const unsigned char *)&probe == 1) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Get the size in bytes of the data points of a column.
+ */
+static size_t columnElementSize(const csvData_t *df, int col)
+{
+    return (df->types != NULL) ? typeSize(df->types[col]) : sizeof(float);
+}
+
+/**
+ * @brief Round a size up to the next multiple of CSV_ALIGNMENT, the padding of every exported buffer.
+ */
+static size_t alignedSize(size_t size)
+{
+    return (size + CSV_ALIGNMENT - 1) / CSV_ALIGNMENT * CSV_ALIGNMENT;
+}
+
+/**
+ * @brief Write a list of buffers to a file descriptor in as few writev() calls as the system allows.
+ *
+ * @param vectors The buffers to write, in order. They are moved forward over the bytes written.
+ * @return TRUE if every byte has been written, ERROR otherwise.
+ */
+static bool_t writeVectors(int fd, struct iovec *vectors, size_t count)
+{
+    long limit = sysconf(_SC_IOV_MAX);
+    size_t batch = (limit > 0) ? (size_t)limit : 16; //_XOPEN_IOV_MAX, the least any system allows
+    size_t first = 0;
+
+    while(first < count)
+    {
+        int vectorCount = (int)((count - first < batch) ? count - first : batch);
+        ssize_t written = writev(fd, vectors + first, vectorCount);
+        size_t before = first;
+
+        if(written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else if(written < 0)
+        {
+            return ERROR;
+        }
+
+        size_t left = (size_t)written;
+
+        while(first < count && left >= vectors[first].iov_len) //empty buffers are passed over here too
+        {
+            left -= vectors[first].iov_len;
+            first++;
+        }
+
+        if(first < count)
+        {
+            vectors[first].iov_base = (char *)vectors[first].iov_base + left;
+            vectors[first].iov_len -= left;
+        }
+
+        if(written == 0 && first == before)
+        {
+            return ERROR;
+        }
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Create a file and write a list of buffers to it, the file is removed again if that fails.
+ */
+static bool_t writeVectorFile(const char *path, struct iovec *vectors, size_t count)
+{
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    bool_t status = (fd >= 0) ? writeVectors(fd, vectors, count) : ERROR;
+
+    if(fd >= 0 && close(fd) != 0)
+    {
+        status = ERROR;
+    }
+
+    if(status != TRUE)
+    {
+        fprintf(stderr, "Could not write the file %s.\n", path);
+
+        if(fd >= 0)
+        {
+            unlink(path);
+        }
+    }
+
+    return status;
+}
+
+/**
+ * @brief Write a data frame as a NumPy '.npy' array of shape (rows, cols).
+ *
+ * The data points go straight from the storage of the data frame to the file through writev(), without
+ * being copied or converted: the rows of the row layouts in C order, the columns of a columnar data
+ * frame in Fortran order. Buffers that follow each other in memory are merged, so a contiguous data
+ * frame is written with a single system call. Typed data frames keep the type of their columns, which
+ * must then all be of one numeric type.
+ *
+ * @param df A pointer to the data frame to write.
+ * @param path The path of the '.npy' file to create.
+ * @return TRUE if the file has been written, ERROR otherwise.
+ *
+ * @code
+ *   // Example usage, 'numpy.load("points.npy")' then has the shape (rows, cols):
+ *   writeNpy(df, "points.npy");
+ * @endcode
+ */
+bool_t writeNpy(const csvData_t *df, const char *path)
+{
+    static const char *const descriptors[] = {"f4", "f8", "i1", "i2", "i4", "i8"}; //in the order of csvType_t
+    csvType_t type = (df->types != NULL && df->cols > 0) ? df->types[0] : CSV_TYPE_FLOAT32;
+    bool_t columnar = (df->layout == CSV_LAYOUT_COLUMNAR) ? TRUE : FALSE;
+
+    for(int col=0; df->types != NULL && col<df->cols; col++)
+    {
+        type = (df->types[col] == type) ? type : CSV_TYPE_CATEGORY; //mixed types fail like categories do
+    }
+
+    if(type == CSV_TYPE_CATEGORY || type == CSV_TYPE_AUTO)
+    {
+        fprintf(stderr, "Only columns of a single numeric type can be written as an array.\n");
+        return ERROR;
+    }
+
+    char header[256];
+    char byteOrder = (type == CSV_TYPE_INT8) ? '|' : (isLittleEndian() == TRUE) ? '<' : '>';
+    int length = 10 + snprintf(header + 10, sizeof(header) - 10, "{'descr': '%c%s', 'fortran_order': %s, 'shape': (%d, %d), }",
+                               byteOrder, descriptors[type], (columnar == TRUE) ? "True" : "False", df->rows, df->cols);
+
+    while((length + 1) % CSV_ALIGNMENT != 0) //the data starts on a CSV_ALIGNMENT boundary
+    {
+        header[length++] = ' ';
+    }
+
+    header[length++] = '\n';
+    memcpy(header, "\x93NUMPY\x01\x00", 8); //format version 1.0
+    header[8] = (char)((length - 10) & 0xFF);
+    header[9] = (char)((length - 10) >> 8);
+
+    int blocks = (columnar == TRUE) ? df->cols : df->rows;
+    size_t blockSize = columnElementSize(df, 0) * (size_t)((columnar == TRUE) ? df->rows : df->cols);
+    struct iovec *vectors = (struct iovec *)malloc(sizeof(struct iovec) * ((size_t)blocks + 1));
+    size_t count = 1;
+
+    if(vectors == NULL)
+    {
+        return ERROR;
+    }
+
+    vectors[0] = (struct iovec){header, (size_t)length};
+
+    for(int block=0; blockSize > 0 && block<blocks; block++)
+    {
+        char *start = (columnar == TRUE) ? (char *)df->columns[block] : (char *)df->dataFrame[block];
+
+        if(count > 1 && (char *)vectors[count - 1].iov_base + vectors[count - 1].iov_len == start)
+        {
+            vectors[count - 1].iov_len += blockSize; //adjacent in memory, such as the rows of a contiguous data frame
+        }
+        else
+        {
+            vectors[count++] = (struct iovec){start, blockSize};
+        }
+    }
+
+    bool_t status = writeVectorFile(path, vectors, count);
+
+    free(vectors);
+
+    return status;
+}
+
+/**
+ * @brief Append bytes to a builder, at a position 'shift' bytes short of a multiple of 'alignment'.
+ *
+ * The bytes are zeroed, and so is the padding in front of them.
+ *
+ * @return The position of the bytes, zero if memory could not be allocated.
+ */
+static size_t flatReserve(csvFlatBuilder_t *builder, size_t size, size_t alignment, size_t shift)
+{
+    size_t position = builder->size;
+
+    while((position + shift) % alignment != 0)
+    {
+        position++;
+    }
+
+    if(builder->failed == FALSE && position + size > builder->capacity)
+    {
+        size_t capacity = (builder->capacity > 0) ? builder->capacity * 2 : 1024;
+        capacity = (capacity > position + size) ? capacity : position + size;
+        unsigned char *grown = (unsigned char *)realloc(builder->bytes, capacity);
+
+        builder->failed = (grown != NULL) ? FALSE : TRUE;
+        builder->bytes = (grown != NULL) ? grown : builder->bytes;
+        builder->capacity = (grown != NULL) ? capacity : builder->capacity;
+    }
+
+    if(builder->failed == TRUE)
+    {
+        return 0;
+    }
+
+    memset(builder->bytes + builder->size, 0, position + size - builder->size);
+    builder->size = position + size;
+
+    return position;
+}
+
+/**
+ * @brief Store an integer of 'size' bytes at a position of a builder, least significant byte first.
+ */
+static void flatInt(csvFlatBuilder_t *builder, size_t at, uint64_t value, size_t size)
+{
+    for(size_t byte=0; builder->failed == FALSE && byte<size; byte++)
+    {
+        builder->bytes[at + byte] = (unsigned char)(value >> (8 * byte));
+    }
+}
+
+/**
+ * @brief Store the offset from a field to a table, vector or string placed after it.
+ */
+static void flatLink(csvFlatBuilder_t *builder, size_t at, size_t target)
+{
+    flatInt(builder, at, (uint64_t)(target - at), 4);
+}
+
+/**
+ * @brief Append a flatbuffer table, preceded by its vtable, with room for its fields.
+ *
+ * The fields are laid out from the largest to the smallest so that every one of them is aligned.
+ * Tables are appended before what they point to, the unsigned offsets of flatbuffers always
+ * point forward.
+ *
+ * @param fieldCount The number of fields of the table in its schema, at most eight.
+ * @param sizes The size of every field in schema order: 1, 2, 4 or 8 bytes, 4 for offsets, zero if it is left out.
+ * @param slots Set to the position of every field, zero for those left out.
+ * @return The position of the table.
+ */
+static size_t flatTable(csvFlatBuilder_t *builder, int fieldCount, const unsigned char *sizes, size_t *slots)
+{
+    size_t offsets[8] = {0};
+    size_t inlineSize = 4; //the table starts with the offset back to its vtable
+    bool_t wide = FALSE;
+
+    for(size_t size=8; size>=1; size/=2)
+    {
+        for(int field=0; field<fieldCount; field++)
+        {
+            offsets[field] = (sizes[field] == size) ? inlineSize : offsets[field];
+            inlineSize += (sizes[field] == size) ? size : 0;
+            wide = (sizes[field] == size && size == 8) ? TRUE : wide;
+        }
+    }
+
+    size_t vtable = flatReserve(builder, 4 + 2 * (size_t)fieldCount, 2, 0);
+    size_t table = flatReserve(builder, inlineSize, (wide == TRUE) ? 8 : 4, (wide == TRUE) ? 4 : 0);
+
+    flatInt(builder, vtable, 4 + 2 * (size_t)fieldCount, 2);
+    flatInt(builder, vtable + 2, inlineSize, 2);
+    flatInt(builder, table, table - vtable, 4);
+
+    for(int field=0; field<fieldCount; field++)
+    {
+        flatInt(builder, vtable + 4 + 2 * (size_t)field, offsets[field], 2);
+        slots[field] = (offsets[field] > 0) ? table + offsets[field] : 0;
+    }
+
+    return table;
+}
+
+/**
+ * @brief Append a flatbuffer vector of 'count' zeroed elements, which start at its position plus four.
+ */
+static size_t flatVector(csvFlatBuilder_t *builder, size_t count, size_t elementSize, size_t alignment)
+{
+    size_t vector = flatReserve(builder, 4 + count * elementSize, (alignment > 4) ? alignment : 4, (alignment > 4) ? 4 : 0);
+
+    flatInt(builder, vector, count, 4);
+
+    return vector;
+}
+
+/**
+ * @brief Append a flatbuffer string.
+ */
+static size_t flatString(csvFlatBuilder_t *builder, const char *text)
+{
+    size_t length = strlen(text);
+    size_t string = flatReserve(builder, 4 + length + 1, 4, 0);
+
+    flatInt(builder, string, length, 4);
+
+    if(builder->failed == FALSE)
+    {
+        memcpy(builder->bytes + string + 4, text, length);
+    }
+
+    return string;
+}
+
+/**
+ * @brief Append an Arrow 'Int' type table.
+ */
+static size_t flatArrowInt(csvFlatBuilder_t *builder, int bitWidth)
+{
+    static const unsigned char sizes[] = {4, 1}; //bitWidth, is_signed
+    size_t slots[2];
+    size_t table = flatTable(builder, 2, sizes, slots);
+
+    flatInt(builder, slots[0], (uint64_t)bitWidth, 4);
+    flatInt(builder, slots[1], 1, 1);
+
+    return table;
+}
+
+/**
+ * @brief Append the Arrow 'Field' table of a column.
+ */
+static size_t flatArrowField(csvFlatBuilder_t *builder, const csvData_t *df, int col)
+{
+    csvType_t type = (df->types != NULL) ? df->types[col] : CSV_TYPE_FLOAT32;
+    bool_t category = (type == CSV_TYPE_CATEGORY) ? TRUE : FALSE;
+    bool_t real = (type == CSV_TYPE_FLOAT32 || type == CSV_TYPE_FLOAT64) ? TRUE : FALSE;
+    const unsigned char sizes[] = {4, 1, 1, 4, (category == TRUE) ? 4 : 0, 4}; //name, nullable, type, dictionary, children
+    size_t slots[6];
+    char generated[32];
+
+    snprintf(generated, sizeof(generated), "feature_%d", col);
+
+    size_t field = flatTable(builder, 6, sizes, slots);
+
+    flatLink(builder, slots[0], flatString(builder, (df->names != NULL) ? df->names[col] : generated));
+    flatInt(builder, slots[1], 1, 1);
+    flatInt(builder, slots[2], (category == TRUE) ? CSV_ARROW_TYPE_UTF8 : (real == TRUE) ? CSV_ARROW_TYPE_FLOAT : CSV_ARROW_TYPE_INT, 1);
+
+    if(category == TRUE) //the values are strings, the codes are their int32 dictionary indices
+    {
+        static const unsigned char encodingSizes[] = {8, 4}; //id, indexType
+        size_t encodingSlots[2];
+
+        flatLink(builder, slots[3], flatTable(builder, 0, NULL, NULL));
+
+        size_t encoding = flatTable(builder, 2, encodingSizes, encodingSlots);
+
+        flatLink(builder, slots[4], encoding);
+        flatInt(builder, encodingSlots[0], (uint64_t)col, 8); //dictionaries are numbered by column
+        flatLink(builder, encodingSlots[1], flatArrowInt(builder, 32));
+    }
+    else if(real == TRUE)
+    {
+        static const unsigned char floatSizes[] = {2}; //precision
+        size_t floatSlot;
+        size_t table = flatTable(builder, 1, floatSizes, &floatSlot);
+
+        flatLink(builder, slots[3], table);
+        flatInt(builder, floatSlot, (type == CSV_TYPE_FLOAT32) ? 1 : 2, 2); //SINGLE or DOUBLE
+    }
+    else
+    {
+        flatLink(builder, slots[3], flatArrowInt(builder, (int)typeSize(type) * 8));
+    }
+
+    flatLink(builder, slots[5], flatVector(builder, 0, 4, 4));
+
+    return field;
+}
+
+/**
+ * @brief Append the Arrow 'Schema' table of a data frame, one field per column.
+ */
+static size_t flatArrowSchema(csvFlatBuilder_t *builder, const csvData_t *df)
+{
+    static const unsigned char sizes[] = {2, 4}; //endianness, fields
+    size_t slots[2];
+    size_t schema = flatTable(builder, 2, sizes, slots);
+    size_t fields = flatVector(builder, (size_t)df->cols, 4, 4);
+
+    flatInt(builder, slots[0], (isLittleEndian() == TRUE) ? 0 : 1, 2);
+    flatLink(builder, slots[1], fields);
+
+    for(int col=0; col<df->cols; col++)
+    {
+        flatLink(builder, fields + 4 + 4 * (size_t)col, flatArrowField(builder, df, col));
+    }
+
+    return schema;
+}
+
+/**
+ * @brief Append the Arrow 'RecordBatch' table of a batch of arrays.
+ *
+ * @param nodes The length and null count of every array.
+ * @param buffers The offset into the message body and the length of every buffer of the arrays.
+ */
+static size_t flatArrowBatch(csvFlatBuilder_t *builder, int64_t length, const int64_t *nodes, size_t nodeCount,
+                             const int64_t *buffers, size_t bufferCount)
+{
+    static const unsigned char sizes[] = {8, 4, 4}; //length, nodes, buffers
+    size_t slots[3];
+    size_t batch = flatTable(builder, 3, sizes, slots);
+    size_t nodeVector = flatVector(builder, nodeCount, 16, 8);
+    size_t bufferVector = flatVector(builder, bufferCount, 16, 8);
+
+    flatInt(builder, slots[0], (uint64_t)length, 8);
+    flatLink(builder, slots[1], nodeVector);
+    flatLink(builder, slots[2], bufferVector);
+
+    for(size_t index=0; index<nodeCount * 2; index++)
+    {
+        flatInt(builder, nodeVector + 4 + 8 * index, (uint64_t)nodes[index], 8);
+    }
+
+    for(size_t index=0; index<bufferCount * 2; index++)
+    {
+        flatInt(builder, bufferVector + 4 + 8 * index, (uint64_t)buffers[index], 8);
+    }
+
+    return batch;
+}
+
+/**
+ * @brief Start an Arrow 'Message', the root table of a fresh builder.
+ *
+ * @return The position of its header field, which the caller points at the header table.
+ */
+static size_t flatArrowMessage(csvFlatBuilder_t *builder, int headerType, int64_t bodyLength)
+{
+    static const unsigned char sizes[] = {2, 1, 4, 8}; //version, header type, header, bodyLength
+    size_t slots[4];
+    size_t root = flatReserve(builder, 4, 8, 0);
+    size_t message = flatTable(builder, 4, sizes, slots);
+
+    flatLink(builder, root, message);
+    flatInt(builder, slots[0], CSV_ARROW_VERSION, 2);
+    flatInt(builder, slots[1], (uint64_t)headerType, 1);
+    flatInt(builder, slots[3], (uint64_t)bodyLength, 8);
+
+    return slots[2];
+}
+
+/**
+ * @brief Append an encapsulated message to the bytes of a file: a continuation marker, the length of
+ *        the metadata padded to 8 bytes, then the metadata.
+ *
+ * @return The number of bytes appended, the metaDataLength of the message in the file footer.
+ */
+static size_t appendArrowMessage(csvFlatBuilder_t *file, csvFlatBuilder_t *message)
+{
+    size_t length = (message->size + 7) / 8 * 8;
+    size_t start = flatReserve(file, 8 + length, 8, 0);
+
+    flatInt(file, start, 0xFFFFFFFFu, 4);
+    flatInt(file, start + 4, length, 4);
+
+    if(file->failed == FALSE && message->failed == FALSE)
+    {
+        memcpy(file->bytes + start + 8, message->bytes, message->size);
+    }
+
+    file->failed = (message->failed == TRUE) ? TRUE : file->failed;
+    free(message->bytes);
+    memset(message, 0, sizeof(csvFlatBuilder_t));
+
+    return 8 + length;
+}
+
+/**
+ * @brief Write a data frame as an Arrow IPC file, the format of '.arrow' and Feather V2 files.
+ *
+ * The file holds the schema, one dictionary batch per CSV_TYPE_CATEGORY column and a single record
+ * batch with one array per column. The metadata is built in memory and the columns of a columnar
+ * data frame go straight from its storage to the file, the whole file being written with writev()
+ * and no copy of the data points. The row layouts are gathered into columns first. Category codes
+ * of empty fields are written as nulls, every other array has no validity bitmap.
+ *
+ * @param df A pointer to the data frame to write.
+ * @param path The path of the Arrow file to create.
+ * @return TRUE if the file has been written, ERROR otherwise.
+ *
+ * @code
+ *   // Example usage, 'pyarrow.ipc.open_file("points.arrow").read_all()' then reads it back:
+ *   writeArrowIpc(df, "points.arrow");
+ * @endcode
+ */
+bool_t writeArrowIpc(const csvData_t *df, const char *path)
+{
+    static const char padding[CSV_ALIGNMENT] = {0};
+    int cols = df->cols, categories = 0;
+    size_t rows = (size_t)df->rows, scratchSize = 0;
+
+    for(int col=0; col<cols; col++)
+    {
+        bool_t category = (df->types != NULL && df->types[col] == CSV_TYPE_CATEGORY) ? TRUE : FALSE;
+        categories += (category == TRUE) ? 1 : 0;
+        scratchSize += (category == TRUE) ? alignedSize((rows + 7) / 8) : 0; //validity bitmap of the codes
+    }
+
+    scratchSize += (df->layout != CSV_LAYOUT_COLUMNAR) ? sizeof(float) * rows * (size_t)cols : 0;
+
+    int64_t *nodes = (int64_t *)calloc((size_t)cols * 2 + 2, sizeof(int64_t));
+    int64_t *buffers = (int64_t *)calloc((size_t)cols * 4 + 6, sizeof(int64_t));
+    int64_t *blocks = (int64_t *)calloc((size_t)categories * 3 + 3, sizeof(int64_t)); //offset, metadata and body length
+    struct iovec *vectors = (struct iovec *)calloc((size_t)cols * 4 + 2, sizeof(struct iovec));
+    char *scratch = (char *)malloc((scratchSize > 0) ? scratchSize : 1);
+    csvFlatBuilder_t file, message, footer;
+    bool_t status = (nodes != NULL && buffers != NULL && blocks != NULL && vectors != NULL && scratch != NULL) ? TRUE : ERROR;
+
+    memset(&file, 0, sizeof(file));
+    memset(&message, 0, sizeof(message));
+    memset(&footer, 0, sizeof(footer));
+
+    //SCHEMA AND DICTIONARIES -------------------------------------------------
+
+    size_t start = flatReserve(&file, 8, 8, 0);
+
+    if(file.failed == FALSE)
+    {
+        memcpy(file.bytes + start, CSV_ARROW_MAGIC, 6);
+    }
+
+    size_t header = flatArrowMessage(&message, CSV_ARROW_HEADER_SCHEMA, 0); //the root table comes first
+
+    flatLink(&message, header, flatArrowSchema(&message, df));
+    (void)appendArrowMessage(&file, &message);
+
+    for(int col=0, dictionary=0; status == TRUE && col<cols; col++)
+    {
+        if(df->types == NULL || df->types[col] != CSV_TYPE_CATEGORY)
+        {
+            continue;
+        }
+
+        const csvDictionary_t *values = &df->dictionaries[col];
+        size_t offsetsSize = sizeof(int32_t) * ((size_t)values->count + 1), textSize = 0;
+
+        for(int code=0; code<values->count; code++)
+        {
+            textSize += strlen(values->values[code]);
+        }
+
+        int64_t node[2] = {values->count, 0};
+        int64_t dictionaryBuffers[6] = {0, 0, 0, (int64_t)offsetsSize, (int64_t)alignedSize(offsetsSize), (int64_t)textSize};
+        size_t bodyLength = alignedSize(offsetsSize) + alignedSize(textSize);
+        static const unsigned char sizes[] = {8, 4}; //id, data
+        size_t slots[2];
+
+        header = flatArrowMessage(&message, CSV_ARROW_HEADER_DICTIONARY, (int64_t)bodyLength);
+
+        size_t table = flatTable(&message, 2, sizes, slots);
+
+        flatLink(&message, header, table);
+        flatInt(&message, slots[0], (uint64_t)col, 8);
+        flatLink(&message, slots[1], flatArrowBatch(&message, values->count, node, 1, dictionaryBuffers, 3));
+
+        blocks[3 * dictionary] = (int64_t)file.size;
+        blocks[3 * dictionary + 1] = (int64_t)appendArrowMessage(&file, &message);
+        blocks[3 * dictionary + 2] = (int64_t)bodyLength;
+        dictionary++;
+
+        size_t body = flatReserve(&file, bodyLength, 8, 0); //the strings are copied, they are not stored in one block
+        int32_t offset = 0;
+
+        for(int code=0; file.failed == FALSE && code<=values->count; code++)
+        {
+            memcpy(file.bytes + body + sizeof(int32_t) * (size_t)code, &offset, sizeof(int32_t));
+
+            if(code < values->count)
+            {
+                size_t length = strlen(values->values[code]);
+                memcpy(file.bytes + body + alignedSize(offsetsSize) + (size_t)offset, values->values[code], length);
+                offset += (int32_t)length;
+            }
+        }
+    }
+
+    //RECORD BATCH ------------------------------------------------------------
+
+    size_t vectorCount = 1, bodyLength = 0;
+    char *cursor = scratch;
+
+    for(int col=0; status == TRUE && col<cols; col++)
+    {
+        size_t valuesSize = columnElementSize(df, col) * rows;
+        const char *values = (df->layout == CSV_LAYOUT_COLUMNAR) ? (const char *)df->columns[col] : cursor;
+        int64_t nulls = 0;
+
+        if(df->layout != CSV_LAYOUT_COLUMNAR) //gathered out of the rows
+        {
+            for(size_t row=0; row<rows; row++)
+            {
+                ((float *)cursor)[row] = df->dataFrame[row][col];
+            }
+
+            cursor += valuesSize;
+        }
+
+        buffers[4 * col] = (int64_t)bodyLength; //no validity bitmap, zero bytes long
+        buffers[4 * col + 1] = 0;
+
+        if(df->types != NULL && df->types[col] == CSV_TYPE_CATEGORY)
+        {
+            const int32_t *codes = (const int32_t *)(const void *)df->columns[col];
+            unsigned char *bitmap = (unsigned char *)cursor;
+            size_t bitmapSize = (rows + 7) / 8;
+
+            memset(bitmap, 0, alignedSize(bitmapSize));
+
+            for(size_t row=0; row<rows; row++)
+            {
+                bitmap[row / 8] |= (codes[row] >= 0) ? (unsigned char)(1u << (row % 8)) : 0;
+                nulls += (codes[row] < 0) ? 1 : 0;
+            }
+
+            if(nulls > 0)
+            {
+                buffers[4 * col + 1] = (int64_t)bitmapSize;
+                vectors[vectorCount++] = (struct iovec){bitmap, alignedSize(bitmapSize)};
+                bodyLength += alignedSize(bitmapSize);
+                cursor += alignedSize(bitmapSize);
+            }
+        }
+
+        nodes[2 * col] = (int64_t)rows;
+        nodes[2 * col + 1] = nulls;
+        buffers[4 * col + 2] = (int64_t)bodyLength;
+        buffers[4 * col + 3] = (int64_t)valuesSize;
+        vectors[vectorCount++] = (struct iovec){(void *)values, valuesSize};
+        vectors[vectorCount++] = (struct iovec){(void *)padding, alignedSize(valuesSize) - valuesSize};
+        bodyLength += alignedSize(valuesSize);
+    }
+
+    header = flatArrowMessage(&message, CSV_ARROW_HEADER_BATCH, (int64_t)bodyLength);
+    flatLink(&message, header, flatArrowBatch(&message, (int64_t)rows, nodes, (size_t)cols, buffers, (size_t)cols * 2));
+    blocks[3 * categories] = (int64_t)file.size;
+    blocks[3 * categories + 1] = (int64_t)appendArrowMessage(&file, &message);
+    blocks[3 * categories + 2] = (int64_t)bodyLength;
+
+    //FOOTER ------------------------------------------------------------------
+
+    static const unsigned char sizes[] = {2, 4, 4, 4}; //version, schema, dictionaries, recordBatches
+    size_t slots[4];
+    size_t root = flatReserve(&footer, 4, 8, 0);
+    size_t table = flatTable(&footer, 4, sizes, slots);
+
+    flatLink(&footer, root, table);
+    flatInt(&footer, slots[0], CSV_ARROW_VERSION, 2);
+    flatLink(&footer, slots[1], flatArrowSchema(&footer, df));
+
+    for(int list=0; list<2; list++) //the dictionary batches, then the record batch
+    {
+        size_t count = (list == 0) ? (size_t)categories : 1;
+        size_t vector = flatVector(&footer, count, 24, 8);
+        const int64_t *block = blocks + ((list == 0) ? 0 : 3 * categories);
+
+        flatLink(&footer, slots[2 + list], vector);
+
+        for(size_t index=0; index<count; index++)
+        {
+            flatInt(&footer, vector + 4 + 24 * index, (uint64_t)block[3 * index], 8);
+            flatInt(&footer, vector + 4 + 24 * index + 8, (uint64_t)block[3 * index + 1], 4);
+            flatInt(&footer, vector + 4 + 24 * index + 16, (uint64_t)block[3 * index + 2], 8);
+        }
+    }
+
+    size_t tail = flatReserve(&message, 8 + footer.size + 4 + 6, 8, 0); //end of stream marker, footer, its length, magic
+
+    flatInt(&message, tail, 0xFFFFFFFFu, 4);
+    flatInt(&message, tail + 8 + footer.size, footer.size, 4);
+
+    if(message.failed == FALSE && footer.failed == FALSE)
+    {
+        memcpy(message.bytes + tail + 8, footer.bytes, footer.size);
+        memcpy(message.bytes + tail + 8 + footer.size + 4, CSV_ARROW_MAGIC, 6);
+    }
+
+    status = (file.failed == TRUE || message.failed == TRUE || footer.failed == TRUE) ? ERROR : status;
+
+    if(status == TRUE)
+    {
+        vectors[0] = (struct iovec){file.bytes, file.size};
+        vectors[vectorCount++] = (struct iovec){message.bytes, message.size};
+        status = writeVectorFile(path, vectors, vectorCount);
+    }
+
+    free(file.bytes);
+    free(message.bytes);
+    free(footer.bytes);
+    free(scratch);
+    free(vectors);
+    free(blocks);
+    free(buffers);
+    free(nodes);
+
+    return status;
+}
+
+/**
+ * @brief Drop a reference to an export, which is freed with its data frame once the last one is gone.
+ */
+static void dropArrowExport(csvArrowExport_t *shared)
+{
+    if(__atomic_sub_fetch(&shared->references, 1, __ATOMIC_ACQ_REL) == 0)
+    {
+        csvFree(shared->df);
+        free(shared->block);
+        free(shared);
+    }
+}
+
+/**
+ * @brief Release callback of every exported array, children and dictionaries not moved away included.
+ */
+static void releaseArrowArray(struct ArrowArray *array)
+{
+    csvArrowExport_t *shared = (csvArrowExport_t *)array->private_data;
+
+    for(int64_t child=0; child<array->n_children; child++)
+    {
+        if(array->children[child]->release != NULL)
+        {
+            array->children[child]->release(array->children[child]);
+        }
+    }
+
+    if(array->dictionary != NULL && array->dictionary->release != NULL)
+    {
+        array->dictionary->release(array->dictionary);
+    }
+
+    array->release = NULL; //before the export, which may hold this very array, goes away
+    dropArrowExport(shared);
+}
+
+/**
+ * @brief Release callback of every exported schema.
+ */
+static void releaseArrowSchema(struct ArrowSchema *schema)
+{
+    csvArrowExport_t *shared = (csvArrowExport_t *)schema->private_data;
+
+    for(int64_t child=0; child<schema->n_children; child++)
+    {
+        if(schema->children[child]->release != NULL)
+        {
+            schema->children[child]->release(schema->children[child]);
+        }
+    }
+
+    if(schema->dictionary != NULL && schema->dictionary->release != NULL)
+    {
+        schema->dictionary->release(schema->dictionary);
+    }
+
+    schema->release = NULL;
+    dropArrowExport(shared);
+}
+
+/**
+ * @brief Take the next 'size' bytes of an export block, 8-byte aligned.
+ */
+static void *takeExportBytes(char **cursor, size_t size)
+{
+    void *bytes = *cursor;
+
+    *cursor += (size + 7) / 8 * 8;
+
+    return bytes;
+}
+
+/**
+ * @brief Hand a data frame over to an Arrow consumer through the Arrow C data interface.
+ *
+ * The data frame is exported as a struct array of one child array per column, with the matching
+ * schema. The children point straight at the columns of the data frame, no data point is copied:
+ * float columns are "f", typed columns keep their type and CATEGORY columns are dictionary encoded,
+ * their codes being the indices and their empty fields nulls. Data frames of a row layout are
+ * transposed to CSV_LAYOUT_COLUMNAR first.
+ *
+ * On success the data frame belongs to the export: it must no longer be used or freed by the caller,
+ * and is freed once the array and every child array moved away from it have been released. The
+ * schema holds copies of the names and can outlive it.
+ *
+ * @param df A pointer to the data frame to export.
+ * @param schema A pointer to the schema to fill.
+ * @param array A pointer to the array to fill.
+ * @return TRUE if both have been filled, ERROR otherwise, the data frame then still belongs to the caller.
+ *
+ * @code
+ *   // Example usage, handing a data frame to pyarrow.RecordBatch._import_from_c or to nanoarrow:
+ *   struct ArrowSchema schema;
+ *   struct ArrowArray array;
+ *   if(exportArrow(df, &schema, &array) == TRUE)
+ *   {
+ *       consume(&schema, &array);   // calls schema.release and array.release when done
+ *   }
+ * @endcode
+ */
+bool_t exportArrow(csvData_t *df, struct ArrowSchema *schema, struct ArrowArray *array)
+{
+    static const char *const formats[] = {"f", "g", "c", "s", "i", "l", "i"}; //in the order of csvType_t, codes are int32
+    int cols = df->cols, categories = 0;
+    size_t rows = (size_t)df->rows, arrayBytes = 8, schemaBytes = 8;
+
+    if(df->layout != CSV_LAYOUT_COLUMNAR && transposeDataFrame(df, CSV_LAYOUT_COLUMNAR) != TRUE)
+    {
+        return ERROR;
+    }
+
+    for(int col=0; col<cols; col++)
+    {
+        if(df->types != NULL && df->types[col] == CSV_TYPE_CATEGORY)
+        {
+            const csvDictionary_t *values = &df->dictionaries[col];
+
+            categories++;
+            arrayBytes += alignedSize((rows + 7) / 8) + sizeof(int32_t) * ((size_t)values->count + 1) + 8;
+
+            for(int code=0; code<values->count; code++)
+            {
+                arrayBytes += strlen(values->values[code]);
+            }
+        }
+
+        schemaBytes += ((df->names != NULL) ? strlen(df->names[col]) : 32) + 8;
+    }
+
+    size_t nodes = (size_t)cols + (size_t)categories; //children, then the dictionaries of the category columns
+    arrayBytes += nodes * (sizeof(struct ArrowArray) + sizeof(struct ArrowArray *) + 3 * sizeof(void *) + 24) + 8;
+    schemaBytes += nodes * (sizeof(struct ArrowSchema) + sizeof(struct ArrowSchema *) + 8);
+
+    csvArrowExport_t *arrays = (csvArrowExport_t *)calloc(1, sizeof(csvArrowExport_t));
+    csvArrowExport_t *schemas = (csvArrowExport_t *)calloc(1, sizeof(csvArrowExport_t));
+    char *arrayCursor = (arrays != NULL) ? (char *)(arrays->block = calloc(1, arrayBytes)) : NULL;
+    char *schemaCursor = (schemas != NULL) ? (char *)(schemas->block = calloc(1, schemaBytes)) : NULL;
+
+    if(arrayCursor == NULL || schemaCursor == NULL)
+    {
+        free((arrays != NULL) ? arrays->block : NULL);
+        free((schemas != NULL) ? schemas->block : NULL);
+        free(arrays);
+        free(schemas);
+        return ERROR;
+    }
+
+    struct ArrowArray *children = (struct ArrowArray *)takeExportBytes(&arrayCursor, sizeof(struct ArrowArray) * nodes);
+    struct ArrowArray **childPointers = (struct ArrowArray **)takeExportBytes(&arrayCursor, sizeof(struct ArrowArray *) * (size_t)cols);
+    const void **rootBuffers = (const void **)takeExportBytes(&arrayCursor, sizeof(void *));
+    struct ArrowSchema *fields = (struct ArrowSchema *)takeExportBytes(&schemaCursor, sizeof(struct ArrowSchema) * nodes);
+    struct ArrowSchema **fieldPointers = (struct ArrowSchema **)takeExportBytes(&schemaCursor, sizeof(struct ArrowSchema *) * (size_t)cols);
+
+    arrays->df = df;
+    arrays->references = (int)nodes + 1;
+    schemas->references = (int)nodes + 1;
+
+    *array = (struct ArrowArray){(int64_t)rows, 0, 0, 1, cols, rootBuffers, childPointers, NULL, releaseArrowArray, arrays};
+    *schema = (struct ArrowSchema){"+s", "", NULL, 0, cols, fieldPointers, NULL, releaseArrowSchema, schemas};
+    rootBuffers[0] = NULL;
+
+    for(int col=0, dictionary=cols; col<cols; col++)
+    {
+        csvType_t type = (df->types != NULL) ? df->types[col] : CSV_TYPE_FLOAT32;
+        const void **buffers = (const void **)takeExportBytes(&arrayCursor, 2 * sizeof(void *));
+        char *name = (char *)takeExportBytes(&schemaCursor, ((df->names != NULL) ? strlen(df->names[col]) : 31) + 1);
+
+        if(df->names != NULL)
+        {
+            strcpy(name, df->names[col]);
+        }
+        else
+        {
+            snprintf(name, 32, "feature_%d", col);
+        }
+
+        buffers[0] = NULL; //no validity bitmap, NaN is a value
+        buffers[1] = df->columns[col];
+        children[col] = (struct ArrowArray){(int64_t)rows, 0, 0, 2, 0, buffers, NULL, NULL, releaseArrowArray, arrays};
+        fields[col] = (struct ArrowSchema){formats[type], name, NULL, ARROW_FLAG_NULLABLE, 0, NULL, NULL, releaseArrowSchema, schemas};
+        childPointers[col] = &children[col];
+        fieldPointers[col] = &fields[col];
+
+        if(type != CSV_TYPE_CATEGORY)
+        {
+            continue;
+        }
+
+        const csvDictionary_t *values = &df->dictionaries[col];
+        const int32_t *codes = (const int32_t *)(const void *)df->columns[col];
+        unsigned char *bitmap = (unsigned char *)takeExportBytes(&arrayCursor, alignedSize((rows + 7) / 8));
+        const void **dictionaryBuffers = (const void **)takeExportBytes(&arrayCursor, 3 * sizeof(void *));
+        int32_t *offsets = (int32_t *)takeExportBytes(&arrayCursor, sizeof(int32_t) * ((size_t)values->count + 1));
+        char *text = arrayCursor, *textCursor = arrayCursor;
+
+        for(size_t row=0; row<rows; row++)
+        {
+            bitmap[row / 8] |= (codes[row] >= 0) ? (unsigned char)(1u << (row % 8)) : 0;
+            children[col].null_count += (codes[row] < 0) ? 1 : 0;
+        }
+
+        for(int code=0; code<values->count; code++) //the strings are copied, they are not stored in one block
+        {
+            size_t length = strlen(values->values[code]);
+
+            offsets[code] = (int32_t)(textCursor - text);
+            memcpy(textCursor, values->values[code], length);
+            textCursor += length;
+        }
+
+        offsets[values->count] = (int32_t)(textCursor - text);
+        (void)takeExportBytes(&arrayCursor, (size_t)(textCursor - text));
+
+        buffers[0] = (children[col].null_count > 0) ? bitmap : NULL;
+        dictionaryBuffers[0] = NULL;
+        dictionaryBuffers[1] = offsets;
+        dictionaryBuffers[2] = text;
+        children[dictionary] = (struct ArrowArray){values->count, 0, 0, 3, 0, dictionaryBuffers, NULL, NULL, releaseArrowArray, arrays};
+        fields[dictionary] = (struct ArrowSchema){"u", NULL, NULL, 0, 0, NULL, NULL, releaseArrowSchema, schemas};
+        children[col].dictionary = &children[dictionary];
+        fields[col].dictionary = &fields[dictionary];
+        dictionary++;
+    }
+
+    return TRUE;
+}
@@ -1,68 +1,458 @@
-/**
- * Author(s):           Arda T. Kersu
- * File name:           open_csv.c
- * Date:                1st November 2023
- *
- * Description: Header file for the library "open_csv.h" that provides easier handling and manipulation of
- *              '.csv' files with the use of C programming language. See inline comments on the source file
- *              for further details regarding any specific function of interest.
- *
- * Disclaimer: This open-source project is provided "as is" without any warranty, expressed or implied.
- *             The contributors and maintainers disclaim any an all unintended consequences or issues
- *             that may arise from its use. Users are encouraged to review and understand the software's
- *             characteristics before implementation.
- *
- *
- * Copyright @ [Arda T. Kersu]
- *
- */
-
-#ifndef DML_OPEN_CSV_H
-#define DML_OPEN_CSV_H
-
-#include <stdio.h>
-
-#define CSV_PATH        ("../data/synthetic_data_elliptical.csv")
-#define CSV_MODE        ("r")
-#define CSV_DELIM       (", ")
-
-#define HIGH_DATAFRAME_DETAIL       (0)     // turn this on to include more details about the dataframe
-
-typedef enum {FALSE, TRUE, ERROR = -1} bool_t;
-
-#if HIGH_DATAFRAME_DETAIL == 0
-typedef struct
-{
-    char *delim;
-    int rows;
-    int cols;
-    char *params;
-    long DFSize;
-    float **dataFrame;
-}csvData_t;
-
-#else
-typedef struct
-{
-    char *delim;
-    int rows;
-    int cols;
-    char *params;
-    long DFSize;
-    float *maxFeatureValues;
-    float *minFeatureValues;
-    float **dataFrame;
-}csvData_t;
-
-#endif
-
-
-
-void closeFile(FILE *filePtr);
-int *getDFsize(FILE *filePtr);
-csvData_t *createDataFrame(FILE *filePtr);
-char *trimToken(char *token);
-void getMinAndMaxFeatureValues(csvData_t *df);
-csvData_t *loadCsv(FILE *filePtr);
-
-#endif //DML_OPEN_CSV_H
+/**
+ * Author(s):           Arda T. Kersu
+ * File name:           open_csv.c
+ * Date:                1st November 2023
+ *
+ * Description: Header file for the library "open_csv.h" that provides easier handling and manipulation of
+ *              '.csv' files with the use of C programming language. See inline comments on the source file
+ *              for further details regarding any specific function of interest.
+ *
+ * Disclaimer: This open-source project is provided "as is" without any warranty, expressed or implied.
+ *             The contributors and maintainers disclaim any an all unintended consequences or issues
+ *             that may arise from its use. Users are encouraged to review and understand the software's
+ *             characteristics before implementation.
+ *
+ *
+ * Copyright @ [Arda T. Kersu]
+ *
+ */
+
+#ifndef DML_OPEN_CSV_H
+#define DML_OPEN_CSV_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define CSV_PATH        ("../data/synthetic_data_elliptical.csv")
+#define CSV_MODE        ("r")
+#define CSV_DELIM       (", ")    // the first character separates fields, the others may pad them
+
+#define CSV_INITIAL_ROW_CAPACITY    (1024)  // number of rows reserved before the row storage starts to grow
+#define CSV_READ_BLOCK_SIZE         (1 << 20)   // block size used to read inputs that can not be memory mapped
+#define CSV_MIN_CHUNK_SIZE          (1 << 20)   // smallest byte range handed to a parsing thread
+#define CSV_CHUNKS_PER_THREAD       (4)     // chunks per thread, so that uneven chunks still balance out
+
+#define HIGH_DATAFRAME_DETAIL       (0)     // turn this on to include more details about the dataframe
+
+#define CSV_LAYOUT                  (CSV_LAYOUT_ROWS)   // storage layout of the data points loaded into the dataframe
+#define CSV_ALIGNMENT               (64)    // alignment in bytes of contiguous data point storage
+#define CSV_CACHE                   (0)     // turn this on to load through a binary cache written next to the file
+#define CSV_CACHE_SUFFIX            (".ocsv")   // appended to the path of a '.csv' file to name its binary cache
+#define CSV_ARENA_CHUNK_SIZE        (1 << 16)   // size of the first arena chunk of a dataframe, later ones double
+#define CSV_TYPE_SAMPLE_ROWS        (1024)  // rows the types of CSV_TYPE_AUTO columns are inferred from
+#define CSV_STATS                   (1)     // turn this off to compile out the load statistics of 'options.stats'
+#define CSV_LAZY_INDEX_STRIDE       (64)    // rows between two entries of the row offset index of a lazy frame
+#define CSV_TRANSFORM_BLOCK         (4096)  // values of a column every transform step goes over while they are in cache
+#define CSV_AGGREGATE_BATCH_ROWS    (1024)  // rows a thread of aggregateCsv() parses at a time before folding them in
+#define CSV_GZIP                    (1)     // turn this off to build without zlib, '.gz' inputs are then read as they are
+#define CSV_ZSTD                    (0)     // turn this on to read '.zst' inputs, which needs libzstd
+
+typedef enum {FALSE, TRUE, ERROR = -1} bool_t;
+
+typedef enum
+{
+    CSV_LAYOUT_ROWS,        // one allocation per row, every row freed on its own
+    CSV_LAYOUT_CONTIGUOUS,  // all data points in one aligned block, 'dataFrame' rows point into it
+    CSV_LAYOUT_COLUMNAR     // one aligned array per feature, 'columns' point into a single block
+}csvLayout_t;
+
+typedef struct
+{
+    void *(*alloc)(size_t size, size_t alignment, void *context);   // aligned block of memory, NULL on failure
+    void (*release)(void *block, void *context);
+    void *context;          // passed to both functions as it is
+}csvAllocator_t;
+
+typedef enum
+{
+    CSV_TYPE_FLOAT32,       // 'float', the type of every data point unless column types are given
+    CSV_TYPE_FLOAT64,       // 'double'
+    CSV_TYPE_INT8,          // 'int8_t'
+    CSV_TYPE_INT16,         // 'int16_t'
+    CSV_TYPE_INT32,         // 'int32_t'
+    CSV_TYPE_INT64,         // 'int64_t'
+    CSV_TYPE_CATEGORY,      // 'int32_t' code into the dictionary of the column, -1 for empty fields
+    CSV_TYPE_AUTO           // inferred from the first rows of the input
+}csvType_t;
+
+typedef struct
+{
+    int count;              // number of distinct values of a CSV_TYPE_CATEGORY column
+    char **values;          // value of every code, in order of first appearance
+}csvDictionary_t;
+
+typedef enum
+{
+    CSV_SAMPLE_NONE,        // every row is loaded
+    CSV_SAMPLE_RESERVOIR,   // uniform random sample of the rows the filter keeps: only the sampled ones are parsed
+    CSV_SAMPLE_STRIDE       // rows at evenly spaced offsets, then filtered: only they are read from memory mapped inputs
+}csvSampling_t;
+
+typedef struct
+{
+    const char *text;       // first character of the field without its padding or quotes, not null-terminated
+    size_t length;          // number of characters, doubled quotes included, zero for empty or missing fields
+}csvToken_t;
+
+typedef bool_t (*csvRowFilter_t)(const csvToken_t *tokens, int count, void *context);  // TRUE loads the row
+
+typedef enum
+{
+    CSV_FIELD_FLOAT,        // any decimal number, converted like parseFloat() does
+    CSV_FIELD_INT           // an optionally signed integer of at most 18 digits, converted to the nearest float
+}csvFieldKind_t;
+
+typedef struct
+{
+    const char *name;       // name the parser was defined with
+    char separator;         // the first character of the deliminator of the inputs it parses
+    int cols;               // fields on every row, each one loaded as its own column
+    const char *(*parseRow)(const char *begin, const char *end, float *row, size_t stride);    // NULL if the row does not fit
+}csvRowParser_t;            // row parser for a fixed schema, see CSV_DEFINE_ROW_PARSER()
+
+typedef struct csvArena csvArena_t;     // owns all the memory of a dataframe, see csvFree()
+
+typedef struct
+{
+    char *delim;
+    int rows;
+    int cols;
+    char *params;
+    long DFSize;
+#if HIGH_DATAFRAME_DETAIL == 1
+    float *maxFeatureValues;
+    float *minFeatureValues;
+#endif
+    csvLayout_t layout;
+    float *values;          // first data point of the contiguous block, NULL for CSV_LAYOUT_ROWS
+    float **columns;        // column view for CSV_LAYOUT_COLUMNAR, NULL for the row layouts
+    float **dataFrame;      // row view for the row layouts, NULL for CSV_LAYOUT_COLUMNAR
+    csvArena_t *arena;      // every block of the dataframe, including the dataframe itself
+    char **names;           // name of every column, NULL if the input has no feature names
+    int *nameSlots;         // hash index from feature name to column, -1 marks an empty slot
+    int nameSlotCount;      // number of slots in 'nameSlots', a power of two
+    int fields;             // fields on every row of the input, equal to 'cols' unless columns are projected
+    int *fieldColumns;      // column every field is loaded into, -1 if it is skipped, NULL to load every field
+    csvType_t *types;       // type 'columns' point to for every column, NULL if every column is CSV_TYPE_FLOAT32
+    csvDictionary_t *dictionaries;  // values of every CSV_TYPE_CATEGORY column, NULL if there are no types
+    int rowCapacity;        // rows the data point storage has room for before refreshCsv() has to grow it
+    int64_t sourceOffset;   // file offset one past the last newline loaded, -1 if the dataframe can not be refreshed
+    int openRows;           // rows loaded past 'sourceOffset', from a last line with no newline yet
+    const csvRowParser_t *rowParser;    // parser specialized for the rows of the input, NULL for the generic one
+}csvData_t;
+
+typedef struct
+{
+    long count;             // number of values the statistics were computed over
+    float min;
+    float max;
+    double sum;
+    double mean;
+    double variance;        // population variance
+}csvFeatureStats_t;
+
+typedef struct
+{
+    int cols;               // number of columns aggregated, after any projection
+    char **names;           // name of every column, NULL if the input has no feature names
+    long rows;              // number of rows aggregated, after any filter
+    csvFeatureStats_t *stats;   // min, max, sum, mean and variance of every column
+    int bins;               // number of histogram bins of every column, zero without histograms
+    float *low;             // lower bound of the histogram of every column
+    float *high;            // upper bound of the histogram of every column
+    long *histograms;       // 'bins' counts of every column, one column after the other
+}csvAggregate_t;
+
+typedef enum
+{
+    CSV_TRANSFORM_NORMALIZE,    // min-max scaling into [0, 1], constant columns become zero
+    CSV_TRANSFORM_STANDARDIZE,  // zero mean and unit population variance, constant columns become zero
+    CSV_TRANSFORM_CLIP,         // clamping into ['low', 'high'], NaN values are kept
+    CSV_TRANSFORM_FILL_NAN      // NaN values replaced by 'value'
+}csvTransformKind_t;
+
+typedef struct
+{
+    csvTransformKind_t kind;
+    int col;                // column to transform, -1 for every column holding floats
+    float low;              // lower bound of CSV_TRANSFORM_CLIP
+    float high;             // upper bound of CSV_TRANSFORM_CLIP
+    float value;            // replacement of CSV_TRANSFORM_FILL_NAN
+}csvTransform_t;
+
+typedef enum
+{
+    CSV_PHASE_IO,           // opening, mapping, reading and closing the input
+    CSV_PHASE_HEADER,       // feature names, projection, filter and column types
+    CSV_PHASE_SCAN,         // structural scans alone: the row counts of a parallel load, the end of a limit
+    CSV_PHASE_PARSE,        // tokenizing the rows and converting their data points
+    CSV_PHASE_FINISH,       // merging, shrinking and caching the dataframe
+    CSV_PHASE_COUNT
+}csvPhase_t;
+
+typedef struct
+{
+    uint64_t phaseNs[CSV_PHASE_COUNT];  // wall time spent in every phase, in nanoseconds
+    uint64_t totalNs;       // wall time of the whole load
+    uint64_t bytes;         // bytes of input gone through, the binary cache for cached loads
+    uint64_t syscalls;      // open, lseek, fstat, mmap, madvise, munmap, read and close calls on the input
+    uint64_t reads;         // read() calls among them
+    uint64_t rows;          // rows loaded
+    uint64_t fields;        // fields of the rows loaded, skipped ones included
+    uint64_t allocations;   // blocks the dataframe got from its allocator
+    uint64_t allocatedBytes;    // bytes of those blocks
+    uint64_t peakBytes;     // most bytes the dataframe held at once
+}csvLoadStats_t;
+
+typedef struct
+{
+    const char *path;       // file to load when neither 'buffer' nor 'fd' are set
+    int fd;                 // open file descriptor to load from its current position, -1 if unused
+    const char *buffer;     // '.csv' data already held in memory, NULL if unused
+    size_t bufferSize;      // number of bytes in 'buffer'
+    const char *delim;      // the first character separates fields, the others may pad them
+    bool_t header;          // TRUE if the first row holds the feature names
+    int threads;            // number of parsing threads, zero for one per online CPU
+    csvLayout_t layout;     // storage layout of the data points
+    size_t readBlockSize;   // smallest block read at once from inputs that can not be memory mapped
+    const csvAllocator_t *allocator;    // where the memory of the dataframe comes from, NULL for the C library
+    bool_t cache;           // TRUE to load from, and refresh, the binary cache of the file at 'path'
+    const char *cachePath;  // path of the binary cache, NULL for 'path' followed by CSV_CACHE_SUFFIX
+    const char *const *columnNames;     // features to load, in this order, NULL to load every feature
+    const int *columnIndices;   // features to load by position from zero, used if 'columnNames' is NULL
+    int columnCount;        // number of entries in 'columnNames' or 'columnIndices'
+    const csvType_t *columnTypes;   // type of every loaded column, NULL to infer them or to load floats
+    bool_t inferTypes;      // TRUE to infer the type of every column if 'columnTypes' is NULL
+    int typeSampleRows;     // rows CSV_TYPE_AUTO columns are inferred from, zero for CSV_TYPE_SAMPLE_ROWS
+    csvRowFilter_t filter;  // decides on the raw fields of every row if it is loaded, NULL to load every row
+    void *filterContext;    // passed to 'filter' as it is
+    const char *const *filterNames;     // features 'filter' gets the fields of, in this order
+    const int *filterIndices;   // the same by position from zero, used if 'filterNames' is NULL
+    int filterCount;        // number of entries in 'filterNames' or 'filterIndices', zero for every field
+    long limit;             // stop reading once this many rows have been loaded, zero to load every row
+    csvSampling_t sampling; // how the loaded rows are sampled from the input
+    long sampleSize;        // number of rows in the sample
+    unsigned long sampleSeed;   // seed of the reservoir sample, the same seed draws the same rows
+    csvLoadStats_t *stats;  // filled with the counters of the load if CSV_STATS is on, NULL to skip them
+    const csvRowParser_t *rowParser;    // parser generated for the fixed schema of the input, NULL for the generic one
+}csvOptions_t;
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED   (1)
+#define ARROW_FLAG_NULLABLE             (2)
+#define ARROW_FLAG_MAP_KEYS_SORTED      (4)
+
+struct ArrowSchema          // the Arrow C data interface, as specified by Apache Arrow
+{
+    const char *format;
+    const char *name;
+    const char *metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema **children;
+    struct ArrowSchema *dictionary;
+    void (*release)(struct ArrowSchema *schema);
+    void *private_data;
+};
+
+struct ArrowArray
+{
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void **buffers;
+    struct ArrowArray **children;
+    struct ArrowArray *dictionary;
+    void (*release)(struct ArrowArray *array);
+    void *private_data;
+};
+
+#endif //ARROW_C_DATA_INTERFACE
+
+typedef struct csvBatchReader csvBatchReader_t;     // reads a '.csv' input in batches of rows, see openBatchReader()
+typedef struct csvLazyFrame csvLazyFrame_t;         // parses the columns of a mapped '.csv' input on first use, see openLazyFrame()
+
+
+
+void closeFile(FILE *filePtr);
+int *getDFsize(FILE *filePtr);
+csvData_t *createDataFrame(FILE *filePtr);
+char *trimToken(char *token);
+void getMinAndMaxFeatureValues(csvData_t *df);
+const char *parseFloat(const char *first, const char *last, float *value);
+csvData_t *loadCsv(FILE *filePtr);
+csvData_t *loadCsvMmap(const char *path);
+csvData_t *loadCsvParallel(const char *path, int threads);
+csvData_t *loadCsvDataset(const char *const *paths, int count, const csvOptions_t *options);
+void initCsvOptions(csvOptions_t *options);
+csvData_t *loadCsvEx(const csvOptions_t *options);
+long refreshCsv(csvData_t *df, const csvOptions_t *options);
+void csvFree(csvData_t *df);
+csvBatchReader_t *openBatchReader(const csvOptions_t *options);
+const csvData_t *getBatchHeader(const csvBatchReader_t *reader);
+long nextBatch(csvBatchReader_t *reader, float *batch, long maxRows);
+bool_t startPrefetch(csvBatchReader_t *reader, long batchRows, int depth);
+const float *acquireBatch(csvBatchReader_t *reader, long *rows);
+void closeBatchReader(csvBatchReader_t *reader);
+csvLazyFrame_t *openLazyFrame(const csvOptions_t *options);
+const csvData_t *getLazyHeader(const csvLazyFrame_t *frame);
+const float *getLazyColumn(csvLazyFrame_t *frame, int col);
+void closeLazyFrame(csvLazyFrame_t *frame);
+bool_t transposeDataFrame(csvData_t *df, csvLayout_t layout);
+const char *getSimdLevel(void);
+void getColumnStats(const float *values, long count, csvFeatureStats_t *stats);
+bool_t getFeatureStats(const csvData_t *df, csvFeatureStats_t *stats);
+bool_t transformDataFrame(csvData_t *df, const csvTransform_t *steps, int count, int threads, csvFeatureStats_t *stats);
+csvAggregate_t *aggregateCsv(const csvOptions_t *options, int bins, const float *low, const float *high);
+void csvFreeAggregate(csvAggregate_t *aggregate);
+double getDataPoint(const csvData_t *df, int row, int col);
+const char *getCategory(const csvData_t *df, int row, int col);
+int getFeatureIndex(const csvData_t *df, const char *name);
+bool_t writeNpy(const csvData_t *df, const char *path);
+bool_t writeArrowIpc(const csvData_t *df, const char *path);
+bool_t exportArrow(csvData_t *df, struct ArrowSchema *schema, struct ArrowArray *array);
+
+//FIXED SCHEMA PARSERS --------------------------------------------------------
+
+#if defined(__GNUC__)
+#define CSV_ALWAYS_INLINE           inline __attribute__((always_inline))
+#define CSV_UNROLL_FIELDS           _Pragma("GCC unroll 64")
+#else
+#define CSV_ALWAYS_INLINE           inline
+#define CSV_UNROLL_FIELDS
+#endif
+
+/**
+ * @brief Parse one row of a fixed schema, the body of every parser of CSV_DEFINE_ROW_PARSER().
+ *
+ * Every argument but the row itself is a constant of the generated parser, so once this is inlined the
+ * field loop is unrolled and the kind, padding and separator tests of every field are resolved at compile
+ * time. Only rows that fit the schema exactly are parsed: 'fields' numbers, padded by spaces or by
+ * 'padding', apart by 'separator' and ending with a newline, an optional carriage return before it, or the
+ * input. Any other row, such as one with quotes, empty or extra fields or text, is left to the generic
+ * parser of the loaders, which gives it the values it always has.
+ *
+ * @param kinds The kind of every field, or NULL if every field is a CSV_FIELD_FLOAT.
+ * @return A pointer one past the row and its newline, or NULL if the row does not fit the schema.
+ */
+static CSV_ALWAYS_INLINE const char *csvParseFixedRow(const char *cursor, const char *end, float *row, size_t stride,
+                                                      char separator, char padding, int fields, const csvFieldKind_t *kinds)
+{
+    CSV_UNROLL_FIELDS
+    for(int field=0; field<fields; field++)
+    {
+        while(cursor < end && (*cursor == ' ' || *cursor == padding))
+        {
+            cursor++;
+        }
+
+        if(cursor == end || ! ((unsigned)(*cursor - '0') < 10 || *cursor == '-' || *cursor == '+' || *cursor == '.'))
+        {
+            return NULL; //empty fields, quotes, infinities and NaNs
+        }
+
+        if(kinds != NULL && kinds[field] == CSV_FIELD_INT)
+        {
+            bool_t negative = (*cursor == '-') ? TRUE : FALSE;
+            const char *digits = cursor = (*cursor == '-' || *cursor == '+') ? cursor + 1 : cursor;
+            int64_t value = 0;
+
+            while(cursor < end && (unsigned)(*cursor - '0') < 10 && cursor - digits < 18)
+            {
+                value = value * 10 + (*cursor - '0');
+                cursor++;
+            }
+
+            if(cursor == digits || (cursor < end && ((unsigned)(*cursor - '0') < 10 || *cursor == '.' || *cursor == 'e' || *cursor == 'E')))
+            {
+                return NULL; //not an integer after all, or too long to be exact
+            }
+
+            float converted = (float)value; //correctly rounded, as parseFloat() would
+
+            row[(size_t)field * stride] = (negative == TRUE) ? -converted : converted;
+        }
+        else
+        {
+            const char *number = cursor;
+
+            cursor = parseFloat(number, end, &row[(size_t)field * stride]);
+
+            if(cursor == number)
+            {
+                return NULL;
+            }
+        }
+
+        while(cursor < end && (*cursor == ' ' || *cursor == padding))
+        {
+            cursor++;
+        }
+
+        if(field < fields - 1)
+        {
+            if(cursor == end || *cursor != separator)
+            {
+                return NULL; //missing fields
+            }
+
+            cursor++;
+        }
+    }
+
+    cursor = (cursor < end && *cursor == '\r') ? cursor + 1 : cursor;
+
+    if(cursor == end)
+    {
+        return end;
+    }
+
+    return (*cursor == '\n') ? cursor + 1 : NULL; //anything else is an extra field or text
+}
+
+/**
+ * @brief Define a row parser specialized for a fixed schema, from the kind of every field.
+ *
+ * The parser is a static 'csvRowParser_t' named 'name', to be handed to the loaders through
+ * 'options.rowParser'. The deliminator of the options must start with 'separator', the input must have
+ * exactly as many fields as kinds are listed, and every field is loaded as a float column; column
+ * projections and types can not be combined with it. Fields may be padded by spaces and by 'padding',
+ * usually the second character of the deliminator.
+ *
+ * @code
+ *   // Example usage, for rows such as "0.25, 1.5, 42":
+ *   CSV_DEFINE_ROW_PARSER(pointParser, ',', ' ', CSV_FIELD_FLOAT, CSV_FIELD_FLOAT, CSV_FIELD_INT);
+ *
+ *   options.rowParser = &pointParser;
+ *   csvData_t *df = loadCsvEx(&options);
+ * @endcode
+ */
+#define CSV_DEFINE_ROW_PARSER(name, separator, padding, ...)                                                    \
+    static const csvFieldKind_t name##Kinds[] = {__VA_ARGS__};                                                  \
+    static const char *name##Row(const char *begin, const char *end, float *row, size_t stride)                 \
+    {                                                                                                           \
+        return csvParseFixedRow(begin, end, row, stride, (separator), (padding),                                \
+                                (int)(sizeof(name##Kinds) / sizeof(name##Kinds[0])), name##Kinds);              \
+    }                                                                                                           \
+    static const csvRowParser_t name = {#name, (separator), (int)(sizeof(name##Kinds) / sizeof(name##Kinds[0])), name##Row}
+
+/**
+ * @brief Define a row parser for rows of 'cols' CSV_FIELD_FLOAT fields, see CSV_DEFINE_ROW_PARSER().
+ *
+ * @code
+ *   // Example usage, for the default ", " deliminator and 20 features:
+ *   CSV_DEFINE_FLOAT_PARSER(featureParser, ',', ' ', 20);
+ * @endcode
+ */
+#define CSV_DEFINE_FLOAT_PARSER(name, separator, padding, cols)                                                 \
+    static const char *name##Row(const char *begin, const char *end, float *row, size_t stride)                 \
+    {                                                                                                           \
+        return csvParseFixedRow(begin, end, row, stride, (separator), (padding), (cols), NULL);                 \
+    }                                                                                                           \
+    static const csvRowParser_t name = {#name, (separator), (cols), name##Row}
+
+#endif //DML_OPEN_CSV_H
@@ -0,0 +1,990 @@
+/**
+ * Author(s):           Arda T. Kersu
+ * File name:           open_csv_bench.c
+ * Date:                1st November 2023
+ *
+ * Description: Benchmark of the loaders of the library "open_csv.h". It generates a synthetic '.csv' file of
+ *              the requested size and value distribution, loads it in every loader mode and reports the
+ *              throughput, peak resident memory and dataframe allocations of each mode, one machine-readable
+ *              record per mode. Build it next to the library:
+ *
+ *                  cc -O2 -pthread open_csv_bench.c open_csv.c -lz -lm -o open_csv_bench
+ *
+ * Disclaimer: This open-source project is provided "as is" without any warranty, expressed or implied.
+ *             The contributors and maintainers disclaim any an all unintended consequences or issues
+ *             that may arise from its use. Users are encouraged to review and understand the software's
+ *             characteristics before implementation.
+ *
+ *
+ * Copyright @ [Arda T. Kersu]
+ *
+ */
+
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE     // fork(), wait4() and the other POSIX/BSD calls of the benchmark
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include "open_csv.h"
+
+#define BENCH_DEFAULT_ROWS      (1000000)   // rows of the generated file
+#define BENCH_DEFAULT_COLS      (20)        // features of the generated file
+#define BENCH_DEFAULT_REPEAT    (5)         // timed loads per mode, the best and the median are reported
+#define BENCH_DEFAULT_OUTPUT    ("open_csv_bench.csv")  // where the generated file is written
+#define BENCH_BATCH_ROWS        (4096)      // rows per batch of the batch reader mode
+#define BENCH_MAX_REPEAT        (101)
+
+typedef enum
+{
+    BENCH_DIST_UNIFORM,     // independent values, uniform in [-100, 100)
+    BENCH_DIST_NORMAL,      // independent values, normal with mean 0 and deviation 50
+    BENCH_DIST_ELLIPTICAL,  // pairs of features drawn from rotated, elongated 2D normals
+    BENCH_DIST_INTEGER      // independent integers, uniform in [-1000, 1000]
+}benchDistribution_t;
+
+typedef enum
+{
+    BENCH_FORMAT_JSON,      // one JSON object per line
+    BENCH_FORMAT_CSV        // a header line, then one line per mode
+}benchFormat_t;
+
+typedef struct
+{
+    long rows;
+    int cols;
+    benchDistribution_t distribution;
+    uint64_t seed;
+    int repeat;
+    int threads;                //threads of the parallel mode, zero for one per online CPU
+    benchFormat_t format;
+    const char *input;          //existing file to benchmark, NULL to generate one
+    const char *output;         //path of the generated file
+    const char *mode;           //only mode to run, NULL to run them all
+    bool_t keep;                //TRUE to keep the generated file
+}benchConfig_t;
+
+typedef struct
+{
+    long allocations;           //blocks the dataframe got from the allocator
+    size_t bytes;               //bytes of those blocks
+    size_t liveBytes;           //bytes allocated and not released yet
+    size_t peakBytes;           //largest 'liveBytes' seen
+}benchAllocStats_t;
+
+typedef struct
+{
+    bool_t status;              //TRUE if every timed run succeeded
+    long rows;                  //rows loaded by one run
+    int cols;                   //columns loaded by one run
+    size_t bytes;               //bytes one run goes through, the throughput is measured over them
+    double best;                //fastest run in seconds
+    double median;              //median run in seconds
+    benchAllocStats_t allocs;   //allocations of one run
+    csvLoadStats_t load;        //load statistics of the last run, zero for modes that do not go through loadCsvEx()
+}benchResult_t;
+
+typedef struct
+{
+    const char *name;
+    bool_t (*run)(const benchConfig_t *config, const csvAllocator_t *allocator, benchResult_t *result);
+}benchMode_t;
+
+static const char *distributionNames[] = {"uniform", "normal", "elliptical", "integer"};
+
+//SYNTHETIC DATA ---------------------------------------------------------------
+
+/**
+ * @brief Draw the next number of a splitmix64 random number generator.
+ */
+static uint64_t nextRandom(uint64_t *state)
+{
+    uint64_t value = (*state += 0x9e3779b97f4a7c15ull);
+
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+
+    return value ^ (value >> 31);
+}
+
+/**
+ * @brief Draw a number uniformly distributed in [0, 1).
+ */
+static double nextUniform(uint64_t *state)
+{
+    return (double)(nextRandom(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief Draw a standard normal number with the Box-Muller transform.
+ */
+static double nextNormal(uint64_t *state)
+{
+    double radius = sqrt(-2.0 * log(1.0 - nextUniform(state)));
+
+    return radius * cos(2.0 * M_PI * nextUniform(state));
+}
+
+/**
+ * @brief Fill one row of synthetic data points.
+ *
+ * Elliptical rows draw each pair of features from a 2D normal stretched along one axis and rotated by
+ * an angle of its own, around a centre of its own, like the clusters of synthetic_data_elliptical.csv.
+ */
+static void generateRow(const benchConfig_t *config, uint64_t *state, double *row)
+{
+    for(int col=0; col<config->cols; col++)
+    {
+        if(config->distribution == BENCH_DIST_UNIFORM)
+        {
+            row[col] = nextUniform(state) * 200.0 - 100.0;
+        }
+        else if(config->distribution == BENCH_DIST_NORMAL)
+        {
+            row[col] = nextNormal(state) * 50.0;
+        }
+        else if(config->distribution == BENCH_DIST_INTEGER)
+        {
+            row[col] = (double)(long)(nextRandom(state) % 2001) - 1000.0;
+        }
+        else if(col + 1 < config->cols && col % 2 == 0) //the first feature of a pair gives both
+        {
+            double angle = M_PI * (double)(col / 2) / 7.0;
+            double major = nextNormal(state) * 40.0, minor = nextNormal(state) * 8.0;
+
+            row[col] = major * cos(angle) - minor * sin(angle) + (double)(col * 5);
+            row[col + 1] = major * sin(angle) + minor * cos(angle) - (double)(col * 3);
+            col++;
+        }
+        else
+        {
+            row[col] = nextNormal(state) * 40.0; //a feature left without a pair
+        }
+    }
+}
+
+/**
+ * @brief Write a synthetic '.csv' file, feature names first, separated by CSV_DELIM.
+ *
+ * @return TRUE on success, ERROR if the file could not be written.
+ */
+static bool_t generateCsv(const benchConfig_t *config)
+{
+    FILE *file = fopen(config->output, "w");
+    double *row = (double *)malloc(sizeof(double) * config->cols);
+    uint64_t state = config->seed;
+    bool_t status = (file != NULL && row != NULL) ? TRUE : ERROR;
+
+    if(status == TRUE)
+    {
+        (void)setvbuf(file, NULL, _IOFBF, 1 << 20);
+    }
+
+    for(int col=0; status == TRUE && col<config->cols; col++)
+    {
+        fprintf(file, "%sfeature_%d", (col > 0) ? CSV_DELIM : "", col);
+    }
+
+    for(long line=0; status == TRUE && line<config->rows; line++)
+    {
+        fputc('\n', file);
+        generateRow(config, &state, row);
+
+        for(int col=0; col<config->cols; col++)
+        {
+            fprintf(file, (config->distribution == BENCH_DIST_INTEGER) ? "%s%.0f" : "%s%.6f", (col > 0) ? CSV_DELIM : "",
+                    row[col]);
+        }
+    }
+
+    if(file != NULL)
+    {
+        fputc('\n', file);
+        status = (ferror(file) != 0 || fclose(file) != 0) ? ERROR : status;
+    }
+
+    free(row);
+
+    return status;
+}
+
+//COUNTING ALLOCATOR -----------------------------------------------------------
+
+#define BENCH_ALLOC_HEADER      (64)    // room in front of every block for its size and offset, keeps CSV_ALIGNMENT
+
+/**
+ * @brief Aligned allocation that records its size in front of the block.
+ */
+static void *countingAlloc(size_t size, size_t alignment, void *context)
+{
+    benchAllocStats_t *stats = (benchAllocStats_t *)context;
+    size_t header = (alignment > BENCH_ALLOC_HEADER) ? alignment : BENCH_ALLOC_HEADER;
+    void *block = NULL;
+
+    if(posix_memalign(&block, header, header + size) != 0)
+    {
+        return NULL;
+    }
+
+    block = (char *)block + header;
+    ((size_t *)block)[-1] = header;
+    ((size_t *)block)[-2] = size;
+
+    stats->allocations++;
+    stats->bytes += size;
+    stats->liveBytes += size;
+    stats->peakBytes = (stats->liveBytes > stats->peakBytes) ? stats->liveBytes : stats->peakBytes;
+
+    return block;
+}
+
+/**
+ * @brief Release a block of countingAlloc().
+ */
+static void countingRelease(void *block, void *context)
+{
+    benchAllocStats_t *stats = (benchAllocStats_t *)context;
+
+    if(block == NULL)
+    {
+        return;
+    }
+
+    stats->liveBytes -= ((size_t *)block)[-2];
+    free((char *)block - ((size_t *)block)[-1]); //the header may be wider than BENCH_ALLOC_HEADER for wide alignments
+}
+
+//LOADER MODES -----------------------------------------------------------------
+
+/**
+ * @brief Get the time of a monotonic clock in seconds.
+ */
+static double now(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Get the size of the benchmarked file.
+ */
+static size_t inputSize(const benchConfig_t *config)
+{
+    struct stat fileStat;
+
+    return (stat(config->input, &fileStat) == 0) ? (size_t)fileStat.st_size : 0;
+}
+
+/**
+ * @brief Options every mode starts from: the benchmarked file, loaded through the counting allocator.
+ */
+static void benchOptions(const benchConfig_t *config, const csvAllocator_t *allocator, csvOptions_t *options)
+{
+    initCsvOptions(options);
+    options->path = config->input;
+    options->allocator = allocator;
+    options->cache = FALSE;
+}
+
+/**
+ * @brief Time 'repeat' loads with the given options, the dataframe of each is freed off the clock.
+ */
+static bool_t timeLoads(const benchConfig_t *config, const csvOptions_t *options, benchResult_t *result)
+{
+    double times[BENCH_MAX_REPEAT];
+    benchAllocStats_t *stats = (benchAllocStats_t *)options->allocator->context;
+    csvOptions_t timed = *options;
+
+    timed.stats = &result->load;
+
+    result->status = TRUE;
+    result->bytes = (options->buffer != NULL) ? options->bufferSize : inputSize(config);
+
+    for(int run=0; run<config->repeat; run++)
+    {
+        memset(stats, 0, sizeof(benchAllocStats_t));
+
+        double start = now();
+        csvData_t *df = loadCsvEx(&timed);
+        times[run] = now() - start;
+
+        if(df == NULL)
+        {
+            result->status = ERROR;
+            return ERROR;
+        }
+
+        result->rows = df->rows;
+        result->cols = df->cols;
+        result->allocs = *stats;
+        csvFree(df);
+    }
+
+    for(int run=1; run<config->repeat; run++) //insertion sort, there are only a few runs
+    {
+        double time = times[run];
+        int slot = run;
+
+        for(; slot > 0 && times[slot - 1] > time; slot--)
+        {
+            times[slot] = times[slot - 1];
+        }
+        times[slot] = time;
+    }
+
+    result->best = times[0];
+    result->median = times[config->repeat / 2];
+
+    return TRUE;
+}
+
+static bool_t runMmap(const benchConfig_t *config, const csvAllocator_t *allocator, benchResult_t *result)
+{
+    csvOptions_t options;
+
+    benchOptions(config, allocator, &options);
+
+    return timeLoads(config, &options, result);
+}
+
+static bool_t runParallel(const benchConfig_t *config, const csvAllocator_t *allocator, benchResult_t *result)
+{
+    csvOptions_t options;
+
+    benchOptions(config, allocator, &options);
+    options.threads = config->threads;
+
+    return timeLoads(config, &options, result);
+}
+
+static bool_t runContiguous(const benchConfig_t *config, const csvAllocator_t *allocator, benchResult_t *result)
+{
+    csvOptions_t options;
+
+    benchOptions(config, allocator, &options);
+    options.layout = CSV_LAYOUT_CONTIGUOUS;
+
+    return timeLoads(config, &options, result);
+}
+
+static bool_t runColumnar(const benchConfig_t *config, const csvAllocator_t *allocator, benchResult_t *result)
+{
+    csvOptions_t options;
+
+    benchOptions(config, allocator, &options);
+    options.layout = CSV_LAYOUT_COLUMNAR;
+
+    return timeLoads(config, &options, result);
+}
+
+static bool_t runTyped(const benchConfig_t *config, const csvAllocator_t *allocator, benchResult_t *result)
+{
+    csvOptions_t options;
+
+    benchOptions(config, allocator, &options);
+    options.inferTypes = TRUE;
+
+    return timeLoads(config, &options, result);
+}
+
+CSV_DEFINE_FLOAT_PARSER(fixed4Parser, ',', ' ', 4);
+CSV_DEFINE_FLOAT_PARSER(fixed8Parser, ',', ' ', 8);
+CSV_DEFINE_FLOAT_PARSER(fixed16Parser, ',', ' ', 16);
+CSV_DEFINE_FLOAT_PARSER(fixed20Parser, ',', ' ', 20);
+CSV_DEFINE_FLOAT_PARSER(fixed32Parser, ',', ' ', 32);
+CSV_DEFINE_FLOAT_PARSER(fixed64Parser, ',', ' ', 64);
+
+/**
+ * @brief Get the row parser generated for rows of 'cols' features, NULL if there is none.
+ */
+static const csvRowParser_t *fixedParser(int cols)
+{
+    static const csvRowParser_t *const parsers[] = {&fixed4Parser, &fixed8Parser, &fixed16Parser, &fixed20Parser,
+                                                    &fixed32Parser, &fixed64Parser};
+
+    for(size_t index=0; index<sizeof(parsers) / sizeof(parsers[0]); index++)
+    {
+        if(parsers[index]->cols == cols)
+        {
+            return parsers[index];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Load through the row parser generated for the number of columns of the file.
+ */
+static bool_t runFixed(const benchConfig_t *config, const csvAllocator_t *allocator, benchResult_t *result)
+{
+    csvOptions_t options;
+
+    benchOptions(config, allocator, &options);
+    options.rowParser = fixedParser(config->cols);
+
+    if(options.rowParser == NULL)
+    {
+        fprintf(stderr, "There is no row parser for %d columns.\n", config->cols);
+        result->status = ERROR;
+        return ERROR;
+    }
+
+    return timeLoads(config, &options, result);
+}
+
+/**
+ * @brief Parse a copy of the file already held in memory, reading it is off the clock.
+ */
+static bool_t runBuffer(const benchConfig_t *config, const csvAllocator_t *allocator, benchResult_t *result)
+{
+    csvOptions_t options;
+    size_t size = inputSize(config);
+    char *buffer = (char *)malloc((size > 0) ? size : 1);
+    FILE *file = fopen(config->input, "rb");
+    bool_t status = (buffer != NULL && file != NULL && fread(buffer, 1, size, file) == size) ? TRUE : ERROR;
+
+    if(file != NULL)
+    {
+        fclose(file);
+    }
+
+    benchOptions(config, allocator, &options);
+    options.buffer = buffer;
+    options.bufferSize = size;
+
+    status = (status == TRUE) ? timeLoads(config, &options, result) : ERROR;
+    free(buffer);
+
+    return status;
+}
+
+/**
+ * @brief Stream the file through a pipe, fed by a child process, like a decompressor or 'cat' would.
+ */
+static bool_t runStream(const benchConfig_t *config, const csvAllocator_t *allocator, benchResult_t *result)
+{
+    csvOptions_t options;
+    benchConfig_t single = *config;
+    benchResult_t run;
+    double times[BENCH_MAX_REPEAT];
+
+    benchOptions(config, allocator, &options);
+    single.repeat = 1; //a pipe can only be read once, every run gets one of its own
+    memset(result, 0, sizeof(benchResult_t));
+
+    for(int repeat=0; repeat<config->repeat; repeat++)
+    {
+        int ends[2];
+
+        if(pipe(ends) != 0)
+        {
+            return ERROR;
+        }
+
+        pid_t writer = fork();
+
+        if(writer == 0) //the writer copies the file into the pipe
+        {
+            char block[1 << 16];
+            int fd = open(config->input, O_RDONLY);
+            ssize_t count = 0;
+
+            close(ends[0]);
+            while(fd >= 0 && (count = read(fd, block, sizeof(block))) > 0)
+            {
+                for(ssize_t written = 0, step = 0; written < count; written += step)
+                {
+                    step = write(ends[1], block + written, (size_t)(count - written));
+
+                    if(step <= 0)
+                    {
+                        _exit(1);
+                    }
+                }
+            }
+            _exit((fd >= 0 && count == 0) ? 0 : 1);
+        }
+
+        close(ends[1]);
+        options.fd = ends[0];
+
+        bool_t status = (writer > 0) ? timeLoads(&single, &options, &run) : ERROR;
+
+        close(ends[0]);
+        if(writer > 0)
+        {
+            (void)waitpid(writer, NULL, 0);
+        }
+
+        if(status != TRUE)
+        {
+            result->status = ERROR;
+            return ERROR;
+        }
+
+        times[repeat] = run.best;
+    }
+
+    *result = run;
+
+    for(int repeat=1; repeat<config->repeat; repeat++)
+    {
+        double time = times[repeat];
+        int slot = repeat;
+
+        for(; slot > 0 && times[slot - 1] > time; slot--)
+        {
+            times[slot] = times[slot - 1];
+        }
+        times[slot] = time;
+    }
+
+    result->best = times[0];
+    result->median = times[config->repeat / 2];
+
+    return TRUE;
+}
+
+/**
+ * @brief Load from the binary cache, which an untimed first load writes next to the file.
+ */
+static bool_t runCache(const benchConfig_t *config, const csvAllocator_t *allocator, benchResult_t *result)
+{
+    csvOptions_t options;
+    char cachePath[4096];
+
+    benchOptions(config, allocator, &options);
+    snprintf(cachePath, sizeof(cachePath), "%s%s", config->input, CSV_CACHE_SUFFIX);
+    options.cache = TRUE;
+    options.cachePath = cachePath;
+
+    csvData_t *df = loadCsvEx(&options);
+    bool_t status = (df != NULL) ? timeLoads(config, &options, result) : ERROR;
+
+    csvFree(df);
+    (void)unlink(cachePath);
+
+    return status;
+}
+
+/**
+ * @brief Read the file in batches of BENCH_BATCH_ROWS rows into one buffer, as a training loop would.
+ */
+static bool_t runBatches(const benchConfig_t *config, const csvAllocator_t *allocator, benchResult_t *result)
+{
+    csvOptions_t options;
+    double times[BENCH_MAX_REPEAT];
+
+    benchOptions(config, allocator, &options);
+    memset(result, 0, sizeof(benchResult_t));
+    result->bytes = inputSize(config);
+
+    for(int run=0; run<config->repeat; run++)
+    {
+        double start = now();
+        csvBatchReader_t *reader = openBatchReader(&options);
+        const csvData_t *header = (reader != NULL) ? getBatchHeader(reader) : NULL;
+        float *batch = (header != NULL) ? (float *)malloc(sizeof(float) * BENCH_BATCH_ROWS * (header->cols + 1)) : NULL;
+        long rows = 0, total = 0;
+
+        while(batch != NULL && (rows = nextBatch(reader, batch, BENCH_BATCH_ROWS)) > 0)
+        {
+            total += rows;
+        }
+
+        times[run] = now() - start;
+        result->rows = total;
+        result->cols = (header != NULL) ? header->cols : 0;
+        result->status = (batch != NULL && rows == 0) ? TRUE : ERROR;
+
+        free(batch);
+        if(reader != NULL)
+        {
+            closeBatchReader(reader);
+        }
+
+        if(result->status != TRUE)
+        {
+            return ERROR;
+        }
+    }
+
+    for(int run=1; run<config->repeat; run++)
+    {
+        double time = times[run];
+        int slot = run;
+
+        for(; slot > 0 && times[slot - 1] > time; slot--)
+        {
+            times[slot] = times[slot - 1];
+        }
+        times[slot] = time;
+    }
+
+    result->best = times[0];
+    result->median = times[config->repeat / 2];
+
+    return TRUE;
+}
+
+/**
+ * @brief Compute the statistics of every feature of a columnar dataframe, loaded off the clock.
+ *
+ * The throughput of this mode is measured over the data points, not over the '.csv' file.
+ */
+static bool_t runStats(const benchConfig_t *config, const csvAllocator_t *allocator, benchResult_t *result)
+{
+    csvOptions_t options;
+    double times[BENCH_MAX_REPEAT];
+
+    benchOptions(config, allocator, &options);
+    options.layout = CSV_LAYOUT_COLUMNAR;
+    memset(result, 0, sizeof(benchResult_t));
+
+    csvData_t *df = loadCsvEx(&options);
+    csvFeatureStats_t *stats = (df != NULL) ? (csvFeatureStats_t *)malloc(sizeof(csvFeatureStats_t) * (df->cols + 1)) : NULL;
+
+    result->status = (stats != NULL) ? TRUE : ERROR;
+
+    for(int run=0; result->status == TRUE && run<config->repeat; run++)
+    {
+        double start = now();
+        result->status = getFeatureStats(df, stats);
+        times[run] = now() - start;
+    }
+
+    if(result->status == TRUE)
+    {
+        result->rows = df->rows;
+        result->cols = df->cols;
+        result->bytes = sizeof(float) * (size_t)df->rows * df->cols;
+        result->allocs = *(benchAllocStats_t *)allocator->context;
+    }
+
+    free(stats);
+    csvFree(df);
+
+    for(int run=1; result->status == TRUE && run<config->repeat; run++)
+    {
+        double time = times[run];
+        int slot = run;
+
+        for(; slot > 0 && times[slot - 1] > time; slot--)
+        {
+            times[slot] = times[slot - 1];
+        }
+        times[slot] = time;
+    }
+
+    result->best = (result->status == TRUE) ? times[0] : 0.0;
+    result->median = (result->status == TRUE) ? times[config->repeat / 2] : 0.0;
+
+    return result->status;
+}
+
+static const benchMode_t modes[] =
+{
+    {"stream", runStream},          // read() through a pipe
+    {"mmap", runMmap},              // memory mapped, one thread, the layout of CSV_LAYOUT
+    {"parallel", runParallel},      // memory mapped, several threads
+    {"buffer", runBuffer},          // already held in memory
+    {"contiguous", runContiguous},  // CSV_LAYOUT_CONTIGUOUS
+    {"columnar", runColumnar},      // CSV_LAYOUT_COLUMNAR
+    {"typed", runTyped},            // inferred column types
+    {"fixed", runFixed},            // row parser generated for a fixed schema
+    {"cache", runCache},            // binary cache sidecar
+    {"batch", runBatches},          // batch reader
+    {"stats", runStats}             // getFeatureStats() over a loaded dataframe
+};
+
+//DRIVER -----------------------------------------------------------------------
+
+/**
+ * @brief Run one mode in a child process of its own, so that its peak resident memory is its own.
+ *
+ * The child sends its stdout to /dev/null, so that stdout only carries the records of the benchmark.
+ *
+ * @param peakRss Set to the peak resident memory of the child in kilobytes.
+ * @return TRUE on success, ERROR if the mode failed.
+ */
+static bool_t runIsolated(const benchConfig_t *config, const benchMode_t *mode, benchResult_t *result, long *peakRss)
+{
+    int ends[2];
+    struct rusage usage;
+    int exitStatus = 0;
+
+    memset(result, 0, sizeof(benchResult_t));
+
+    if(pipe(ends) != 0)
+    {
+        return ERROR;
+    }
+
+    fflush(stdout);
+    pid_t child = fork();
+
+    if(child == 0)
+    {
+        benchAllocStats_t stats;
+        csvAllocator_t allocator = {countingAlloc, countingRelease, &stats};
+        int devNull = open("/dev/null", O_WRONLY);
+
+        memset(&stats, 0, sizeof(stats));
+        close(ends[0]);
+        if(devNull >= 0)
+        {
+            dup2(devNull, STDOUT_FILENO);
+        }
+
+        (void)mode->run(config, &allocator, result);
+        _exit((write(ends[1], result, sizeof(benchResult_t)) == (ssize_t)sizeof(benchResult_t)) ? 0 : 1);
+    }
+
+    close(ends[1]);
+
+    bool_t status = (child > 0 && read(ends[0], result, sizeof(benchResult_t)) == (ssize_t)sizeof(benchResult_t)) ? TRUE : ERROR;
+
+    close(ends[0]);
+    if(child > 0 && wait4(child, &exitStatus, 0, &usage) == child)
+    {
+        *peakRss = usage.ru_maxrss;
+    }
+
+    return (status == TRUE && result->status == TRUE) ? TRUE : ERROR;
+}
+
+/**
+ * @brief Print the record of one mode.
+ */
+static void printResult(const benchConfig_t *config, const char *name, const benchResult_t *result, long peakRss)
+{
+    const csvLoadStats_t *load = &result->load;
+    double megabytes = (double)result->bytes / 1e6;
+    double mbPerSecond = (result->best > 0.0) ? megabytes / result->best : 0.0;
+    double rowsPerSecond = (result->best > 0.0) ? (double)result->rows / result->best : 0.0;
+    const char *distribution = (config->input == config->output) ? distributionNames[config->distribution] : "file";
+
+    if(config->format == BENCH_FORMAT_CSV)
+    {
+        printf("%s,%s,%s,%ld,%d,%d,%zu,%.6f,%.6f,%.3f,%.1f,%ld,%ld,%zu,%zu,%.6f,%.6f,%.6f,%.6f,%.6f,%llu\n", name,
+               getSimdLevel(), distribution, result->rows, result->cols, config->threads, result->bytes, result->best,
+               result->median, mbPerSecond, rowsPerSecond, peakRss, result->allocs.allocations, result->allocs.bytes,
+               result->allocs.peakBytes, load->phaseNs[CSV_PHASE_IO] / 1e9, load->phaseNs[CSV_PHASE_HEADER] / 1e9,
+               load->phaseNs[CSV_PHASE_SCAN] / 1e9, load->phaseNs[CSV_PHASE_PARSE] / 1e9,
+               load->phaseNs[CSV_PHASE_FINISH] / 1e9, (unsigned long long)load->syscalls);
+        return;
+    }
+
+    printf("{\"mode\": \"%s\", \"simd\": \"%s\", \"distribution\": \"%s\", \"rows\": %ld, \"cols\": %d, \"threads\": %d, "
+           "\"bytes\": %zu, \"best_s\": %.6f, \"median_s\": %.6f, \"mb_per_s\": %.3f, \"rows_per_s\": %.1f, "
+           "\"peak_rss_kb\": %ld, \"allocations\": %ld, \"allocated_bytes\": %zu, \"peak_allocated_bytes\": %zu, "
+           "\"io_s\": %.6f, \"header_s\": %.6f, \"scan_s\": %.6f, \"parse_s\": %.6f, \"finish_s\": %.6f, \"syscalls\": %llu}\n",
+           name, getSimdLevel(), distribution, result->rows, result->cols, config->threads, result->bytes, result->best,
+           result->median, mbPerSecond, rowsPerSecond, peakRss, result->allocs.allocations, result->allocs.bytes,
+           result->allocs.peakBytes, load->phaseNs[CSV_PHASE_IO] / 1e9, load->phaseNs[CSV_PHASE_HEADER] / 1e9,
+           load->phaseNs[CSV_PHASE_SCAN] / 1e9, load->phaseNs[CSV_PHASE_PARSE] / 1e9,
+           load->phaseNs[CSV_PHASE_FINISH] / 1e9, (unsigned long long)load->syscalls);
+}
+
+/**
+ * @brief Print how the benchmark is used.
+ */
+static void printUsage(const char *program)
+{
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --rows N            rows of the generated file (%d)\n"
+            "  --cols N            features of the generated file (%d)\n"
+            "  --distribution D    uniform, normal, elliptical or integer (elliptical)\n"
+            "  --seed N            seed of the generated values (1)\n"
+            "  --repeat N          timed runs per mode, at most %d (%d)\n"
+            "  --threads N         threads of the parallel mode, 0 for one per CPU (0)\n"
+            "  --mode M            only run this mode\n"
+            "  --format F          json or csv (json)\n"
+            "  --input PATH        benchmark an existing file instead of generating one\n"
+            "  --output PATH       where the generated file is written (%s)\n"
+            "  --keep              keep the generated file\n",
+            program, BENCH_DEFAULT_ROWS, BENCH_DEFAULT_COLS, BENCH_MAX_REPEAT, BENCH_DEFAULT_REPEAT, BENCH_DEFAULT_OUTPUT);
+}
+
+/**
+ * @brief Read the command line into the benchmark configuration.
+ *
+ * @return TRUE on success, ERROR if an option is unknown or its value is missing or out of range.
+ */
+static bool_t parseArguments(int argc, char **argv, benchConfig_t *config)
+{
+    config->rows = BENCH_DEFAULT_ROWS;
+    config->cols = BENCH_DEFAULT_COLS;
+    config->distribution = BENCH_DIST_ELLIPTICAL;
+    config->seed = 1;
+    config->repeat = BENCH_DEFAULT_REPEAT;
+    config->threads = 0;
+    config->format = BENCH_FORMAT_JSON;
+    config->input = NULL;
+    config->output = BENCH_DEFAULT_OUTPUT;
+    config->mode = NULL;
+    config->keep = FALSE;
+
+    for(int arg=1; arg<argc; arg++)
+    {
+        const char *value = (arg + 1 < argc) ? argv[arg + 1] : NULL;
+        bool_t known = TRUE;
+
+        if(strcmp(argv[arg], "--keep") == 0)
+        {
+            config->keep = TRUE;
+            continue;
+        }
+        else if(value == NULL)
+        {
+            return ERROR;
+        }
+        else if(strcmp(argv[arg], "--rows") == 0)
+        {
+            config->rows = atol(value);
+        }
+        else if(strcmp(argv[arg], "--cols") == 0)
+        {
+            config->cols = atoi(value);
+        }
+        else if(strcmp(argv[arg], "--seed") == 0)
+        {
+            config->seed = strtoull(value, NULL, 10);
+        }
+        else if(strcmp(argv[arg], "--repeat") == 0)
+        {
+            config->repeat = atoi(value);
+        }
+        else if(strcmp(argv[arg], "--threads") == 0)
+        {
+            config->threads = atoi(value);
+        }
+        else if(strcmp(argv[arg], "--mode") == 0)
+        {
+            config->mode = value;
+        }
+        else if(strcmp(argv[arg], "--input") == 0)
+        {
+            config->input = value;
+        }
+        else if(strcmp(argv[arg], "--output") == 0)
+        {
+            config->output = value;
+        }
+        else if(strcmp(argv[arg], "--format") == 0 && (strcmp(value, "json") == 0 || strcmp(value, "csv") == 0))
+        {
+            config->format = (strcmp(value, "csv") == 0) ? BENCH_FORMAT_CSV : BENCH_FORMAT_JSON;
+        }
+        else if(strcmp(argv[arg], "--distribution") == 0)
+        {
+            known = FALSE;
+
+            for(int dist=0; dist<(int)(sizeof(distributionNames) / sizeof(distributionNames[0])); dist++)
+            {
+                if(strcmp(value, distributionNames[dist]) == 0)
+                {
+                    config->distribution = (benchDistribution_t)dist;
+                    known = TRUE;
+                }
+            }
+        }
+        else
+        {
+            known = FALSE;
+        }
+
+        if(known == FALSE)
+        {
+            return ERROR;
+        }
+
+        arg++;
+    }
+
+    return (config->rows >= 0 && config->cols > 0 && config->repeat > 0 && config->repeat <= BENCH_MAX_REPEAT &&
+            config->threads >= 0) ? TRUE : ERROR;
+}
+
+int main(int argc, char **argv)
+{
+    benchConfig_t config;
+    bool_t status = TRUE;
+    int ran = 0;
+
+    if(parseArguments(argc, argv, &config) != TRUE)
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if(config.input == NULL) //the generated file is the benchmarked one
+    {
+        if(generateCsv(&config) != TRUE)
+        {
+            fprintf(stderr, "Could not write \"%s\".\n", config.output);
+            return EXIT_FAILURE;
+        }
+
+        config.input = config.output;
+    }
+
+    if(config.format == BENCH_FORMAT_CSV)
+    {
+        puts("mode,simd,distribution,rows,cols,threads,bytes,best_s,median_s,mb_per_s,rows_per_s,peak_rss_kb,allocations,"
+             "allocated_bytes,peak_allocated_bytes,io_s,header_s,scan_s,parse_s,finish_s,syscalls");
+    }
+
+    for(size_t index=0; index<sizeof(modes) / sizeof(modes[0]); index++)
+    {
+        benchResult_t result;
+        long peakRss = 0;
+
+        if(config.mode != NULL && strcmp(config.mode, modes[index].name) != 0)
+        {
+            continue;
+        }
+        else if(config.mode == NULL && modes[index].run == runFixed && fixedParser(config.cols) == NULL)
+        {
+            continue; //only some column counts have a parser of their own
+        }
+
+        ran++;
+
+        if(runIsolated(&config, &modes[index], &result, &peakRss) != TRUE)
+        {
+            fprintf(stderr, "Mode \"%s\" failed.\n", modes[index].name);
+            status = ERROR;
+            continue;
+        }
+
+        printResult(&config, modes[index].name, &result, peakRss);
+    }
+
+    if(config.input == config.output && config.keep == FALSE)
+    {
+        (void)unlink(config.output);
+    }
+
+    if(ran == 0)
+    {
+        fprintf(stderr, "Unknown mode \"%s\".\n", config.mode);
+        status = ERROR;
+    }
+
+    return (status == TRUE) ? EXIT_SUCCESS : EXIT_FAILURE;
+}